@@ -32,6 +32,11 @@ cdef extern from "coco.h":
     coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, 
                              const char *suite_options)
     void coco_suite_free(coco_suite_t *suite)
+    size_t coco_suite_get_number_of_problems(coco_suite_t *suite)
+    int coco_suite_get_problem_metadata(coco_suite_t *suite, size_t problem_index,
+                                        char **problem_id, char **problem_name,
+                                        size_t *dimension, size_t *number_of_objectives)
+    void coco_free_memory(void *data)
 
     void coco_evaluate_function(coco_problem_t *problem, double *x, double *y)
     void coco_evaluate_constraint(coco_problem_t *problem, const double *x, double *y)
@@ -173,11 +178,14 @@ cdef class Suite:
         self._initialize()
         assert self.initialized
     cdef _initialize(self):
-        """sweeps through `suite` to collect indices and id's to operate by
-        direct access in the remainder"""
+        """sweeps through the metadata of `suite` to collect indices and id's
+        to operate by direct access in the remainder, without constructing
+        any problem"""
         cdef np.npy_intp shape[1]  # probably completely useless
         cdef coco_suite_t* suite
-        cdef coco_problem_t* p
+        cdef char* problem_id
+        cdef char* problem_name
+        cdef size_t index, dimension, number_of_objectives
         if self.initialized:
             self.reset()
         self._ids = []
@@ -204,17 +212,18 @@ also report back a missing name to https://github.com/numbbo/coco/issues
             raise NoSuchSuiteException("No suite with name '%s' found" % self._name)
         if suite == NULL:
             raise NoSuchSuiteException("No suite with name '%s' found" % self._name)
-        while True:
-            p = coco_suite_get_next_problem(suite, NULL)
-            if not p:
-                break
-            self._indices.append(coco_problem_get_suite_dep_index(p))
-            self._ids.append(coco_problem_get_id(p))
-            self._names.append(coco_problem_get_name(p))
-            self._dimensions.append(coco_problem_get_dimension(p))
-            self._number_of_objectives.append(coco_problem_get_number_of_objectives(p))
-        coco_suite_free(suite)
-        self.suite = coco_suite(self._name, self._instance, self._options)
+        for index in range(coco_suite_get_number_of_problems(suite)):
+            if not coco_suite_get_problem_metadata(suite, index, &problem_id, &problem_name,
+                                                   &dimension, &number_of_objectives):
+                continue  # filtered out by the suite options
+            self._indices.append(index)
+            self._ids.append(problem_id)
+            self._names.append(problem_name)
+            self._dimensions.append(dimension)
+            self._number_of_objectives.append(number_of_objectives)
+            coco_free_memory(problem_id)
+            coco_free_memory(problem_name)
+        self.suite = suite
         self.initialized = True
         return self
     def reset(self):
@@ -85,6 +85,38 @@ typedef struct coco_suite coco_suite_t;
  */
 void coco_evaluate_function(coco_problem_t *self, const double *x, double *y);
 
+/**
+ * Evaluate the COCO problem represented by ${self} at the
+ * ${number_of_points} parameter settings stored row by row in ${x}
+ * and save the results row by row in ${y}.
+ *
+ * The outcome (function values, evaluation counter and logged data)
+ * is the same as calling coco_evaluate_function() on each row in
+ * turn, but problems that support it push the whole block through
+ * each transformation at once.
+ *
+ * @note ${x} must hold number_of_points * number_of_variables and
+ * ${y} number_of_points * number_of_objectives values.
+ */
+void coco_evaluate_function_batch(coco_problem_t *self,
+                                  const double *x,
+                                  const size_t number_of_points,
+                                  double *y);
+
+/**
+ * Let coco_evaluate_function_batch() split large batches of points
+ * of the suite problem ${problem} over ${number_of_threads} threads,
+ * which are kept with the problem until it is freed. The outcome
+ * (function values, evaluation counters and logged data) does not
+ * depend on the number of threads. The default 1 (or 0) evaluates
+ * each batch in the calling thread. The suite option
+ * evaluation_threads sets the number of threads of all problems of
+ * a suite.
+ *
+ * @note Has no effect unless COCO is compiled with COCO_THREADS.
+ */
+void coco_problem_set_evaluation_threads(coco_problem_t *problem, const size_t number_of_threads);
+
 /**
  * Evaluate the constraints of the COCO problem represented by
  * ${self} with the parameter settings ${x} and save the result in
@@ -108,6 +140,29 @@ void coco_recommend_solutions(coco_problem_t *self, const double *x, size_t numb
  */
 void coco_problem_free(coco_problem_t *self);
 
+/**
+ * Return an independent copy of the COCO problem represented by
+ * ${problem}, which can be evaluated concurrently with ${problem}
+ * and its other clones (each by one thread at a time). The clone
+ * is not observed and must be freed with coco_problem_free().
+ */
+coco_problem_t *coco_problem_clone_for_thread(coco_problem_t *problem);
+
+/**
+ * Account the ${number_of_points} evaluations of clones of
+ * ${problem}, with the parameter settings stored row by row in ${x}
+ * and the results row by row in ${y}, to ${problem} in the given
+ * order. The evaluation counter, the best observed value and the
+ * logged data of ${problem} are the same as if ${problem} had
+ * evaluated the points itself, but no function is evaluated again.
+ *
+ * @note Must not be called concurrently with evaluations of ${problem}.
+ */
+void coco_problem_merge_evaluations(coco_problem_t *problem,
+                                    const double *x,
+                                    const size_t number_of_points,
+                                    const double *y);
+
 /**
  * Return the name of a COCO problem.
  *
@@ -209,6 +264,20 @@ void coco_suite_decode_problem_index(coco_suite_t *suite,
 
 size_t coco_suite_get_number_of_problems(coco_suite_t *suite);
 
+/**
+ * Retrieves the problem_id, problem_name, dimension and number of objectives of the problem with the given
+ * index without constructing the problem. Returns 1 on success and 0 if the index is out of range or the
+ * problem has been filtered out by the suite options (coco_suite_get_problem() would not return it when
+ * iterating through the suite). The strings are allocated and must be freed by the caller with
+ * coco_free_memory().
+ */
+int coco_suite_get_problem_metadata(coco_suite_t *suite,
+                                    const size_t problem_index,
+                                    char **problem_id,
+                                    char **problem_name,
+                                    size_t *dimension,
+                                    size_t *number_of_objectives);
+
 size_t coco_suite_get_function_from_function_index(coco_suite_t *suite, size_t function_idx);
 
 size_t coco_suite_get_dimension_from_dimension_index(coco_suite_t *suite, size_t dimension_idx);
@@ -222,6 +291,36 @@ void coco_run_benchmark(const char *suite_name,
                         const char *observer_options,
                         coco_optimizer_t optimizer);
 
+/**
+ * Like coco_run_benchmark(), but runs the ${optimizer} on up to
+ * ${number_of_threads} problems at a time, each in its own thread.
+ * The output of the observer is identical to the one of
+ * coco_run_benchmark().
+ *
+ * The evaluations are recorded in temporary files (see tmpfile())
+ * until they are passed on to the observer in the order of the suite.
+ * An evaluation takes 8 * (dimension + number of objectives) bytes,
+ * so that a problem in dimension 40 with a budget of 1e5 * 40
+ * evaluations alone takes about 1.3 GB, and up to 4 problems per
+ * thread are recorded at a time. If ${max_recorded_bytes} is not 0,
+ * the threads wait while more than ${max_recorded_bytes} bytes are
+ * not yet passed on to the observer, which bounds the temporary disk
+ * space to about ${max_recorded_bytes} plus 8 * 1024 evaluations per
+ * thread. A failure to write the temporary files is a coco_error().
+ *
+ * @note The ${optimizer} must be safe to call from several threads.
+ * Threads are only used if COCO was compiled with COCO_THREADS
+ * defined, otherwise the problems are optimized one by one.
+ */
+void coco_run_benchmark_parallel(const char *suite_name,
+                                 const char *suite_instance,
+                                 const char *suite_options,
+                                 const char *observer_name,
+                                 const char *observer_options,
+                                 coco_optimizer_t optimizer,
+                                 const size_t number_of_threads,
+                                 const size_t max_recorded_bytes);
+
 coco_observer_t *coco_observer(const char *observer_name, const char *options);
 void coco_observer_free(coco_observer_t *self);
 coco_problem_t *coco_problem_add_observer(coco_problem_t *problem, coco_observer_t *observer);
@@ -237,6 +336,15 @@ typedef struct coco_random_state coco_random_state_t;
  */
 coco_random_state_t *coco_random_new(uint32_t seed);
 
+/**
+ * Create a new random number stream that is one of many substreams
+ * of ${seed}, numbered by ${substream}, and return its state. The
+ * substreams of a seed are deterministic and statistically
+ * independent of each other, for example to give each thread its own
+ * stream. They differ from the stream of coco_random_new(${seed}).
+ */
+coco_random_state_t *coco_random_new_substream(uint32_t seed, uint32_t substream);
+
 /**
  * Free all memory associated with the RNG state.
  */
@@ -248,6 +356,13 @@ void coco_random_free(coco_random_state_t *state);
  */
 double coco_random_uniform(coco_random_state_t *state);
 
+/**
+ * Store ${number_of_values} uniform [0, 1) random values in
+ * ${values}. They are the values of as many calls to
+ * coco_random_uniform(), but are copied from the generator in blocks.
+ */
+void coco_random_uniform_fill(coco_random_state_t *state, double *values, const size_t number_of_values);
+
 /**
  * Generate an approximately normal random number.
  *
@@ -258,6 +373,15 @@ double coco_random_uniform(coco_random_state_t *state);
  */
 double coco_random_normal(coco_random_state_t *state);
 
+/**
+ * Store ${number_of_values} N(0, 1) random values in ${values}.
+ *
+ * Uses the polar method, which yields two normal values per pair of
+ * uniform values accepted (and needs no cos), so the values are not
+ * those of coco_random_normal().
+ */
+void coco_random_normal_fill(coco_random_state_t *state, double *values, const size_t number_of_values);
+
 /* Memory management routines.
  *
  * Their implementation may never fail. They either return a valid
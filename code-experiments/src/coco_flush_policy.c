@@ -0,0 +1,138 @@
+/*
+ * Buffered output and flush policies shared by the loggers.
+ *
+ * The log files are given large, fully buffered stdio buffers and are only flushed when the flush
+ * policy of the observer asks for it (and, in any case, when they are closed). The policy is read from
+ * the observer option "flush", which can take the following values:
+ * - never : the files are flushed only when they are closed
+ * - problem_end : the files are flushed when the observed problem is freed
+ * - seconds:N : the files are flushed during the evaluations, at most once every N seconds
+ * - every:N : the files are flushed after every N evaluations (every:1 flushes after each evaluation)
+ *
+ * The files are flushed by the thread that evaluates the problem, in whole blocks of the buffer.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+#define COCO_FLUSH_BUFFER_SIZE 65536 /* Size of the stdio buffer of every log file */
+#define COCO_FLUSH_MAX_CHECK_INTERVAL 1024 /* Maximal number of evaluations between two reads of the clock */
+
+typedef enum {
+  COCO_FLUSH_NEVER, COCO_FLUSH_PROBLEM_END, COCO_FLUSH_SECONDS, COCO_FLUSH_EVERY
+} coco_flush_mode_t;
+
+typedef struct {
+  coco_flush_mode_t mode;
+  size_t interval; /* Number of seconds or evaluations between two flushes */
+} coco_flush_policy_t;
+
+/**
+ * The state of a logger with respect to its flush policy.
+ */
+typedef struct {
+  size_t number_of_evaluations; /* Evaluations since the last flush */
+  time_t last_flush;
+  /* The policy seconds:N reads the clock only every check_interval evaluations. The interval is doubled
+   * while the clock shows no progress between two reads and halved when it shows more than a second. */
+  size_t check_interval;
+  size_t evaluations_until_check;
+  time_t last_check;
+} coco_flush_state_t;
+
+/**
+ * Reads the flush policy from the observer ${options}. The default is "seconds:1", so that impatient
+ * users still see the progress while the files are written in large blocks.
+ */
+static void coco_flush_policy_read(const char *options, coco_flush_policy_t *policy) {
+
+  char *value;
+  unsigned long interval;
+
+  policy->mode = COCO_FLUSH_SECONDS;
+  policy->interval = 1;
+
+  value = (char *) coco_allocate_memory(COCO_PATH_MAX);
+  if (coco_options_read_string(options, "flush", value) > 0) {
+    if (strcmp(value, "never") == 0) {
+      policy->mode = COCO_FLUSH_NEVER;
+    } else if (strcmp(value, "problem_end") == 0) {
+      policy->mode = COCO_FLUSH_PROBLEM_END;
+    } else if ((strncmp(value, "seconds:", 8) == 0) && (sscanf(value + 8, "%lu", &interval) == 1)) {
+      /* seconds:0 flushes after each evaluation */
+      policy->mode = (interval > 0) ? COCO_FLUSH_SECONDS : COCO_FLUSH_EVERY;
+      policy->interval = (interval > 0) ? (size_t) interval : 1;
+    } else if ((strncmp(value, "every:", 6) == 0) && (sscanf(value + 6, "%lu", &interval) == 1)
+        && (interval > 0)) {
+      policy->mode = COCO_FLUSH_EVERY;
+      policy->interval = (size_t) interval;
+    } else {
+      coco_warning("coco_flush_policy_read(): unknown flush policy '%s', using 'seconds:1'", value);
+    }
+  }
+  coco_free_memory(value);
+}
+
+/**
+ * Gives the freshly opened ${file} a large buffer. Must be called before the first output to the file.
+ */
+static void coco_flush_set_buffer(FILE *file) {
+  if (setvbuf(file, NULL, _IOFBF, COCO_FLUSH_BUFFER_SIZE) != 0)
+    coco_debug("coco_flush_set_buffer(): could not set the buffer of a log file");
+}
+
+static void coco_flush_state_reset(coco_flush_state_t *state) {
+  state->number_of_evaluations = 0;
+  state->last_flush = time(NULL);
+  state->check_interval = 1;
+  state->evaluations_until_check = 1;
+  state->last_check = state->last_flush;
+}
+
+/**
+ * Returns the number of seconds since the last flush, reading the clock only every so many evaluations
+ * (-1 if the clock was not read).
+ */
+static double coco_flush_seconds_since_flush(coco_flush_state_t *state) {
+  time_t now;
+  double seconds_since_check;
+
+  if (--state->evaluations_until_check > 0)
+    return -1;
+  now = time(NULL);
+  seconds_since_check = difftime(now, state->last_check);
+  if ((seconds_since_check < 1) && (state->check_interval < COCO_FLUSH_MAX_CHECK_INTERVAL))
+    state->check_interval *= 2;
+  else if ((seconds_since_check > 1) && (state->check_interval > 1))
+    state->check_interval /= 2;
+  state->evaluations_until_check = state->check_interval;
+  state->last_check = now;
+  return difftime(now, state->last_flush);
+}
+
+/**
+ * Records an evaluation and returns 1 if, according to the ${policy}, the log files should be flushed
+ * now and 0 otherwise.
+ */
+static int coco_flush_after_evaluation(const coco_flush_policy_t *policy, coco_flush_state_t *state) {
+
+  state->number_of_evaluations++;
+  switch (policy->mode) {
+  case COCO_FLUSH_EVERY:
+    if (state->number_of_evaluations < policy->interval)
+      return 0;
+    break;
+  case COCO_FLUSH_SECONDS:
+    if (coco_flush_seconds_since_flush(state) < (double) (long) policy->interval)
+      return 0;
+    state->last_flush = state->last_check;
+    break;
+  default:
+    return 0;
+  }
+  state->number_of_evaluations = 0;
+  return 1;
+}
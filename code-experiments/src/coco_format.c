@@ -0,0 +1,228 @@
+/*
+ * Fast formatting of numbers for the loggers. The output is byte-identical to the one of sprintf() with
+ * the corresponding format, so that the post-processing is not affected.
+ *
+ * coco_format_exponential() computes the decimal digits of a double in the scientific notation from the
+ * exact product of the double and a power of ten, represented as an unevaluated sum of two doubles
+ * (double-double arithmetic). Digits are only emitted when the rounding of this product to an integer is
+ * unambiguous. Otherwise (near ties, huge or tiny exponents, high precisions, zeros, infinities and NaNs)
+ * the function falls back to sprintf(), which is much slower, but always exact.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "coco.h"
+
+#define COCO_FORMAT_BUFFER_SIZE 64 /* Large enough for a double with width and precision up to 32 */
+#define COCO_FORMAT_MAX_PRECISION 16 /* Highest precision handled without sprintf(), 17 significant digits */
+
+/* The double-double arithmetic needs every operation to be rounded to double precision (no x87) */
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0) || (defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ != 0)
+#define COCO_FORMAT_USE_SPRINTF_ONLY
+#endif
+
+/* The powers of ten that are exactly representable as doubles */
+static const double coco_format_powers_of_ten[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/**
+ * Splits ${a} into a high and a low part of 26 bits each (Dekker).
+ */
+static void coco_format_split(const double a, double *high, double *low) {
+  const double c = 134217729.0 * a; /* 2^27 + 1 */
+  *high = c - (c - a);
+  *low = a - *high;
+}
+
+/**
+ * Computes the exact product a * b = *product + *error, where *product is the rounded product (Dekker).
+ */
+static void coco_format_two_product(const double a, const double b, double *product, double *error) {
+  double a_high, a_low, b_high, b_low;
+
+  *product = a * b;
+  coco_format_split(a, &a_high, &a_low);
+  coco_format_split(b, &b_high, &b_low);
+  *error = ((a_high * b_high - *product) + a_high * b_low + a_low * b_high) + a_low * b_low;
+}
+
+/**
+ * Computes ${magnitude} * 10^${power} as *high + *low with a relative error below 2^-100. Returns 0 if
+ * ${power} is out of the supported range and 1 otherwise.
+ */
+static int coco_format_scale(const double magnitude, const int power, double *high, double *low) {
+  double product, error, sum;
+
+  if ((power >= 0) && (power <= 22)) {
+    coco_format_two_product(magnitude, coco_format_powers_of_ten[power], high, low);
+  } else if ((power > 22) && (power <= 44)) {
+    coco_format_two_product(magnitude, 1e22, &product, &error);
+    coco_format_two_product(product, coco_format_powers_of_ten[power - 22], high, low);
+    error = *low + error * coco_format_powers_of_ten[power - 22];
+    sum = *high + error;
+    *low = error - (sum - *high);
+    *high = sum;
+  } else if ((power < 0) && (power >= -22)) {
+    /* magnitude = quotient * divisor + remainder, where the remainder is computed exactly */
+    const double divisor = coco_format_powers_of_ten[-power];
+    const double quotient = magnitude / divisor;
+    coco_format_two_product(quotient, divisor, &product, &error);
+    error = ((magnitude - product) - error) / divisor;
+    *high = quotient + error;
+    *low = error - (*high - quotient);
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * Writes the decimal digits of the integer high * 10^8 + low (with at most 17 digits) right-aligned into
+ * the 17 characters of ${digits}.
+ */
+static void coco_format_digits(unsigned long high, unsigned long low, char *digits) {
+  int i;
+
+  for (i = 16; i >= 9; i--) {
+    digits[i] = (char) ('0' + low % 10);
+    low /= 10;
+  }
+  for (; i >= 0; i--) {
+    digits[i] = (char) ('0' + high % 10);
+    high /= 10;
+  }
+}
+
+/**
+ * Compares the integer a_high * 10^8 + a_low with b_high * 10^8 + b_low (all parts are integer-valued
+ * doubles, the low parts in [0, 10^8)). Returns -1, 0 or 1.
+ */
+static int coco_format_compare(const double a_high, const double a_low, const double b_high, const double b_low) {
+  if (a_high != b_high)
+    return (a_high < b_high) ? -1 : 1;
+  if (a_low != b_low)
+    return (a_low < b_low) ? -1 : 1;
+  return 0;
+}
+
+/**
+ * Writes the decimal representation of ${value} into ${buffer} and returns the number of characters
+ * written (without the terminating null character).
+ */
+static size_t coco_format_unsigned_long(char *buffer, unsigned long value) {
+  char digits[24];
+  size_t length = 0, i;
+
+  do {
+    digits[length++] = (char) ('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  for (i = 0; i < length; i++)
+    buffer[i] = digits[length - 1 - i];
+  buffer[length] = '\0';
+  return length;
+}
+
+/**
+ * Writes ${value} into ${buffer} exactly like sprintf(buffer, "%*.*e", width, precision, value) (or with
+ * the format "%+*.*e" if ${force_sign} is nonzero) and returns the number of characters written (without
+ * the terminating null character). The buffer must hold at least COCO_FORMAT_BUFFER_SIZE characters and
+ * both the width and the precision must be at most 32.
+ */
+static size_t coco_format_exponential(char *buffer,
+                                      const double value,
+                                      const int width,
+                                      const int precision,
+                                      const int force_sign) {
+#ifndef COCO_FORMAT_USE_SPRINTF_ONLY
+  double magnitude, high, low, integer, fraction, adjustment;
+  double digits_high, digits_low, lower_high, lower_low, upper_high, upper_low;
+  char digits[17];
+  size_t length = 0, padding, i;
+  int exponent, attempt;
+
+  magnitude = fabs(value);
+  if ((precision >= 0) && (precision <= COCO_FORMAT_MAX_PRECISION) && (magnitude > 0) && (magnitude <= DBL_MAX)) {
+
+    /* The integers 10^precision and 10^(precision + 1) in the split representation */
+    lower_high = (precision >= 8) ? coco_format_powers_of_ten[precision - 8] : 0;
+    lower_low = (precision >= 8) ? 0 : coco_format_powers_of_ten[precision];
+    upper_high = (precision >= 7) ? coco_format_powers_of_ten[precision - 7] : 0;
+    upper_low = (precision >= 7) ? 0 : coco_format_powers_of_ten[precision + 1];
+
+    /* The estimate of the decimal exponent can be off by one, which is corrected in the next iteration */
+    exponent = (int) floor(log10(magnitude));
+    for (attempt = 0; attempt < 3; attempt++) {
+      if (!coco_format_scale(magnitude, precision - exponent, &high, &low))
+        break;
+
+      /* Split the integer part of high + low into digits_high * 10^8 + digits_low */
+      integer = floor(high);
+      fraction = (high - integer) + low;
+      adjustment = floor(fraction);
+      fraction -= adjustment;
+      digits_high = floor(integer / 1e8);
+      digits_low = integer - digits_high * 1e8 + adjustment;
+      while (digits_low < 0) {
+        digits_high -= 1;
+        digits_low += 1e8;
+      }
+      while (digits_low >= 1e8) {
+        digits_high += 1;
+        digits_low -= 1e8;
+      }
+      if (coco_format_compare(digits_high, digits_low, lower_high, lower_low) < 0) {
+        exponent--;
+        continue;
+      }
+
+      /* Round to the nearest integer, giving up near ties */
+      if (fabs(fraction - 0.5) < 1e-9)
+        break;
+      if (fraction > 0.5) {
+        digits_low += 1;
+        if (digits_low >= 1e8) {
+          digits_high += 1;
+          digits_low -= 1e8;
+        }
+      }
+      if (coco_format_compare(digits_high, digits_low, upper_high, upper_low) >= 0) {
+        exponent++;
+      } else {
+        coco_format_digits((unsigned long) digits_high, (unsigned long) digits_low, digits);
+
+        if (value < 0)
+          buffer[length++] = '-';
+        else if (force_sign)
+          buffer[length++] = '+';
+        buffer[length++] = digits[16 - precision];
+        if (precision > 0) {
+          buffer[length++] = '.';
+          for (i = (size_t) (17 - precision); i < 17; i++)
+            buffer[length++] = digits[i];
+        }
+        buffer[length++] = 'e';
+        buffer[length++] = (exponent < 0) ? '-' : '+';
+        if (exponent < 0)
+          exponent = -exponent;
+        if (exponent >= 100)
+          buffer[length++] = (char) ('0' + exponent / 100);
+        buffer[length++] = (char) ('0' + (exponent / 10) % 10);
+        buffer[length++] = (char) ('0' + exponent % 10);
+        buffer[length] = '\0';
+
+        if ((width > 0) && (length < (size_t) width)) {
+          padding = (size_t) width - length;
+          memmove(buffer + padding, buffer, length + 1);
+          memset(buffer, ' ', padding);
+          length += padding;
+        }
+        return length;
+      }
+    }
+  }
+#endif
+  return (size_t) sprintf(buffer, force_sign ? "%+*.*e" : "%*.*e", width, precision, value);
+}
@@ -3,6 +3,15 @@
 
 #include "coco.h"
 #include "coco_internal.h"
+#include "coco_problem.c"
+#include "coco_thread.c"
+
+/**
+ * The minimal work (number of points times number of variables) of each thread when a batch is split over
+ * several threads (see coco_problem_set_evaluation_threads), so that handing the slices to the threads does
+ * not outweigh their work on cheap functions and small batches.
+ */
+#define COCO_EVALUATION_THREADS_MIN_WORK 16384
 
 void coco_evaluate_function(coco_problem_t *self, const double *x, double *y) {
   /* implements a safer version of self->evaluate(self, x, y) */
@@ -19,6 +28,148 @@ void coco_evaluate_function(coco_problem_t *self, const double *x, double *y) {
 #endif
 }
 
+/**
+ * Evaluates the batch in the calling thread.
+ */
+static void coco_evaluate_function_batch_sequential(coco_problem_t *self,
+                                                    const double *x,
+                                                    const size_t number_of_points,
+                                                    double *y) {
+  size_t i;
+  if (self->evaluate_function_batch == NULL) {
+    /* Fall back to point-wise evaluation, which also keeps the loggers in the loop */
+    for (i = 0; i < number_of_points; ++i) {
+      coco_evaluate_function(self, x + i * self->number_of_variables, y + i * self->number_of_objectives);
+    }
+    return;
+  }
+  self->evaluate_function_batch(self, x, number_of_points, y);
+  /* Same bookkeeping as in coco_evaluate_function, in the order of the points */
+  for (i = 0; i < number_of_points; ++i) {
+    self->evaluations++;
+    if (y[i * self->number_of_objectives] < self->best_observed_fvalue[0]) {
+      self->best_observed_fvalue[0] = y[i * self->number_of_objectives];
+      self->best_observed_evaluation[0] = self->evaluations;
+    }
+  }
+}
+
+#if defined(HAVE_THREADS)
+
+/**
+ * The part of a batch evaluated by one thread on its own clone of the problem.
+ */
+typedef struct {
+  coco_problem_t *clone;
+  const double *x;
+  size_t number_of_points;
+  double *y;
+} coco_evaluation_slice_t;
+
+static void coco_evaluation_slice_run(void *argument) {
+  coco_evaluation_slice_t *slice = (coco_evaluation_slice_t *) argument;
+  coco_evaluate_function_batch_sequential(slice->clone, slice->x, slice->number_of_points, slice->y);
+}
+
+/**
+ * Splits the batch into ${number_of_threads} contiguous slices that are evaluated concurrently on clones of
+ * the problem (each with its own scratch memory) by the calling thread and the evaluation pool of the problem.
+ * The evaluations are then accounted to the problem (counters, best observed values and loggers) in the
+ * order of the points.
+ */
+static void coco_evaluate_function_batch_parallel(coco_problem_t *self,
+                                                  const double *x,
+                                                  const size_t number_of_points,
+                                                  double *y,
+                                                  const size_t number_of_threads) {
+  coco_evaluation_slice_t *slices;
+  coco_problem_t **clones;
+  double *origin_values;
+  size_t i, first_point;
+
+  /* Clones are constructed once and kept with the problem */
+  if (self->number_of_evaluation_clones < number_of_threads) {
+    clones = (coco_problem_t **) coco_allocate_memory(number_of_threads * sizeof(*clones));
+    for (i = 0; i < self->number_of_evaluation_clones; i++)
+      clones[i] = self->evaluation_clones[i];
+    for (i = self->number_of_evaluation_clones; i < number_of_threads; i++)
+      clones[i] = coco_problem_clone_for_thread(self);
+    if (self->evaluation_clones != NULL)
+      coco_free_memory(self->evaluation_clones);
+    self->evaluation_clones = clones;
+    self->number_of_evaluation_clones = number_of_threads;
+  }
+  /* So are the threads, which wait for the next batch */
+  if (self->evaluation_pool == NULL)
+    self->evaluation_pool = coco_thread_pool_allocate(self->evaluation_threads - 1);
+
+  origin_values = coco_allocate_vector(number_of_points * self->number_of_objectives);
+  slices = (coco_evaluation_slice_t *) coco_allocate_memory(number_of_threads * sizeof(*slices));
+  first_point = 0;
+  for (i = 0; i < number_of_threads; i++) {
+    slices[i].clone = self->evaluation_clones[i];
+    slices[i].number_of_points = number_of_points / number_of_threads
+        + ((i < number_of_points % number_of_threads) ? 1 : 0);
+    slices[i].x = x + first_point * self->number_of_variables;
+    slices[i].y = origin_values + first_point * self->number_of_objectives;
+    first_point += slices[i].number_of_points;
+  }
+  coco_thread_pool_run(self->evaluation_pool, coco_evaluation_slice_run, slices, sizeof(*slices),
+      number_of_threads);
+
+  coco_problem_replay_evaluations(self, x, number_of_points, origin_values, y);
+
+  coco_free_memory(slices);
+  coco_free_memory(origin_values);
+}
+
+#endif
+
+/**
+ * Sets the number of threads of coco_evaluate_function_batch on the ${problem}. The points of a batch are
+ * evaluated concurrently on clones of the problem (see coco_problem_clone_for_thread) and then accounted to
+ * the problem in the order in which they are given, so that the outcome does not depend on the number of
+ * threads.
+ */
+void coco_problem_set_evaluation_threads(coco_problem_t *problem, const size_t number_of_threads) {
+  assert(problem != NULL);
+  problem->evaluation_threads = (number_of_threads > 1) ? number_of_threads : 1;
+#if defined(HAVE_THREADS)
+  /* The pool is constructed again (with the new number of threads) when it is needed */
+  if (problem->evaluation_pool != NULL) {
+    coco_thread_pool_free(problem->evaluation_pool);
+    problem->evaluation_pool = NULL;
+  }
+#endif
+}
+
+void coco_evaluate_function_batch(coco_problem_t *self,
+                                  const double *x,
+                                  const size_t number_of_points,
+                                  double *y) {
+#if defined(HAVE_THREADS)
+  size_t number_of_threads;
+#endif
+  assert(self != NULL);
+  assert(self->evaluate_function != NULL);
+  if (number_of_points == 0)
+    return;
+  assert(x != NULL);
+  assert(y != NULL);
+#if defined(HAVE_THREADS)
+  if ((self->evaluation_threads > 1) && (self->clone_problem != NULL)) {
+    number_of_threads = number_of_points * self->number_of_variables / COCO_EVALUATION_THREADS_MIN_WORK;
+    if (number_of_threads > self->evaluation_threads)
+      number_of_threads = self->evaluation_threads;
+    if (number_of_threads > 1) {
+      coco_evaluate_function_batch_parallel(self, x, number_of_points, y, number_of_threads);
+      return;
+    }
+  }
+#endif
+  coco_evaluate_function_batch_sequential(self, x, number_of_points, y);
+}
+
 long coco_problem_get_evaluations(coco_problem_t *self) {
   assert(self != NULL);
   return self->evaluations;
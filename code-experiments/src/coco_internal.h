@@ -10,11 +10,25 @@
 
 typedef void (*coco_initial_solution_function_t)(const coco_problem_t *self, double *y);
 typedef void (*coco_evaluate_function_t)(coco_problem_t *self, const double *x, double *y);
+typedef void (*coco_evaluate_batch_function_t)(coco_problem_t *self,
+                                               const double *x,
+                                               const size_t number_of_points,
+                                               double *y);
+typedef void (*coco_transform_variables_function_t)(coco_problem_t *self,
+                                                    const double *x,
+                                                    const size_t number_of_points,
+                                                    double *transformed_x);
+typedef void (*coco_transform_objectives_function_t)(coco_problem_t *self,
+                                                     const size_t number_of_points,
+                                                     double *y);
 typedef void (*coco_recommendation_function_t)(coco_problem_t *self,
                                                const double *x,
                                                size_t number_of_solutions);
 
 typedef void (*coco_free_function_t)(coco_problem_t *self);
+typedef coco_problem_t *(*coco_clone_function_t)(const coco_problem_t *self);
+
+typedef struct coco_thread_pool coco_thread_pool_t;
 
 /**
  * Description of a COCO problem (instance)
@@ -26,6 +40,42 @@ typedef void (*coco_free_function_t)(coco_problem_t *self);
  *
  * Fields:
  *
+ * evaluate_function_batch - Optional method evaluating a row-major
+ *   block of points at once. When NULL, coco_evaluate_function_batch
+ *   falls back to evaluate_function for each point. Layers that
+ *   override evaluate_function without providing a batch method (such
+ *   as the loggers) must leave it NULL.
+ *
+ * transform_variables, transform_objectives - Optional stage methods of
+ *   a transformed problem, at most one of them set. The first maps a
+ *   row-major block of points to the points passed to the inner problem,
+ *   the second maps the block of values returned by the inner problem in
+ *   place. They allow coco_transformed_flatten to evaluate the onion as a
+ *   flat pipeline. Layers that need more (such as the loggers or the
+ *   penalization, which also reads x) leave both NULL.
+ *
+ * clone_problem - Optional method set by the suites on the problems
+ *   they construct. It constructs an independent copy of the problem
+ *   that shares no memory with it (see coco_problem_clone_for_thread).
+ *   It is inherited by the layers wrapped around the problem (such as
+ *   the loggers), so that these can be cloned as well.
+ *
+ * evaluation_threads - Number of threads over which
+ *   coco_evaluate_function_batch splits large batches (see
+ *   coco_problem_set_evaluation_threads). It is set by the suite option
+ *   evaluation_threads and inherited by the layers wrapped around the
+ *   problem (such as the loggers).
+ *
+ * evaluation_clones - Clones of the problem kept by
+ *   coco_evaluate_function_batch for the threads that evaluate large
+ *   batches. The array holds number_of_evaluation_clones clones and is
+ *   NULL until it is needed. It is never shared between layers.
+ *
+ * evaluation_pool - Threads kept by coco_evaluate_function_batch to
+ *   evaluate the clones (evaluation_threads - 1 of them, as the calling
+ *   thread takes part). It is NULL until it is needed and never shared
+ *   between layers.
+ *
  * number_of_variables - Number of parameters expected by the
  *   function and constraints.
  *
@@ -58,9 +108,13 @@ typedef void (*coco_free_function_t)(coco_problem_t *self);
 struct coco_problem {
   coco_initial_solution_function_t initial_solution;
   coco_evaluate_function_t evaluate_function;
+  coco_evaluate_batch_function_t evaluate_function_batch;
+  coco_transform_variables_function_t transform_variables;
+  coco_transform_objectives_function_t transform_objectives;
   coco_evaluate_function_t evaluate_constraint;
   coco_recommendation_function_t recommend_solutions;
   coco_free_function_t free_problem; /* AKA free_self */
+  coco_clone_function_t clone_problem;
   size_t number_of_variables;
   size_t number_of_objectives;
   size_t number_of_constraints;
@@ -81,6 +135,10 @@ struct coco_problem {
   size_t suite_dep_index;
   size_t suite_dep_function;
   size_t suite_dep_instance;
+  size_t evaluation_threads;
+  coco_problem_t **evaluation_clones;
+  size_t number_of_evaluation_clones;
+  coco_thread_pool_t *evaluation_pool;
   void *data;
   /* The prominent usecase for data is coco_transformed_data_t*, making an
    * "onion of problems", initialized in coco_transformed_allocate(...).
@@ -128,6 +186,7 @@ struct coco_observer {
 };
 
 typedef void (*coco_suite_data_free_function_t)(void *data);
+typedef struct coco_problem_cache coco_problem_cache_t;
 
 struct coco_suite {
 
@@ -151,6 +210,17 @@ struct coco_suite {
   void *data;
   coco_suite_data_free_function_t data_free_function;
 
+  /* Optional LRU cache of constructed problems (NULL unless enabled by the suite option problem_cache) */
+  coco_problem_cache_t *problem_cache;
+
+  /* Optional flags of the problems (by problem index) that belong to the chosen batch of the suite (NULL unless
+   * set by the suite option batch) */
+  unsigned char *is_in_batch;
+
+  /* The number of threads of coco_evaluate_function_batch on the problems of the suite (1 unless set by the
+   * suite option evaluation_threads) */
+  size_t evaluation_threads;
+
 };
 
 #endif
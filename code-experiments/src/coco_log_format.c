@@ -0,0 +1,124 @@
+/*
+ * The output formats of the data files written by the bbob and biobjective loggers.
+ *
+ * The observer option "format" selects either the usual text files (format: text, the default) or binary
+ * files (format: binary) that the post-processing can map into memory without parsing. The binary data
+ * files have the same names as the text ones and consist of fixed-width records of little-endian IEEE 754
+ * doubles. All records of a file have the same number of columns, which are the numbers of a line of the
+ * corresponding text file. Each run (the part of a text file that starts with the "%" header lines) begins
+ * with a header that describes the data and holds the information of the "%" lines of the text files:
+ * - bytes 0-7: the magic string "%COCOBIN"
+ * - bytes 8-11: the format version (currently 2) as a little-endian 32-bit unsigned integer
+ * - bytes 12-15: the number of columns as a little-endian 32-bit unsigned integer
+ * - bytes 16-23: a reference value as a double (the optimal f value, the reference indicator value...)
+ * - bytes 24-31: the index of the problem in the suite as a little-endian 64-bit unsigned integer
+ * - bytes 32-39: the instance of the problem as a little-endian 64-bit unsigned integer
+ * - bytes 40-43: the length of the problem name in bytes as a little-endian 32-bit unsigned integer
+ * - bytes 44-: the problem name (without a terminating 0)
+ * - the remaining bytes up to the end of the last record of the header are 0
+ * The header takes as many records as needed for its 44 + (length of the name) bytes. The magic string never
+ * occurs as the first column of a data record, which is a number of evaluations.
+ *
+ * The reader is readalign.readBinary() in the bbob_pproc package.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+#define COCO_LOG_FORMAT_BINARY_VERSION 2
+
+typedef enum {
+  COCO_LOG_FORMAT_TEXT, COCO_LOG_FORMAT_BINARY
+} coco_log_format_t;
+
+/**
+ * Reads the output format from the observer ${options} ("format: text" or "format: binary", the default is
+ * text).
+ */
+static coco_log_format_t coco_log_format_read(const char *options) {
+
+  char value[COCO_PATH_MAX];
+  coco_log_format_t format = COCO_LOG_FORMAT_TEXT;
+
+  if (coco_options_read_string(options, "format", value) > 0) {
+    if (strcmp(value, "binary") == 0)
+      format = COCO_LOG_FORMAT_BINARY;
+    else if (strcmp(value, "text") != 0)
+      coco_warning("coco_log_format_read(): unknown format '%s', using 'text'", value);
+  }
+  return format;
+}
+
+/**
+ * Returns 1 if doubles are stored in little-endian byte order on this machine and 0 otherwise.
+ */
+static int coco_log_format_is_little_endian(void) {
+  const double one = 1.0;
+  unsigned char bytes[sizeof(double)];
+
+  memcpy(bytes, &one, sizeof(double));
+  return bytes[sizeof(double) - 1] == 0x3F;
+}
+
+/**
+ * Writes the ${number_of_columns} ${values} as a binary record to ${file}.
+ */
+static void coco_log_format_write_record(FILE *file, const double *values, const size_t number_of_columns) {
+  unsigned char bytes[sizeof(double)];
+  size_t i, j;
+
+  if (coco_log_format_is_little_endian()) {
+    fwrite(values, sizeof(double), number_of_columns, file);
+    return;
+  }
+  for (i = 0; i < number_of_columns; i++) {
+    memcpy(bytes, &values[i], sizeof(double));
+    for (j = sizeof(double); j > 0; j--)
+      fputc(bytes[j - 1], file);
+  }
+}
+
+/**
+ * Writes the ${number_of_bytes} little-endian bytes of the ${value} to ${bytes}.
+ */
+static void coco_log_format_encode_unsigned(unsigned char *bytes, const size_t number_of_bytes,
+                                            const unsigned long value) {
+  size_t i;
+
+  for (i = 0; i < number_of_bytes; i++)
+    bytes[i] = (unsigned char) ((i < sizeof(value)) ? (value >> (8 * i)) & 0xFF : 0);
+}
+
+/**
+ * Writes a binary header announcing a new run with records of ${number_of_columns} (at least 3) columns of the
+ * problem with the given suite ${index}, ${instance} and ${name} to ${file}.
+ */
+static void coco_log_format_write_header(FILE *file,
+                                         const size_t number_of_columns,
+                                         const double reference_value,
+                                         const size_t index,
+                                         const size_t instance,
+                                         const char *name) {
+  unsigned char bytes[44] = { '%', 'C', 'O', 'C', 'O', 'B', 'I', 'N' };
+  const size_t name_length = strlen(name);
+  const size_t record_size = number_of_columns * sizeof(double);
+  size_t header_size;
+
+  assert(number_of_columns >= 3);
+  coco_log_format_encode_unsigned(bytes + 8, 4, COCO_LOG_FORMAT_BINARY_VERSION);
+  coco_log_format_encode_unsigned(bytes + 12, 4, (unsigned long) number_of_columns);
+  fwrite(bytes, 1, 16, file);
+  coco_log_format_write_record(file, &reference_value, 1);
+  coco_log_format_encode_unsigned(bytes + 24, 8, (unsigned long) index);
+  coco_log_format_encode_unsigned(bytes + 32, 8, (unsigned long) instance);
+  coco_log_format_encode_unsigned(bytes + 40, 4, (unsigned long) name_length);
+  fwrite(bytes + 24, 1, 20, file);
+  fwrite(name, 1, name_length, file);
+
+  /* Pad the header to a whole number of records */
+  for (header_size = 44 + name_length; header_size % record_size != 0; header_size++)
+    fputc(0, file);
+}
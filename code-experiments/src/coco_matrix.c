@@ -0,0 +1,208 @@
+/*
+ * Dense matrices stored in a single contiguous, 64-byte aligned, row-major block, and the dense
+ * linear algebra kernels (matrix-vector and matrix-points products) shared by the affine
+ * transformation and the monolithic BBOB functions. The kernels are plain C so that the amalgamated
+ * coco.c needs no BLAS.
+ *
+ * Element (i, j) of a matrix m lives at m->data[i * m->number_of_columns + j]. The alignment matches
+ * the cache line size and the widest common SIMD registers, so rows can be streamed by vectorised
+ * loops.
+ */
+#include <assert.h>
+#include <stddef.h>
+
+#include "coco.h"
+
+#define COCO_MATRIX_ALIGNMENT 64
+#define COCO_MATRIX_BLOCK_ROWS 64 /* 64 rows of a 40-D matrix take 20 KB, which fits into L1 */
+
+typedef struct {
+  size_t number_of_rows;
+  size_t number_of_columns;
+  double *data;   /* Aligned row-major elements */
+  void *memory;   /* Block returned by coco_allocate_memory(), owns data */
+} coco_matrix_t;
+
+/**
+ * coco_matrix_allocate(number_of_rows, number_of_columns):
+ *
+ * Allocate a ${number_of_rows} by ${number_of_columns} matrix. The elements are not initialized. The
+ * caller is responsible for freeing the matrix using coco_matrix_free().
+ */
+static coco_matrix_t *coco_matrix_allocate(const size_t number_of_rows, const size_t number_of_columns) {
+  coco_matrix_t *matrix;
+  size_t offset;
+
+  assert(number_of_rows > 0);
+  assert(number_of_columns > 0);
+
+  matrix = (coco_matrix_t *) coco_allocate_memory(sizeof(*matrix));
+  matrix->number_of_rows = number_of_rows;
+  matrix->number_of_columns = number_of_columns;
+  matrix->memory = coco_allocate_memory(number_of_rows * number_of_columns * sizeof(double)
+      + COCO_MATRIX_ALIGNMENT);
+  offset = (size_t) matrix->memory % COCO_MATRIX_ALIGNMENT;
+  matrix->data = (double *) (void *) ((char *) matrix->memory
+      + (offset == 0 ? 0 : COCO_MATRIX_ALIGNMENT - offset));
+  return matrix;
+}
+
+static void coco_matrix_free(coco_matrix_t *matrix) {
+  if (matrix == NULL)
+    return;
+  coco_free_memory(matrix->memory);
+  coco_free_memory(matrix);
+}
+
+/**
+ * Returns a pointer to the first element of row ${row} of ${matrix}.
+ */
+static double *coco_matrix_row(const coco_matrix_t *matrix, const size_t row) {
+  assert(row < matrix->number_of_rows);
+  return matrix->data + row * matrix->number_of_columns;
+}
+
+/**
+ * Computes y[i] = b[i] + sum_j matrix[i][j] * x[j] for the rows first_row <= i < last_row. If ${b}
+ * is NULL, the sums start at 0.0.
+ *
+ * Four rows are processed together so that every element of x is loaded once per block of rows and
+ * the four independent sums can be kept in (SIMD) registers. Each element of y is still accumulated
+ * from left to right, so the result is bit-identical to the naive double loop.
+ */
+static void coco_matrix_multiply_rows(const coco_matrix_t *matrix,
+                                      const size_t first_row,
+                                      const size_t last_row,
+                                      const double *x,
+                                      const double *b,
+                                      double *y) {
+  const size_t n = matrix->number_of_columns;
+  size_t i = first_row, j;
+
+  for (; i + 4 <= last_row; i += 4) {
+    const double *row0 = matrix->data + i * n;
+    const double *row1 = row0 + n;
+    const double *row2 = row1 + n;
+    const double *row3 = row2 + n;
+    double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+    if (b != NULL) {
+      sum0 = b[i];
+      sum1 = b[i + 1];
+      sum2 = b[i + 2];
+      sum3 = b[i + 3];
+    }
+    for (j = 0; j < n; ++j) {
+      const double xj = x[j];
+      sum0 += xj * row0[j];
+      sum1 += xj * row1[j];
+      sum2 += xj * row2[j];
+      sum3 += xj * row3[j];
+    }
+    y[i] = sum0;
+    y[i + 1] = sum1;
+    y[i + 2] = sum2;
+    y[i + 3] = sum3;
+  }
+  for (; i < last_row; ++i) {
+    const double *row = matrix->data + i * n;
+    double sum = (b != NULL) ? b[i] : 0.0;
+    for (j = 0; j < n; ++j) {
+      sum += x[j] * row[j];
+    }
+    y[i] = sum;
+  }
+}
+
+/**
+ * coco_matrix_multiply_vector(matrix, x, b, y):
+ *
+ * Compute y = matrix * x + b (GEMV). ${x} must hold number_of_columns and ${y} number_of_rows
+ * elements and they must not overlap. ${b} can be NULL, in which case it is taken to be zero.
+ */
+static void coco_matrix_multiply_vector(const coco_matrix_t *matrix, const double *x, const double *b, double *y) {
+  coco_matrix_multiply_rows(matrix, 0, matrix->number_of_rows, x, b, y);
+}
+
+/**
+ * coco_matrix_multiply_points(matrix, x, number_of_points, b, y):
+ *
+ * Compute y_k = matrix * x_k + b for the ${number_of_points} points stored row-major in ${x} and
+ * ${y} (GEMM with the transposed matrix). ${b} can be NULL. The results are bit-identical to
+ * calling coco_matrix_multiply_vector() on every point.
+ *
+ * The rows of the matrix are processed in blocks of COCO_MATRIX_BLOCK_ROWS, so that a block stays
+ * in the cache while it is applied to all points. Within a block, tiles of four points times four
+ * rows are computed with sixteen independent sums, which loads every matrix element once per four
+ * points and every point element once per four rows.
+ */
+static void coco_matrix_multiply_points(const coco_matrix_t *matrix,
+                                        const double *x,
+                                        const size_t number_of_points,
+                                        const double *b,
+                                        double *y) {
+  const size_t m = matrix->number_of_rows;
+  const size_t n = matrix->number_of_columns;
+  size_t first_row, last_row, i, j, k, p;
+
+  for (first_row = 0; first_row < m; first_row += COCO_MATRIX_BLOCK_ROWS) {
+    last_row = first_row + COCO_MATRIX_BLOCK_ROWS < m ? first_row + COCO_MATRIX_BLOCK_ROWS : m;
+    for (k = 0; k + 4 <= number_of_points; k += 4) {
+      const double *x0 = x + k * n;
+      const double *x1 = x0 + n;
+      const double *x2 = x1 + n;
+      const double *x3 = x2 + n;
+      for (i = first_row; i + 4 <= last_row; i += 4) {
+        const double *row0 = matrix->data + i * n;
+        const double *row1 = row0 + n;
+        const double *row2 = row1 + n;
+        const double *row3 = row2 + n;
+        double s00, s01, s02, s03, s10, s11, s12, s13, s20, s21, s22, s23, s30, s31, s32, s33;
+        s00 = s10 = s20 = s30 = (b != NULL) ? b[i] : 0.0;
+        s01 = s11 = s21 = s31 = (b != NULL) ? b[i + 1] : 0.0;
+        s02 = s12 = s22 = s32 = (b != NULL) ? b[i + 2] : 0.0;
+        s03 = s13 = s23 = s33 = (b != NULL) ? b[i + 3] : 0.0;
+        for (j = 0; j < n; ++j) {
+          const double m0 = row0[j], m1 = row1[j], m2 = row2[j], m3 = row3[j];
+          s00 += x0[j] * m0;
+          s01 += x0[j] * m1;
+          s02 += x0[j] * m2;
+          s03 += x0[j] * m3;
+          s10 += x1[j] * m0;
+          s11 += x1[j] * m1;
+          s12 += x1[j] * m2;
+          s13 += x1[j] * m3;
+          s20 += x2[j] * m0;
+          s21 += x2[j] * m1;
+          s22 += x2[j] * m2;
+          s23 += x2[j] * m3;
+          s30 += x3[j] * m0;
+          s31 += x3[j] * m1;
+          s32 += x3[j] * m2;
+          s33 += x3[j] * m3;
+        }
+        y[k * m + i] = s00;
+        y[k * m + i + 1] = s01;
+        y[k * m + i + 2] = s02;
+        y[k * m + i + 3] = s03;
+        y[(k + 1) * m + i] = s10;
+        y[(k + 1) * m + i + 1] = s11;
+        y[(k + 1) * m + i + 2] = s12;
+        y[(k + 1) * m + i + 3] = s13;
+        y[(k + 2) * m + i] = s20;
+        y[(k + 2) * m + i + 1] = s21;
+        y[(k + 2) * m + i + 2] = s22;
+        y[(k + 2) * m + i + 3] = s23;
+        y[(k + 3) * m + i] = s30;
+        y[(k + 3) * m + i + 1] = s31;
+        y[(k + 3) * m + i + 2] = s32;
+        y[(k + 3) * m + i + 3] = s33;
+      }
+      for (p = k; p < k + 4; ++p) {
+        coco_matrix_multiply_rows(matrix, i, last_row, x + p * n, b, y + p * m);
+      }
+    }
+    for (; k < number_of_points; ++k) {
+      coco_matrix_multiply_rows(matrix, first_row, last_row, x + k * n, b, y + k * m);
+    }
+  }
+}
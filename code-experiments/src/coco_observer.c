@@ -9,28 +9,29 @@
 static const size_t coco_observer_always_log[3] = {1, 2, 5};
 
 /**
- * Returns true if the number_of_evaluations corresponds to a number that should always be logged and false
- * otherwise (computed from coco_observer_always_log). For example, if coco_observer_always_log = {1, 2, 5},
- * return true for 1, dim*1, dim*2, dim*5, 10*dim*1, 10*dim*2, 10*dim*5, 100*dim*1, 100*dim*2, 100*dim*5, ...
+ * Returns the smallest number of evaluations larger than number_of_evaluations that should always be logged
+ * (computed from coco_observer_always_log). For example, if coco_observer_always_log = {1, 2, 5}, the
+ * returned numbers are 1, dim*1, dim*2, dim*5, 10*dim*1, 10*dim*2, 10*dim*5, 100*dim*1, 100*dim*2,
+ * 100*dim*5, ... The loggers call this function only when the previously returned number is reached, so
+ * that checking whether an evaluation should be logged amounts to a single comparison.
  */
-static int coco_observer_evaluation_to_log(size_t number_of_evaluations, size_t dimension) {
+static size_t coco_observer_next_evaluation_to_log(size_t number_of_evaluations, size_t dimension) {
 
-  size_t i;
+  size_t i, candidate;
   double j = 0, factor = 10;
   size_t count = sizeof(coco_observer_always_log) / sizeof(size_t);
 
-  if (number_of_evaluations == 1)
+  if (number_of_evaluations < 1)
     return 1;
 
-  while ((size_t) pow(factor, j) * dimension <= number_of_evaluations) {
+  for (;;) {
     for (i = 0; i < count; i++) {
-      if (number_of_evaluations == (size_t) pow(factor, j) * dimension * coco_observer_always_log[i])
-        return 1;
+      candidate = (size_t) pow(factor, j) * dimension * coco_observer_always_log[i];
+      if (candidate > number_of_evaluations)
+        return candidate;
     }
     j++;
   }
-
-  return 0;
 }
 
 #include "logger_bbob.c"
@@ -73,6 +73,26 @@ int mkdir(const char *pathname, mode_t mode);
 #define S_IRWXU 0700
 #endif
 
+/* Definitions of HAVE_THREADS, HAVE_PTHREADS and HAVE_WINTHREADS used by the functions in coco_thread.c. Threads are only
+ * used when COCO_THREADS is defined, because some platforms need additional flags to link them (-pthread).
+ * Otherwise, the functions that could use several threads do all their work in the calling thread. */
+#if defined(COCO_THREADS)
+#define HAVE_THREADS 1
+#if defined(HAVE_GFA)
+#define HAVE_WINTHREADS 1
+#else
+#include <pthread.h>
+#define HAVE_PTHREADS 1
+#endif
+#endif
+
+/* Definition of HAVE_SIMD_X86 used by the kernels in coco_simd.c. SIMD kernels are only used when COCO_SIMD is
+ * defined, because they change the results by rounding. They need GCC-compatible compilers on x86-64, where SSE2 is
+ * always available and AVX2 or AVX-512F are chosen at runtime. Otherwise, the kernels are plain loops. */
+#if defined(COCO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define HAVE_SIMD_X86 1
+#endif
+
 /* To silence the Visual Studio compiler (C4996 warnings in the python build). */
 #ifdef _MSC_VER
 #pragma warning(disable:4996)
@@ -2,6 +2,7 @@
 #include "coco.h"
 
 #include "coco_utilities.c"
+#include "coco_thread.c"
 
 /***********************************
  * Global definitions in this file
@@ -35,6 +36,7 @@ coco_problem_t *coco_stacked_problem_allocate(coco_problem_t *problem1_to_be_sta
 /***********************************/
 
 void coco_problem_free(coco_problem_t *self) {
+  size_t i;
   assert(self != NULL);
   if (self->free_problem != NULL) {
     self->free_problem(self);
@@ -58,6 +60,15 @@ void coco_problem_free(coco_problem_t *self) {
       coco_free_memory(self->problem_type);
     if (self->data != NULL)
       coco_free_memory(self->data);
+#if defined(HAVE_THREADS)
+    if (self->evaluation_pool != NULL)
+      coco_thread_pool_free(self->evaluation_pool);
+#endif
+    if (self->evaluation_clones != NULL) {
+      for (i = 0; i < self->number_of_evaluation_clones; i++)
+        coco_problem_free(self->evaluation_clones[i]);
+      coco_free_memory(self->evaluation_clones);
+    }
     self->smallest_values_of_interest = NULL;
     self->largest_values_of_interest = NULL;
     self->best_parameter = NULL;
@@ -82,9 +93,13 @@ coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   /* Initialize fields to sane/safe defaults */
   problem->initial_solution = NULL;
   problem->evaluate_function = NULL;
+  problem->evaluate_function_batch = NULL;
+  problem->transform_variables = NULL;
+  problem->transform_objectives = NULL;
   problem->evaluate_constraint = NULL;
   problem->recommend_solutions = NULL;
   problem->free_problem = NULL;
+  problem->clone_problem = NULL;
   problem->number_of_variables = number_of_variables;
   problem->number_of_objectives = number_of_objectives;
   problem->number_of_constraints = number_of_constraints;
@@ -106,6 +121,10 @@ coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   problem->suite_dep_index = 0;
   problem->suite_dep_function = 0;
   problem->suite_dep_instance = 0;
+  problem->evaluation_threads = 1;
+  problem->evaluation_clones = NULL;
+  problem->number_of_evaluation_clones = 0;
+  problem->evaluation_pool = NULL;
   problem->data = NULL;
   return problem;
 }
@@ -121,9 +140,13 @@ coco_problem_t *coco_problem_duplicate(coco_problem_t *other) {
 
   problem->initial_solution = other->initial_solution;
   problem->evaluate_function = other->evaluate_function;
+  problem->evaluate_function_batch = other->evaluate_function_batch;
+  problem->transform_variables = other->transform_variables;
+  problem->transform_objectives = other->transform_objectives;
   problem->evaluate_constraint = other->evaluate_constraint;
   problem->recommend_solutions = other->recommend_solutions;
   problem->free_problem = NULL;
+  problem->clone_problem = other->clone_problem;
 
   for (i = 0; i < problem->number_of_variables; ++i) {
     problem->smallest_values_of_interest[i] = other->smallest_values_of_interest[i];
@@ -155,6 +178,10 @@ coco_problem_t *coco_problem_duplicate(coco_problem_t *other) {
   problem->suite_dep_function = other->suite_dep_function;
   problem->suite_dep_instance = other->suite_dep_instance;
 
+  problem->evaluation_threads = other->evaluation_threads;
+  problem->evaluation_clones = NULL;
+  problem->number_of_evaluation_clones = 0;
+  problem->evaluation_pool = NULL;
   problem->data = NULL;
 
   return problem;
@@ -264,6 +291,25 @@ static void coco_problem_set_type(coco_problem_t *problem, const char *type, ...
   va_end(args);
 }
 
+/**
+ * Flat evaluation pipeline of a transformed problem, see coco_transformed_flatten().
+ *
+ * stages - The layers with stage methods in the order in which they receive x, starting with the
+ *   problem that owns the pipeline
+ *
+ * leaf - The inner problem of the last stage
+ *
+ * buffers - Two ping-pong buffers for buffer_capacity points with max_number_of_variables each
+ */
+typedef struct {
+  coco_problem_t **stages;
+  size_t number_of_stages;
+  coco_problem_t *leaf;
+  size_t max_number_of_variables;
+  size_t buffer_capacity;
+  double *buffers[2];
+} coco_transformed_pipeline_t;
+
 /**
  * Generic data member of a transformed (or "outer") coco_problem_t.
  */
@@ -271,8 +317,16 @@ typedef struct {
   coco_problem_t *inner_problem;
   void *data;
   coco_transformed_free_data_t free_data;
+  coco_transformed_pipeline_t *pipeline; /* NULL unless flattened */
 } coco_transformed_data_t;
 
+static void coco_transformed_pipeline_free(coco_transformed_pipeline_t *pipeline) {
+  coco_free_memory(pipeline->stages);
+  coco_free_memory(pipeline->buffers[0]);
+  coco_free_memory(pipeline->buffers[1]);
+  coco_free_memory(pipeline);
+}
+
 static void transformed_evaluate_function(coco_problem_t *self, const double *x, double *y) {
   coco_transformed_data_t *data;
   assert(self != NULL);
@@ -309,8 +363,12 @@ static void transformed_free_problem(coco_problem_t *self) {
   assert(self != NULL);
   assert(self->data != NULL);
   data = self->data;
-  assert(data->inner_problem != NULL);
 
+  if (data->pipeline != NULL) {
+    coco_transformed_pipeline_free(data->pipeline);
+    data->pipeline = NULL;
+  }
+  /* The inner problem is NULL only after coco_transformed_remove_inner_problem() */
   if (data->inner_problem != NULL) {
     coco_problem_free(data->inner_problem);
     data->inner_problem = NULL;
@@ -348,9 +406,15 @@ coco_problem_t *coco_transformed_allocate(coco_problem_t *inner_problem,
   data->inner_problem = inner_problem;
   data->data = userdata;
   data->free_data = free_data;
+  data->pipeline = NULL;
 
   self = coco_problem_duplicate(inner_problem);
   self->evaluate_function = transformed_evaluate_function;
+  /* The batch method of the inner problem cannot be inherited, because
+   * it expects the inner data. Transformations set their own. */
+  self->evaluate_function_batch = NULL;
+  self->transform_variables = NULL;
+  self->transform_objectives = NULL;
   self->evaluate_constraint = transformed_evaluate_constraint;
   self->recommend_solutions = transformed_recommend_solutions;
   self->free_problem = transformed_free_problem;
@@ -374,6 +438,173 @@ coco_problem_t *coco_transformed_get_inner_problem(coco_problem_t *self) {
   return ((coco_transformed_data_t *) self->data)->inner_problem;
 }
 
+/**
+ * Returns 1 if ${self} was allocated by coco_transformed_allocate() and 0 otherwise.
+ */
+static int coco_transformed_is_transformed(const coco_problem_t *self) {
+  assert(self != NULL);
+  return self->free_problem == transformed_free_problem;
+}
+
+/**
+ * Replaces the (outer) data of the transformed problem ${self} by ${userdata}, freeing the old one.
+ */
+static void coco_transformed_replace_data(coco_problem_t *self,
+                                          void *userdata,
+                                          coco_transformed_free_data_t free_data) {
+  coco_transformed_data_t *data;
+  assert(coco_transformed_is_transformed(self));
+  data = self->data;
+  if (data->data != NULL) {
+    if (data->free_data != NULL)
+      data->free_data(data->data);
+    coco_free_memory(data->data);
+  }
+  data->data = userdata;
+  data->free_data = free_data;
+}
+
+/**
+ * Unlinks the inner problem of ${self}, which must be a transformed problem itself, from the
+ * onion and frees it. Its own inner problem becomes the inner problem of ${self}.
+ */
+static void coco_transformed_remove_inner_problem(coco_problem_t *self) {
+  coco_transformed_data_t *data, *inner_data;
+  coco_problem_t *inner_problem;
+  assert(coco_transformed_is_transformed(self));
+  data = self->data;
+  inner_problem = data->inner_problem;
+  assert(coco_transformed_is_transformed(inner_problem));
+  inner_data = inner_problem->data;
+  /* The pipelines would still point to the removed layer */
+  assert(data->pipeline == NULL && inner_data->pipeline == NULL);
+  data->inner_problem = inner_data->inner_problem;
+  inner_data->inner_problem = NULL;
+  coco_problem_free(inner_problem);
+}
+
+/**
+ * Evaluates the ${number_of_points} row-major points in ${x} through the pipeline of ${self}: the
+ * variable stages map x from one ping-pong buffer to the other, the leaf is evaluated once for the
+ * whole block and the objective stages then map y in place, innermost first. Only ${self} and the
+ * leaf do any bookkeeping.
+ */
+static void coco_transformed_pipeline_evaluate_batch(coco_problem_t *self,
+                                                     const double *x,
+                                                     const size_t number_of_points,
+                                                     double *y) {
+  coco_transformed_pipeline_t *pipeline;
+  coco_problem_t *stage, *leaf;
+  const double *current_x;
+  double *next_x;
+  size_t i, buffer_idx;
+
+  pipeline = ((coco_transformed_data_t *) self->data)->pipeline;
+  assert(pipeline != NULL);
+
+  if (number_of_points > pipeline->buffer_capacity) {
+    coco_free_memory(pipeline->buffers[0]);
+    coco_free_memory(pipeline->buffers[1]);
+    pipeline->buffer_capacity = number_of_points;
+    pipeline->buffers[0] = coco_allocate_vector(number_of_points * pipeline->max_number_of_variables);
+    pipeline->buffers[1] = coco_allocate_vector(number_of_points * pipeline->max_number_of_variables);
+  }
+
+  current_x = x;
+  buffer_idx = 0;
+  for (i = 0; i < pipeline->number_of_stages; ++i) {
+    stage = pipeline->stages[i];
+    if (stage->transform_variables != NULL) {
+      next_x = pipeline->buffers[buffer_idx];
+      stage->transform_variables(stage, current_x, number_of_points, next_x);
+      current_x = next_x;
+      buffer_idx = 1 - buffer_idx;
+    }
+  }
+
+  leaf = pipeline->leaf;
+  if (coco_transformed_is_transformed(leaf)) {
+    coco_evaluate_function_batch(leaf, current_x, number_of_points, y);
+  } else if (leaf->evaluate_function_batch != NULL) {
+    leaf->evaluate_function_batch(leaf, current_x, number_of_points, y);
+  } else {
+    for (i = 0; i < number_of_points; ++i) {
+      leaf->evaluate_function(leaf, current_x + i * leaf->number_of_variables,
+          y + i * leaf->number_of_objectives);
+    }
+  }
+
+  for (i = pipeline->number_of_stages; i > 0; --i) {
+    stage = pipeline->stages[i - 1];
+    if (stage->transform_objectives != NULL) {
+      stage->transform_objectives(stage, number_of_points, y);
+    }
+  }
+}
+
+static void coco_transformed_pipeline_evaluate(coco_problem_t *self, const double *x, double *y) {
+  coco_transformed_pipeline_evaluate_batch(self, x, 1, y);
+}
+
+/**
+ * Compiles the onion of ${problem} into flat pipelines, so that an evaluation runs through all
+ * stages in a single loop instead of one recursive coco_evaluate_function() call per layer.
+ *
+ * The outermost run of layers with stage methods (see coco_problem) is attached to the first of
+ * them, whose evaluate methods are replaced by the pipeline. Layers without stage methods are kept
+ * as they are and the onion below them is flattened in turn. Inner layers of a pipeline do not
+ * count their evaluations any more.
+ *
+ * This should be the last step in the construction of a problem; adding further layers around it
+ * is fine, but the flattened layers must not be modified. Returns ${problem}.
+ */
+static coco_problem_t *coco_transformed_flatten(coco_problem_t *problem) {
+  coco_problem_t *first_stage, *current;
+  coco_transformed_data_t *data;
+  coco_transformed_pipeline_t *pipeline;
+  size_t i;
+
+  first_stage = problem;
+  while (coco_transformed_is_transformed(first_stage) && first_stage->transform_variables == NULL
+      && first_stage->transform_objectives == NULL) {
+    first_stage = coco_transformed_get_inner_problem(first_stage);
+  }
+  if (!coco_transformed_is_transformed(first_stage))
+    return problem;
+
+  pipeline = coco_allocate_memory(sizeof(*pipeline));
+  pipeline->number_of_stages = 0;
+  pipeline->max_number_of_variables = first_stage->number_of_variables;
+  current = first_stage;
+  while (coco_transformed_is_transformed(current)
+      && (current->transform_variables != NULL || current->transform_objectives != NULL)) {
+    pipeline->number_of_stages++;
+    current = coco_transformed_get_inner_problem(current);
+    if (current->number_of_variables > pipeline->max_number_of_variables)
+      pipeline->max_number_of_variables = current->number_of_variables;
+  }
+  pipeline->leaf = current;
+  pipeline->stages = coco_allocate_memory(pipeline->number_of_stages * sizeof(coco_problem_t *));
+  current = first_stage;
+  for (i = 0; i < pipeline->number_of_stages; ++i) {
+    pipeline->stages[i] = current;
+    current = coco_transformed_get_inner_problem(current);
+  }
+  pipeline->buffer_capacity = 1;
+  pipeline->buffers[0] = coco_allocate_vector(pipeline->max_number_of_variables);
+  pipeline->buffers[1] = coco_allocate_vector(pipeline->max_number_of_variables);
+
+  data = first_stage->data;
+  if (data->pipeline != NULL)
+    coco_transformed_pipeline_free(data->pipeline);
+  data->pipeline = pipeline;
+  first_stage->evaluate_function = coco_transformed_pipeline_evaluate;
+  first_stage->evaluate_function_batch = coco_transformed_pipeline_evaluate_batch;
+
+  coco_transformed_flatten(pipeline->leaf);
+  return problem;
+}
+
 /** type provided COCO problem data for a stacked COCO problem
  */
 typedef struct {
@@ -515,3 +746,131 @@ coco_problem_t *coco_stacked_problem_allocate(coco_problem_t *problem1,
   return problem;
 }
 
+
+/***********************************
+ * Clones of problems for the evaluation from several threads
+ ***********************************/
+
+/**
+ * Returns the innermost layer of ${problem} that can be cloned, that is, the problem constructed by the
+ * suite (below all layers that were wrapped around it afterwards, such as the loggers).
+ */
+static coco_problem_t *coco_problem_get_clone_origin(coco_problem_t *problem) {
+  while (coco_transformed_is_transformed(problem)
+      && (coco_transformed_get_inner_problem(problem)->clone_problem != NULL))
+    problem = coco_transformed_get_inner_problem(problem);
+  return problem;
+}
+
+/**
+ * Returns an independent copy of the ${problem}, which evaluates the same function but shares no memory
+ * (in particular no scratch memory of the transformations) with it. The clone is not observed and starts with
+ * no evaluations.
+ *
+ * A problem and its clones can be evaluated concurrently from different threads, as long as each of them is
+ * used by one thread at a time. The evaluations done on a clone are accounted to the original problem (and
+ * its loggers) by coco_problem_merge_evaluations().
+ */
+coco_problem_t *coco_problem_clone_for_thread(coco_problem_t *problem) {
+  coco_problem_t *origin, *clone;
+
+  assert(problem != NULL);
+  if (problem->clone_problem == NULL) {
+    coco_error("coco_problem_clone_for_thread(): problem %s cannot be cloned", problem->problem_id);
+    return NULL; /* Never reached */
+  }
+  origin = coco_problem_get_clone_origin(problem);
+  clone = origin->clone_problem(origin);
+  clone->clone_problem = origin->clone_problem;
+  coco_free_memory(clone->problem_id);
+  coco_free_memory(clone->problem_name);
+  coco_free_memory(clone->problem_type);
+  clone->problem_id = coco_strdup(origin->problem_id);
+  clone->problem_name = coco_strdup(origin->problem_name);
+  clone->problem_type = coco_strdup(origin->problem_type);
+  clone->suite_dep_index = origin->suite_dep_index;
+  clone->suite_dep_function = origin->suite_dep_function;
+  clone->suite_dep_instance = origin->suite_dep_instance;
+  return clone;
+}
+
+/**
+ * Data of a problem whose evaluation is replayed by coco_problem_merge_evaluations()
+ */
+typedef struct {
+  const double *y; /* The values of the next evaluation */
+} coco_problem_replay_data_t;
+
+static void coco_problem_replay_evaluate(coco_problem_t *self, const double *x, double *y) {
+  coco_problem_replay_data_t *data = (coco_problem_replay_data_t *) self->data;
+  size_t i;
+
+  for (i = 0; i < self->number_of_objectives; i++)
+    y[i] = data->y[i];
+  data->y += self->number_of_objectives;
+  (void) x; /* unused */
+}
+
+/**
+ * Lets ${problem} account the ${number_of_points} points stored row by row in ${x}, whose values computed by
+ * (a clone of) the origin of ${problem} are stored row by row in ${origin_values}. The values of ${problem}
+ * are stored row by row in ${values}, unless it is NULL.
+ */
+static void coco_problem_replay_evaluations(coco_problem_t *problem,
+                                            const double *x,
+                                            const size_t number_of_points,
+                                            const double *origin_values,
+                                            double *values) {
+  coco_problem_t *origin;
+  coco_evaluate_function_t evaluate_function;
+  coco_evaluate_batch_function_t evaluate_function_batch;
+  void *data;
+  coco_problem_replay_data_t replay_data;
+  double *scratch = NULL;
+  size_t i;
+
+  /* Let the origin replay the given values while the layers around it do their usual work */
+  origin = coco_problem_get_clone_origin(problem);
+  evaluate_function = origin->evaluate_function;
+  evaluate_function_batch = origin->evaluate_function_batch;
+  data = origin->data;
+  replay_data.y = origin_values;
+  origin->evaluate_function = coco_problem_replay_evaluate;
+  origin->evaluate_function_batch = NULL;
+  origin->data = &replay_data;
+
+  if (values == NULL)
+    scratch = coco_allocate_vector(problem->number_of_objectives);
+  for (i = 0; i < number_of_points; i++)
+    coco_evaluate_function(problem, x + i * problem->number_of_variables,
+        (values == NULL) ? scratch : values + i * problem->number_of_objectives);
+  if (scratch != NULL)
+    coco_free_memory(scratch);
+
+  origin->evaluate_function = evaluate_function;
+  origin->evaluate_function_batch = evaluate_function_batch;
+  origin->data = data;
+}
+
+/**
+ * Accounts the ${number_of_points} evaluations of clones of ${problem} (see coco_problem_clone_for_thread()),
+ * stored row by row in ${x} and ${y}, to the ${problem} in the given order. The evaluation counters, the best
+ * observed values and the loggers of the ${problem} end up exactly as if the points had been evaluated by
+ * ${problem} itself, but the function is not evaluated again.
+ *
+ * This function must not be called concurrently with other evaluations of ${problem}. It is typically called
+ * once the threads evaluating the clones have been joined.
+ */
+void coco_problem_merge_evaluations(coco_problem_t *problem,
+                                    const double *x,
+                                    const size_t number_of_points,
+                                    const double *y) {
+  assert(problem != NULL);
+  if (number_of_points == 0)
+    return;
+  if (problem->clone_problem == NULL) {
+    coco_error("coco_problem_merge_evaluations(): problem %s cannot be cloned", problem->problem_id);
+    return; /* Never reached */
+  }
+  coco_problem_replay_evaluations(problem, x, number_of_points, y, NULL);
+}
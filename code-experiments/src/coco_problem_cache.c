@@ -0,0 +1,340 @@
+/*
+ * An optional, bounded LRU cache of constructed suite problems keyed by (function, dimension, instance).
+ *
+ * Constructing a BBOB problem computes its optimum and one or two rotation matrices (Gram-Schmidt, O(D^3))
+ * and folds the linear transformations (again O(D^3)). Suites that request the same problem repeatedly
+ * (restarts through coco_suite_get_problem(), or the bi-objective suite that pairs every single-objective
+ * problem with many others) can keep the constructed problems in a cache.
+ *
+ * The cached problems are never handed out directly. Every request returns a light handle problem that
+ * duplicates the metadata of the cached one (O(D)) and forwards evaluations to it without any bookkeeping
+ * on the shared problem. The handles are reference counted, so a problem that is evicted from the cache
+ * (or whose cache is freed) stays alive until the last handle is freed.
+ *
+ * All handles of a problem share the scratch memory of the cached problem. When COCO is compiled with
+ * COCO_THREADS, the cache and every cached problem are therefore protected by a mutex: the handles can be
+ * used from different threads, but the evaluations through the handles of the same problem are done one
+ * after the other. Clones (see coco_problem_clone_for_thread()) can be evaluated concurrently instead.
+ * Without COCO_THREADS, the handles of a problem must not be evaluated concurrently.
+ */
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_problem.c"
+#include "coco_thread.c"
+
+typedef coco_problem_t *(*coco_problem_cache_constructor_t)(const size_t function,
+                                                            const size_t dimension,
+                                                            const size_t instance);
+
+/**
+ * A cached problem together with the number of references to it (the cache itself holds one while the
+ * entry is in the cache, every handle holds another one).
+ */
+typedef struct coco_problem_cache_entry {
+  size_t function;
+  size_t dimension;
+  size_t instance;
+  coco_problem_t *problem;
+  size_t number_of_references;
+  struct coco_problem_cache_entry *previous; /* more recently used */
+  struct coco_problem_cache_entry *next;     /* less recently used */
+#if defined(HAVE_THREADS)
+  coco_mutex_t mutex; /* Protects number_of_references and the evaluations of the problem */
+#endif
+} coco_problem_cache_entry_t;
+
+/**
+ * The cache is a doubly linked list ordered from the most to the least recently used entry. Lookups are
+ * linear, which is cheap compared to constructing a problem for the cache sizes that make sense.
+ */
+struct coco_problem_cache {
+  size_t capacity;
+  size_t number_of_entries;
+  coco_problem_cache_entry_t *first;
+  coco_problem_cache_entry_t *last;
+  size_t number_of_hits;
+  size_t number_of_misses;
+#if defined(HAVE_THREADS)
+  coco_mutex_t mutex; /* Protects all fields except capacity */
+#endif
+};
+
+static void coco_problem_cache_entry_lock(coco_problem_cache_entry_t *entry) {
+#if defined(HAVE_THREADS)
+  coco_mutex_lock(&entry->mutex);
+#else
+  (void) entry; /* unused */
+#endif
+}
+
+static void coco_problem_cache_entry_unlock(coco_problem_cache_entry_t *entry) {
+#if defined(HAVE_THREADS)
+  coco_mutex_unlock(&entry->mutex);
+#else
+  (void) entry; /* unused */
+#endif
+}
+
+static void coco_problem_cache_lock(coco_problem_cache_t *cache) {
+#if defined(HAVE_THREADS)
+  coco_mutex_lock(&cache->mutex);
+#else
+  (void) cache; /* unused */
+#endif
+}
+
+static void coco_problem_cache_unlock(coco_problem_cache_t *cache) {
+#if defined(HAVE_THREADS)
+  coco_mutex_unlock(&cache->mutex);
+#else
+  (void) cache; /* unused */
+#endif
+}
+
+/**
+ * Returns a new entry for the ${problem}, referenced once (by the cache).
+ */
+static coco_problem_cache_entry_t *coco_problem_cache_entry_allocate(const size_t function,
+                                                                     const size_t dimension,
+                                                                     const size_t instance,
+                                                                     coco_problem_t *problem) {
+  coco_problem_cache_entry_t *entry;
+
+  entry = (coco_problem_cache_entry_t *) coco_allocate_memory(sizeof(*entry));
+  entry->function = function;
+  entry->dimension = dimension;
+  entry->instance = instance;
+  entry->problem = problem;
+  entry->number_of_references = 1;
+  entry->previous = NULL;
+  entry->next = NULL;
+#if defined(HAVE_THREADS)
+  coco_mutex_initialize(&entry->mutex);
+#endif
+  return entry;
+}
+
+/**
+ * Drops one reference to the ${entry} and frees it together with its problem if it was the last one.
+ */
+static void coco_problem_cache_entry_release(coco_problem_cache_entry_t *entry) {
+  size_t number_of_references;
+
+  coco_problem_cache_entry_lock(entry);
+  assert(entry->number_of_references > 0);
+  number_of_references = --entry->number_of_references;
+  coco_problem_cache_entry_unlock(entry);
+  if (number_of_references == 0) {
+#if defined(HAVE_THREADS)
+    coco_mutex_finalize(&entry->mutex);
+#endif
+    coco_problem_free(entry->problem);
+    coco_free_memory(entry);
+  }
+}
+
+static void coco_problem_cache_unlink(coco_problem_cache_t *cache, coco_problem_cache_entry_t *entry) {
+  if (entry->previous != NULL)
+    entry->previous->next = entry->next;
+  else
+    cache->first = entry->next;
+  if (entry->next != NULL)
+    entry->next->previous = entry->previous;
+  else
+    cache->last = entry->previous;
+  entry->previous = NULL;
+  entry->next = NULL;
+  cache->number_of_entries--;
+}
+
+static void coco_problem_cache_push_front(coco_problem_cache_t *cache, coco_problem_cache_entry_t *entry) {
+  entry->previous = NULL;
+  entry->next = cache->first;
+  if (cache->first != NULL)
+    cache->first->previous = entry;
+  else
+    cache->last = entry;
+  cache->first = entry;
+  cache->number_of_entries++;
+}
+
+/**
+ * Returns the entry of the problem with the given ${function}, ${dimension} and ${instance} or NULL if the
+ * problem is not in the ${cache}.
+ */
+static coco_problem_cache_entry_t *coco_problem_cache_find(coco_problem_cache_t *cache,
+                                                           const size_t function,
+                                                           const size_t dimension,
+                                                           const size_t instance) {
+  coco_problem_cache_entry_t *entry;
+
+  for (entry = cache->first; entry != NULL; entry = entry->next) {
+    if ((entry->function == function) && (entry->dimension == dimension) && (entry->instance == instance))
+      break;
+  }
+  return entry;
+}
+
+/**
+ * Allocates an empty cache for at most ${capacity} problems.
+ */
+static coco_problem_cache_t *coco_problem_cache_allocate(const size_t capacity) {
+  coco_problem_cache_t *cache;
+
+  assert(capacity > 0);
+  cache = (coco_problem_cache_t *) coco_allocate_memory(sizeof(*cache));
+  cache->capacity = capacity;
+  cache->number_of_entries = 0;
+  cache->first = NULL;
+  cache->last = NULL;
+  cache->number_of_hits = 0;
+  cache->number_of_misses = 0;
+#if defined(HAVE_THREADS)
+  coco_mutex_initialize(&cache->mutex);
+#endif
+  return cache;
+}
+
+/**
+ * Frees the cache. Problems that are still referenced by handles are freed together with their last handle.
+ */
+static void coco_problem_cache_free(coco_problem_cache_t *cache) {
+  coco_problem_cache_entry_t *entry;
+
+  if (cache == NULL)
+    return;
+  while ((entry = cache->first) != NULL) {
+    coco_problem_cache_unlink(cache, entry);
+    coco_problem_cache_entry_release(entry);
+  }
+  coco_debug("coco_problem_cache_free(): %lu hits, %lu misses", cache->number_of_hits, cache->number_of_misses);
+#if defined(HAVE_THREADS)
+  coco_mutex_finalize(&cache->mutex);
+#endif
+  coco_free_memory(cache);
+}
+
+static void coco_problem_cache_handle_evaluate(coco_problem_t *self, const double *x, double *y) {
+  coco_problem_cache_entry_t *entry = (coco_problem_cache_entry_t *) self->data;
+  coco_problem_cache_entry_lock(entry);
+  entry->problem->evaluate_function(entry->problem, x, y);
+  coco_problem_cache_entry_unlock(entry);
+}
+
+static void coco_problem_cache_handle_evaluate_batch(coco_problem_t *self,
+                                                     const double *x,
+                                                     const size_t number_of_points,
+                                                     double *y) {
+  coco_problem_cache_entry_t *entry = (coco_problem_cache_entry_t *) self->data;
+  coco_problem_cache_entry_lock(entry);
+  entry->problem->evaluate_function_batch(entry->problem, x, number_of_points, y);
+  coco_problem_cache_entry_unlock(entry);
+}
+
+static void coco_problem_cache_handle_evaluate_constraint(coco_problem_t *self, const double *x, double *y) {
+  coco_problem_cache_entry_t *entry = (coco_problem_cache_entry_t *) self->data;
+  coco_problem_cache_entry_lock(entry);
+  entry->problem->evaluate_constraint(entry->problem, x, y);
+  coco_problem_cache_entry_unlock(entry);
+}
+
+static void coco_problem_cache_handle_recommend_solutions(coco_problem_t *self,
+                                                          const double *x,
+                                                          size_t number_of_solutions) {
+  coco_problem_cache_entry_t *entry = (coco_problem_cache_entry_t *) self->data;
+  coco_problem_cache_entry_lock(entry);
+  entry->problem->recommend_solutions(entry->problem, x, number_of_solutions);
+  coco_problem_cache_entry_unlock(entry);
+}
+
+static void coco_problem_cache_handle_free(coco_problem_t *self) {
+  coco_problem_cache_entry_release((coco_problem_cache_entry_t *) self->data);
+  self->data = NULL;
+  self->free_problem = NULL;
+  coco_problem_free(self);
+}
+
+/**
+ * Returns a new handle to the problem of ${entry}.
+ */
+static coco_problem_t *coco_problem_cache_handle_allocate(coco_problem_cache_entry_t *entry) {
+  coco_problem_t *problem = entry->problem;
+  coco_problem_t *self;
+
+  self = coco_problem_duplicate(problem);
+  self->evaluations = 0;
+  self->evaluate_function = coco_problem_cache_handle_evaluate;
+  self->evaluate_function_batch = NULL;
+  if (problem->evaluate_function_batch != NULL)
+    self->evaluate_function_batch = coco_problem_cache_handle_evaluate_batch;
+  self->transform_variables = NULL;
+  self->transform_objectives = NULL;
+  self->evaluate_constraint = NULL;
+  if (problem->evaluate_constraint != NULL)
+    self->evaluate_constraint = coco_problem_cache_handle_evaluate_constraint;
+  self->recommend_solutions = NULL;
+  if (problem->recommend_solutions != NULL)
+    self->recommend_solutions = coco_problem_cache_handle_recommend_solutions;
+  self->free_problem = coco_problem_cache_handle_free;
+  self->data = entry;
+  coco_problem_cache_entry_lock(entry);
+  entry->number_of_references++;
+  coco_problem_cache_entry_unlock(entry);
+  return self;
+}
+
+/**
+ * Returns the problem with the given ${function}, ${dimension} and ${instance}. If ${cache} is NULL, the
+ * problem is simply constructed by ${constructor}. Otherwise a handle to the cached problem is returned,
+ * constructing and caching the problem first (and evicting the least recently used one if the cache is
+ * full) if it is not in the cache yet. In both cases the caller owns the returned problem.
+ *
+ * The problem is constructed without holding the lock of the cache, so that other threads can use the
+ * cache meanwhile. If another thread has cached the same problem in the meantime, its problem is used.
+ */
+static coco_problem_t *coco_problem_cache_get(coco_problem_cache_t *cache,
+                                              const size_t function,
+                                              const size_t dimension,
+                                              const size_t instance,
+                                              coco_problem_cache_constructor_t constructor) {
+  coco_problem_cache_entry_t *entry, *evicted = NULL, *constructed = NULL;
+  coco_problem_t *handle;
+
+  if (cache == NULL)
+    return constructor(function, dimension, instance);
+
+  coco_problem_cache_lock(cache);
+  entry = coco_problem_cache_find(cache, function, dimension, instance);
+  if (entry == NULL) {
+    coco_problem_cache_unlock(cache);
+    constructed = coco_problem_cache_entry_allocate(function, dimension, instance,
+        constructor(function, dimension, instance));
+    coco_problem_cache_lock(cache);
+    entry = coco_problem_cache_find(cache, function, dimension, instance);
+  }
+
+  if (entry != NULL) {
+    cache->number_of_hits++;
+    coco_problem_cache_unlink(cache, entry);
+  } else {
+    cache->number_of_misses++;
+    entry = constructed;
+    constructed = NULL;
+    if (cache->number_of_entries == cache->capacity) {
+      evicted = cache->last;
+      coco_problem_cache_unlink(cache, evicted);
+    }
+  }
+  coco_problem_cache_push_front(cache, entry);
+  handle = coco_problem_cache_handle_allocate(entry);
+  coco_problem_cache_unlock(cache);
+
+  /* Problems are freed outside of the lock */
+  if (evicted != NULL)
+    coco_problem_cache_entry_release(evicted);
+  if (constructed != NULL)
+    coco_problem_cache_entry_release(constructed);
+  return handle;
+}
@@ -1,4 +1,5 @@
 #include <math.h>
+#include <string.h>
 
 #include "coco.h"
 
@@ -19,24 +20,33 @@ struct coco_random_state {
  * reasonably small and directly generates double values. The chosen
  * lags (607 and 273) lead to a generator with a period in excess of
  * 2^607-1.
+ *
+ * The wrap around 1.0 is written without a branch, which is
+ * unpredictable, and lets both loops be vectorized (the lags are far
+ * apart enough), for example by GCC with -fno-trapping-math.
  */
 static void coco_random_generate(coco_random_state_t *state) {
   size_t i;
   for (i = 0; i < SHORT_LAG; ++i) {
-    double t = state->x[i] + state->x[i + (LONG_LAG - SHORT_LAG)];
-    if (t >= 1.0)
-      t -= 1.0;
-    state->x[i] = t;
+    const double t = state->x[i] + state->x[i + (LONG_LAG - SHORT_LAG)];
+    state->x[i] = t - (double) (t >= 1.0);
   }
   for (i = SHORT_LAG; i < LONG_LAG; ++i) {
-    double t = state->x[i] + state->x[i - SHORT_LAG];
-    if (t >= 1.0)
-      t -= 1.0;
-    state->x[i] = t;
+    const double t = state->x[i] + state->x[i - SHORT_LAG];
+    state->x[i] = t - (double) (t >= 1.0);
   }
   state->index = 0;
 }
 
+/**
+ * Scrambles the bits of ${z} (the finalizer of the SplitMix64 generator).
+ */
+static uint64_t coco_random_mix(uint64_t z) {
+  z = (z ^ (z >> 30)) * ((((uint64_t) 0xBF58476DUL) << 32) | 0x1CE4E5B9UL);
+  z = (z ^ (z >> 27)) * ((((uint64_t) 0x94D049BBUL) << 32) | 0x133111EBUL);
+  return z ^ (z >> 31);
+}
+
 coco_random_state_t *coco_random_new(uint32_t seed) {
   coco_random_state_t *state = (coco_random_state_t *) coco_allocate_memory(sizeof(coco_random_state_t));
   size_t i;
@@ -51,6 +61,22 @@ coco_random_state_t *coco_random_new(uint32_t seed) {
   return state;
 }
 
+coco_random_state_t *coco_random_new_substream(uint32_t seed, uint32_t substream) {
+  coco_random_state_t *state = (coco_random_state_t *) coco_allocate_memory(sizeof(coco_random_state_t));
+  const uint64_t increment = (((uint64_t) 0x9E3779B9UL) << 32) | 0x7F4A7C15UL;
+  uint64_t z;
+  size_t i;
+  /* Fill the initial state array with the SplitMix64 sequence that starts from the scrambled
+   * (seed, substream) pair, using the upper 53 bits of each value. */
+  z = coco_random_mix((((uint64_t) seed) << 32) | substream);
+  for (i = 0; i < LONG_LAG; ++i) {
+    z += increment;
+    state->x[i] = (double) (coco_random_mix(z) >> 11) / 9007199254740992.0;
+  }
+  state->index = 0;
+  return state;
+}
+
 void coco_random_free(coco_random_state_t *state) {
   coco_free_memory(state);
 }
@@ -65,6 +91,20 @@ double coco_random_uniform(coco_random_state_t *state) {
   return state->x[state->index++];
 }
 
+void coco_random_uniform_fill(coco_random_state_t *state, double *values, const size_t number_of_values) {
+  size_t i, count;
+  /* Copy the state array in blocks, refilling it as in coco_random_uniform() */
+  for (i = 0; i < number_of_values; i += count) {
+    if (state->index >= LONG_LAG)
+      coco_random_generate(state);
+    count = LONG_LAG - state->index;
+    if (count > number_of_values - i)
+      count = number_of_values - i;
+    memcpy(values + i, state->x + state->index, count * sizeof(double));
+    state->index += count;
+  }
+}
+
 double coco_random_normal(coco_random_state_t *state) {
   double normal;
 #ifdef COCO_NORMAL_POLAR
@@ -82,6 +122,23 @@ double coco_random_normal(coco_random_state_t *state) {
   return normal;
 }
 
+void coco_random_normal_fill(coco_random_state_t *state, double *values, const size_t number_of_values) {
+  double u, v, s, factor;
+  size_t i = 0;
+  /* Marsaglia's polar method, which turns each accepted pair of uniform values into a pair of normal values */
+  while (i < number_of_values) {
+    do {
+      u = 2.0 * coco_random_uniform(state) - 1.0;
+      v = 2.0 * coco_random_uniform(state) - 1.0;
+      s = u * u + v * v;
+    } while ((s >= 1.0) || (s == 0.0));
+    factor = sqrt(-2.0 * log(s) / s);
+    values[i++] = u * factor;
+    if (i < number_of_values)
+      values[i++] = v * factor;
+  }
+}
+
 /* Be hygienic (for amalgamation) and undef lags. */
 #undef SHORT_LAG
 #undef LONG_LAG
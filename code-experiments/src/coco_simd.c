@@ -0,0 +1,291 @@
+/*
+ * Kernels shared by the raw functions of the separable bbob functions (sums of squares and the sum of
+ * cosines of Rastrigin).
+ *
+ * By default, the kernels are plain loops that compute exactly what the raw functions computed before, in
+ * the same order. When COCO is compiled with COCO_SIMD (see coco_platform.h), the kernels use SSE2, AVX2 or
+ * AVX-512F, whichever is the best one supported by the CPU at runtime. The SIMD kernels sum in a different
+ * order and compute the cosine with their own polynomial, so that the values differ by rounding (the
+ * relative difference is of the order of 1e-15) from the default ones.
+ */
+#include "coco_platform.h"
+
+#include <math.h>
+
+#include "coco.h"
+
+#if defined(HAVE_SIMD_X86)
+#include <immintrin.h>
+
+/**
+ * The smallest number of values for which the SIMD kernels are used.
+ */
+#define COCO_SIMD_MIN_VALUES 8
+
+/* The Taylor coefficients of cos(a) and sin(a) / a in a^2, accurate to the last bit on [-pi/4, pi/4] */
+static const double coco_simd_cos_coefficients[9] = { 1.0, -1.0 / 2.0, 1.0 / 24.0, -1.0 / 720.0,
+    1.0 / 40320.0, -1.0 / 3628800.0, 1.0 / 479001600.0, -1.0 / 87178291200.0, 1.0 / 20922789888000.0 };
+static const double coco_simd_sin_coefficients[9] = { 1.0, -1.0 / 6.0, 1.0 / 120.0, -1.0 / 5040.0,
+    1.0 / 362880.0, -1.0 / 39916800.0, 1.0 / 6227020800.0, -1.0 / 1307674368000.0, 1.0 / 355687428096000.0 };
+
+/*
+ * SSE2 (always available on x86-64)
+ */
+
+static double coco_simd_add_squares_sse2(const double *x, const double *weights, const double factor,
+                                         const size_t number_of_values, size_t *number_done) {
+  __m128d sum = _mm_setzero_pd();
+  const __m128d vector_factor = _mm_set1_pd(factor);
+  double sums[2];
+  size_t i;
+
+  for (i = 0; i + 2 <= number_of_values; i += 2) {
+    const __m128d xi = _mm_loadu_pd(x + i);
+    const __m128d wi = (weights == NULL) ? vector_factor : _mm_loadu_pd(weights + i);
+    sum = _mm_add_pd(sum, _mm_mul_pd(_mm_mul_pd(wi, xi), xi));
+  }
+  _mm_storeu_pd(sums, sum);
+  *number_done = i;
+  return sums[0] + sums[1];
+}
+
+/**
+ * Returns cos(2 pi x) for the two values of ${x}, which must be smaller than 2^50 in absolute value.
+ */
+static __m128d coco_simd_cos_two_pi_sse2(const __m128d x) {
+  const __m128d rounding = _mm_set1_pd(6755399441055744.0); /* 1.5 * 2^52 rounds to integers */
+  const __m128d one = _mm_set1_pd(1.0);
+  const __m128d sign = _mm_set1_pd(-0.0);
+  __m128d r, q, a, a2, c, s, absolute_q, is_odd;
+  int k;
+
+  /* cos(2 pi x) = cos(2 pi r + q pi / 2), with r in [-1/8, 1/8] */
+  r = _mm_sub_pd(x, _mm_sub_pd(_mm_add_pd(x, rounding), rounding));
+  q = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(r, _mm_set1_pd(4.0)), rounding), rounding);
+  r = _mm_sub_pd(r, _mm_mul_pd(q, _mm_set1_pd(0.25)));
+  a = _mm_mul_pd(r, _mm_set1_pd(coco_two_pi));
+  a2 = _mm_mul_pd(a, a);
+  c = _mm_set1_pd(coco_simd_cos_coefficients[8]);
+  s = _mm_set1_pd(coco_simd_sin_coefficients[8]);
+  for (k = 7; k >= 0; k--) {
+    c = _mm_add_pd(_mm_mul_pd(c, a2), _mm_set1_pd(coco_simd_cos_coefficients[k]));
+    s = _mm_add_pd(_mm_mul_pd(s, a2), _mm_set1_pd(coco_simd_sin_coefficients[k]));
+  }
+  s = _mm_mul_pd(s, a);
+
+  /* q is -2, -1, 0, 1 or 2: the result is c (1 - |q|) for even q and -q s for odd q */
+  absolute_q = _mm_andnot_pd(sign, q);
+  is_odd = _mm_cmpeq_pd(absolute_q, one);
+  return _mm_or_pd(_mm_and_pd(is_odd, _mm_mul_pd(_mm_xor_pd(q, sign), s)),
+      _mm_andnot_pd(is_odd, _mm_mul_pd(c, _mm_sub_pd(one, absolute_q))));
+}
+
+static double coco_simd_sum_of_cosines_sse2(const double *x, const size_t number_of_values, size_t *number_done) {
+  const __m128d limit = _mm_set1_pd(1125899906842624.0); /* 2^50 */
+  const __m128d sign = _mm_set1_pd(-0.0);
+  __m128d sum = _mm_setzero_pd();
+  double sums[2];
+  size_t i;
+
+  for (i = 0; i + 2 <= number_of_values; i += 2) {
+    const __m128d xi = _mm_loadu_pd(x + i);
+    if (_mm_movemask_pd(_mm_cmpge_pd(_mm_andnot_pd(sign, xi), limit)) != 0)
+      break; /* Left to the scalar loop */
+    sum = _mm_add_pd(sum, coco_simd_cos_two_pi_sse2(xi));
+  }
+  _mm_storeu_pd(sums, sum);
+  *number_done = i;
+  return sums[0] + sums[1];
+}
+
+/*
+ * AVX2
+ */
+
+__attribute__((target("avx2")))
+static double coco_simd_add_squares_avx2(const double *x, const double *weights, const double factor,
+                                         const size_t number_of_values, size_t *number_done) {
+  __m256d sum = _mm256_setzero_pd();
+  const __m256d vector_factor = _mm256_set1_pd(factor);
+  double sums[4];
+  size_t i;
+
+  for (i = 0; i + 4 <= number_of_values; i += 4) {
+    const __m256d xi = _mm256_loadu_pd(x + i);
+    const __m256d wi = (weights == NULL) ? vector_factor : _mm256_loadu_pd(weights + i);
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_mul_pd(wi, xi), xi));
+  }
+  _mm256_storeu_pd(sums, sum);
+  *number_done = i;
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+__attribute__((target("avx2")))
+static double coco_simd_sum_of_cosines_avx2(const double *x, const size_t number_of_values, size_t *number_done) {
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  __m256d sum = _mm256_setzero_pd();
+  __m256d r, q, a, a2, c, s, absolute_q, is_odd;
+  double sums[4];
+  size_t i;
+  int k;
+
+  for (i = 0; i + 4 <= number_of_values; i += 4) {
+    const __m256d xi = _mm256_loadu_pd(x + i);
+    r = _mm256_sub_pd(xi, _mm256_round_pd(xi, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    q = _mm256_round_pd(_mm256_mul_pd(r, _mm256_set1_pd(4.0)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    r = _mm256_sub_pd(r, _mm256_mul_pd(q, _mm256_set1_pd(0.25)));
+    a = _mm256_mul_pd(r, _mm256_set1_pd(coco_two_pi));
+    a2 = _mm256_mul_pd(a, a);
+    c = _mm256_set1_pd(coco_simd_cos_coefficients[8]);
+    s = _mm256_set1_pd(coco_simd_sin_coefficients[8]);
+    for (k = 7; k >= 0; k--) {
+      c = _mm256_add_pd(_mm256_mul_pd(c, a2), _mm256_set1_pd(coco_simd_cos_coefficients[k]));
+      s = _mm256_add_pd(_mm256_mul_pd(s, a2), _mm256_set1_pd(coco_simd_sin_coefficients[k]));
+    }
+    s = _mm256_mul_pd(s, a);
+    absolute_q = _mm256_andnot_pd(sign, q);
+    is_odd = _mm256_cmp_pd(absolute_q, one, _CMP_EQ_OQ);
+    sum = _mm256_add_pd(sum, _mm256_blendv_pd(_mm256_mul_pd(c, _mm256_sub_pd(one, absolute_q)),
+        _mm256_mul_pd(_mm256_xor_pd(q, sign), s), is_odd));
+  }
+  _mm256_storeu_pd(sums, sum);
+  *number_done = i;
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+/*
+ * AVX-512F
+ */
+
+__attribute__((target("avx512f")))
+static double coco_simd_add_squares_avx512(const double *x, const double *weights, const double factor,
+                                           const size_t number_of_values, size_t *number_done) {
+  __m512d sum = _mm512_setzero_pd();
+  const __m512d vector_factor = _mm512_set1_pd(factor);
+  size_t i;
+
+  for (i = 0; i + 8 <= number_of_values; i += 8) {
+    const __m512d xi = _mm512_loadu_pd(x + i);
+    const __m512d wi = (weights == NULL) ? vector_factor : _mm512_loadu_pd(weights + i);
+    sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_mul_pd(wi, xi), xi));
+  }
+  *number_done = i;
+  return _mm512_reduce_add_pd(sum);
+}
+
+__attribute__((target("avx512f")))
+static double coco_simd_sum_of_cosines_avx512(const double *x, const size_t number_of_values,
+                                              size_t *number_done) {
+  const __m512d rounding = _mm512_set1_pd(6755399441055744.0);
+  const __m512d limit = _mm512_set1_pd(1125899906842624.0);
+  const __m512d one = _mm512_set1_pd(1.0);
+  __m512d sum = _mm512_setzero_pd();
+  __m512d r, q, a, a2, c, s, absolute_q;
+  __mmask8 is_odd;
+  size_t i;
+  int k;
+
+  for (i = 0; i + 8 <= number_of_values; i += 8) {
+    const __m512d xi = _mm512_loadu_pd(x + i);
+    if (_mm512_cmp_pd_mask(_mm512_abs_pd(xi), limit, _CMP_GE_OQ) != 0)
+      break; /* Left to the scalar loop */
+    r = _mm512_sub_pd(xi, _mm512_sub_pd(_mm512_add_pd(xi, rounding), rounding));
+    q = _mm512_sub_pd(_mm512_add_pd(_mm512_mul_pd(r, _mm512_set1_pd(4.0)), rounding), rounding);
+    r = _mm512_sub_pd(r, _mm512_mul_pd(q, _mm512_set1_pd(0.25)));
+    a = _mm512_mul_pd(r, _mm512_set1_pd(coco_two_pi));
+    a2 = _mm512_mul_pd(a, a);
+    c = _mm512_set1_pd(coco_simd_cos_coefficients[8]);
+    s = _mm512_set1_pd(coco_simd_sin_coefficients[8]);
+    for (k = 7; k >= 0; k--) {
+      c = _mm512_add_pd(_mm512_mul_pd(c, a2), _mm512_set1_pd(coco_simd_cos_coefficients[k]));
+      s = _mm512_add_pd(_mm512_mul_pd(s, a2), _mm512_set1_pd(coco_simd_sin_coefficients[k]));
+    }
+    s = _mm512_mul_pd(s, a);
+    absolute_q = _mm512_abs_pd(q);
+    is_odd = _mm512_cmp_pd_mask(absolute_q, one, _CMP_EQ_OQ);
+    sum = _mm512_add_pd(sum, _mm512_mask_blend_pd(is_odd, _mm512_mul_pd(c, _mm512_sub_pd(one, absolute_q)),
+        _mm512_sub_pd(_mm512_setzero_pd(), _mm512_mul_pd(q, s))));
+  }
+  *number_done = i;
+  return _mm512_reduce_add_pd(sum);
+}
+
+/**
+ * Returns the sum of the (weights_i or factor) * x_i * x_i over the first values, computed by the best
+ * kernel supported by the CPU, and stores the number of values done in ${number_done}.
+ */
+static double coco_simd_add_squares(const double *x, const double *weights, const double factor,
+                                    const size_t number_of_values, size_t *number_done) {
+  if (__builtin_cpu_supports("avx512f"))
+    return coco_simd_add_squares_avx512(x, weights, factor, number_of_values, number_done);
+  if (__builtin_cpu_supports("avx2"))
+    return coco_simd_add_squares_avx2(x, weights, factor, number_of_values, number_done);
+  return coco_simd_add_squares_sse2(x, weights, factor, number_of_values, number_done);
+}
+
+/**
+ * Returns the sum of cos(2 pi x_i) over the first values, computed by the best kernel supported by the CPU,
+ * and stores the number of values done in ${number_done}.
+ */
+static double coco_simd_sum_of_cosines(const double *x, const size_t number_of_values, size_t *number_done) {
+  if (__builtin_cpu_supports("avx512f"))
+    return coco_simd_sum_of_cosines_avx512(x, number_of_values, number_done);
+  if (__builtin_cpu_supports("avx2"))
+    return coco_simd_sum_of_cosines_avx2(x, number_of_values, number_done);
+  return coco_simd_sum_of_cosines_sse2(x, number_of_values, number_done);
+}
+
+#endif
+
+/**
+ * Returns ${sum} + factor * x_0 * x_0 + ... + factor * x_{n-1} * x_{n-1} for the ${number_of_values}
+ * values in ${x}, added from left to right (unless COCO_SIMD is defined).
+ */
+static double coco_vector_add_squares(double sum, const double *x, const double factor,
+                                      const size_t number_of_values) {
+  size_t i = 0;
+#if defined(HAVE_SIMD_X86)
+  if (number_of_values >= COCO_SIMD_MIN_VALUES)
+    sum += coco_simd_add_squares(x, NULL, factor, number_of_values, &i);
+#endif
+  for (; i < number_of_values; ++i) {
+    sum += factor * x[i] * x[i];
+  }
+  return sum;
+}
+
+/**
+ * Returns ${sum} + weights_0 * x_0 * x_0 + ... + weights_{n-1} * x_{n-1} * x_{n-1} for the
+ * ${number_of_values} values in ${x} and ${weights}, added from left to right (unless COCO_SIMD is
+ * defined).
+ */
+static double coco_vector_add_weighted_squares(double sum, const double *x, const double *weights,
+                                               const size_t number_of_values) {
+  size_t i = 0;
+#if defined(HAVE_SIMD_X86)
+  if (number_of_values >= COCO_SIMD_MIN_VALUES)
+    sum += coco_simd_add_squares(x, weights, 0.0, number_of_values, &i);
+#endif
+  for (; i < number_of_values; ++i) {
+    sum += weights[i] * x[i] * x[i];
+  }
+  return sum;
+}
+
+/**
+ * Returns cos(2 pi x_0) + ... + cos(2 pi x_{n-1}) for the ${number_of_values} values in ${x}, added from
+ * left to right (unless COCO_SIMD is defined).
+ */
+static double coco_vector_sum_of_cosines(const double *x, const size_t number_of_values) {
+  double sum = 0.0;
+  size_t i = 0;
+#if defined(HAVE_SIMD_X86)
+  if (number_of_values >= COCO_SIMD_MIN_VALUES)
+    sum += coco_simd_sum_of_cosines(x, number_of_values, &i);
+#endif
+  for (; i < number_of_values; ++i) {
+    sum += cos(coco_two_pi * x[i]);
+  }
+  return sum;
+}
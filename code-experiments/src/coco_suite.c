@@ -4,6 +4,7 @@
 #include "suite_bbob.c"
 #include "suite_biobj.c"
 #include "suite_toy.c"
+#include "coco_suite_parallel.c"
 
 /**
  * TODO: Add instructions on how to implement a new suite!
@@ -51,6 +52,11 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name,
   suite->data = NULL;
   suite->data_free_function = NULL;
 
+  /* To be set in coco_suite() if needed */
+  suite->problem_cache = NULL;
+  suite->is_in_batch = NULL;
+  suite->evaluation_threads = 1;
+
   return suite;
 }
 
@@ -110,6 +116,105 @@ static void coco_suite_filter_dimensions(coco_suite_t *suite, const size_t *dims
 
 }
 
+/**
+ * The problems of a function and a dimension of the suite and their estimated cost, used to distribute the
+ * problems among batches
+ */
+typedef struct {
+  size_t function_idx;
+  size_t dimension_idx;
+  size_t cost;
+} coco_suite_batch_group_t;
+
+/**
+ * Defines the ordering of groups by decreasing cost and increasing index of their first problem (for
+ * qsort()).
+ */
+static int coco_suite_compare_batch_groups(const void *a, const void *b) {
+
+  const coco_suite_batch_group_t *group1 = (const coco_suite_batch_group_t *) a;
+  const coco_suite_batch_group_t *group2 = (const coco_suite_batch_group_t *) b;
+
+  if (group1->cost > group2->cost)
+    return -1;
+  else if (group1->cost < group2->cost)
+    return 1;
+  else if (group1->dimension_idx < group2->dimension_idx)
+    return -1;
+  else if (group1->dimension_idx > group2->dimension_idx)
+    return 1;
+  else if (group1->function_idx < group2->function_idx)
+    return -1;
+  else if (group1->function_idx > group2->function_idx)
+    return 1;
+  return 0;
+}
+
+/**
+ * Keeps only the problems of the given batch (from 1 to number_of_batches) when the problems of the suite
+ * (those not filtered out by the other suite options) are distributed among number_of_batches disjoint
+ * batches of similar cost. All instances of a function in a dimension go to the same batch, because the
+ * observers write them to the same data files (so that the batches can be merged, see
+ * code-experiments/tools/merge_results.py). The cost of a problem is estimated by the square of its
+ * dimension, because budgets are usually proportional to the dimension and so is (at least) the cost of an
+ * evaluation. The groups of problems are assigned by decreasing cost to the batch with the lowest cost so
+ * far (the first one in case of ties), so that the batches only depend on the suite and its options.
+ */
+static void coco_suite_set_batch(coco_suite_t *suite, const size_t batch, const size_t number_of_batches) {
+
+  const size_t number_of_problems = coco_suite_get_number_of_problems(suite);
+  coco_suite_batch_group_t *groups;
+  size_t *batch_costs;
+  size_t function_idx, dimension_idx, instance_idx;
+  size_t number_of_instances = 0, index, count = 0, i, j;
+
+  assert((batch >= 1) && (batch <= number_of_batches));
+
+  for (instance_idx = 0; instance_idx < suite->number_of_instances; instance_idx++) {
+    if (suite->instances[instance_idx] != 0)
+      number_of_instances++;
+  }
+  groups = (coco_suite_batch_group_t *) coco_allocate_memory(
+      suite->number_of_functions * suite->number_of_dimensions * sizeof(*groups));
+  for (dimension_idx = 0; dimension_idx < suite->number_of_dimensions; dimension_idx++) {
+    for (function_idx = 0; function_idx < suite->number_of_functions; function_idx++) {
+      if ((suite->functions[function_idx] == 0) || (suite->dimensions[dimension_idx] == 0))
+        continue;
+      groups[count].function_idx = function_idx;
+      groups[count].dimension_idx = dimension_idx;
+      groups[count].cost = number_of_instances * suite->dimensions[dimension_idx] * suite->dimensions[dimension_idx];
+      count++;
+    }
+  }
+  qsort(groups, count, sizeof(*groups), coco_suite_compare_batch_groups);
+
+  batch_costs = (size_t *) coco_allocate_memory(number_of_batches * sizeof(size_t));
+  for (j = 0; j < number_of_batches; j++)
+    batch_costs[j] = 0;
+  suite->is_in_batch = (unsigned char *) coco_allocate_memory(number_of_problems * sizeof(unsigned char));
+  for (index = 0; index < number_of_problems; index++)
+    suite->is_in_batch[index] = 0;
+
+  for (i = 0; i < count; i++) {
+    j = 0;
+    for (index = 1; index < number_of_batches; index++) {
+      if (batch_costs[index] < batch_costs[j])
+        j = index;
+    }
+    batch_costs[j] += groups[i].cost;
+    if (j != batch - 1)
+      continue;
+    for (instance_idx = 0; instance_idx < suite->number_of_instances; instance_idx++) {
+      if (suite->instances[instance_idx] != 0)
+        suite->is_in_batch[coco_suite_encode_problem_index(suite, groups[i].function_idx,
+            groups[i].dimension_idx, instance_idx)] = 1;
+    }
+  }
+
+  coco_free_memory(batch_costs);
+  coco_free_memory(groups);
+}
+
 size_t coco_suite_get_function_from_function_index(coco_suite_t *suite, size_t function_idx) {
 
   if (function_idx >= suite->number_of_functions) {
@@ -170,6 +275,16 @@ void coco_suite_free(coco_suite_t *suite) {
       suite->current_problem = NULL;
     }
 
+    if (suite->problem_cache) {
+      coco_problem_cache_free(suite->problem_cache);
+      suite->problem_cache = NULL;
+    }
+
+    if (suite->is_in_batch) {
+      coco_free_memory(suite->is_in_batch);
+      suite->is_in_batch = NULL;
+    }
+
     if (suite->data != NULL) {
       if (suite->data_free_function != NULL) {
         suite->data_free_function(suite->data);
@@ -234,6 +349,7 @@ static coco_problem_t *coco_suite_get_problem_from_indices(coco_suite_t *suite,
     coco_error("coco_suite_get_problem(): unknown problem suite");
     return NULL;
   }
+  problem->evaluation_threads = suite->evaluation_threads;
 
   return problem;
 }
@@ -250,6 +366,45 @@ size_t coco_suite_get_number_of_problems(coco_suite_t *suite) {
   return (suite->number_of_instances * suite->number_of_functions * suite->number_of_dimensions);
 }
 
+int coco_suite_get_problem_metadata(coco_suite_t *suite,
+                                    const size_t problem_index,
+                                    char **problem_id,
+                                    char **problem_name,
+                                    size_t *dimension,
+                                    size_t *number_of_objectives) {
+
+  size_t function_idx = 0, instance_idx = 0, dimension_idx = 0;
+  coco_problem_t *problem;
+
+  if (problem_index >= coco_suite_get_number_of_problems(suite))
+    return 0;
+
+  coco_suite_decode_problem_index(suite, problem_index, &function_idx, &dimension_idx, &instance_idx);
+  if ((suite->functions[function_idx] == 0) || (suite->dimensions[dimension_idx] == 0)
+      || (suite->instances[instance_idx] == 0))
+    return 0;
+  if ((suite->is_in_batch != NULL) && !suite->is_in_batch[problem_index])
+    return 0;
+
+  *dimension = suite->dimensions[dimension_idx];
+  if (strcmp(suite->suite_name, "bbob") == 0) {
+    suite_bbob_get_problem_metadata(suite, function_idx, dimension_idx, instance_idx, problem_id, problem_name,
+        number_of_objectives);
+  } else if (strcmp(suite->suite_name, "bbob-biobj") == 0) {
+    suite_biobj_get_problem_metadata(suite, function_idx, dimension_idx, instance_idx, problem_id, problem_name,
+        number_of_objectives);
+  } else {
+    /* Suites whose problems are cheap to construct do not need to know their metadata in advance */
+    problem = coco_suite_get_problem_from_indices(suite, function_idx, dimension_idx, instance_idx);
+    *problem_id = coco_strdup(coco_problem_get_id(problem));
+    *problem_name = coco_strdup(coco_problem_get_name(problem));
+    *number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    coco_problem_free(problem);
+  }
+
+  return 1;
+}
+
 static size_t *coco_suite_get_instance_indices(coco_suite_t *suite, const char *suite_instance) {
 
   int year = -1;
@@ -381,6 +536,8 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
   char *ptr;
   size_t *indices = NULL;
   size_t *dimensions = NULL;
+  size_t problem_cache_size = 0;
+  unsigned long batch = 0, number_of_batches = 0;
   long dim_found, dim_idx_found;
   int parce_dim = 1, parce_dim_idx = 1;
 
@@ -460,6 +617,27 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
       }
     }
     coco_free_memory(option_string);
+
+    if ((coco_options_read_size_t(suite_options, "problem_cache", &problem_cache_size) > 0)
+        && (problem_cache_size > 0)) {
+      suite->problem_cache = coco_problem_cache_allocate(problem_cache_size);
+    }
+
+    if (coco_options_read_size_t(suite_options, "evaluation_threads", &suite->evaluation_threads) > 0) {
+      if (suite->evaluation_threads < 1)
+        suite->evaluation_threads = 1;
+    }
+
+    option_string = coco_allocate_memory(COCO_PATH_MAX * sizeof(char));
+    if (coco_options_read_values(suite_options, "batch", option_string) > 0) {
+      if ((sscanf(option_string, "%lu/%lu", &batch, &number_of_batches) != 2) || (batch < 1)
+          || (batch > number_of_batches)) {
+        coco_error("coco_suite(): 'batch' suite option '%s' is not of the form 'k/n' with 1 <= k <= n",
+            option_string);
+        return NULL; /* Never reached */
+      }
+    }
+    coco_free_memory(option_string);
   }
 
   /* Check that there are enough dimensions, functions and instances left */
@@ -470,6 +648,9 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
     return NULL;
   }
 
+  if (number_of_batches > 0)
+    coco_suite_set_batch(suite, (size_t) batch, (size_t) number_of_batches);
+
   /* Set the starting values of the current indices in such a way, that when the instance_idx is incremented,
    * this results in a valid problem */
   coco_suite_is_next_function_found(suite);
@@ -491,12 +672,16 @@ coco_problem_t *coco_suite_get_next_problem(coco_suite_t *suite, coco_observer_t
   coco_problem_t *problem;
 
   /* Iterate through the suite by instances, then functions and lastly dimensions in search for the next
-   * problem. Note that these functions set the values of suite fields current_instance_idx,
-   * current_function_idx and current_dimension_idx. */
-  if (!coco_suite_is_next_instance_found(suite)
-      && !coco_suite_is_next_function_found(suite)
-      && !coco_suite_is_next_dimension_found(suite))
-    return NULL;
+   * problem (of the batch, if any). Note that these functions set the values of suite fields
+   * current_instance_idx, current_function_idx and current_dimension_idx. */
+  do {
+    if (!coco_suite_is_next_instance_found(suite)
+        && !coco_suite_is_next_function_found(suite)
+        && !coco_suite_is_next_dimension_found(suite))
+      return NULL;
+  } while ((suite->is_in_batch != NULL)
+      && !suite->is_in_batch[coco_suite_encode_problem_index(suite, (size_t) suite->current_function_idx,
+          (size_t) suite->current_dimension_idx, (size_t) suite->current_instance_idx)]);
 
   if (suite->current_problem) {
     coco_problem_free(suite->current_problem);
@@ -0,0 +1,393 @@
+/*
+ * Running a benchmark with several threads, see coco_run_benchmark_parallel().
+ *
+ * Each worker thread constructs its own suite, so that the workers construct their problems concurrently and
+ * without locking, and takes the problems of the suite one after the other. It runs the optimizer on them and
+ * writes all evaluations to a temporary file per problem, in chunks of at most COCO_PARALLEL_CHUNK_SIZE
+ * evaluations. The calling thread replays the recorded evaluations through the observed problems in the
+ * order of the suite (see coco_problem_merge_evaluations()), so that the output of the observer is identical
+ * to the one of coco_run_benchmark(). The chunks of the oldest unfinished problem are replayed while it is
+ * still being optimized, while the evaluations of the problems ahead of it wait in their files.
+ *
+ * The recording therefore keeps only one chunk per thread in memory. To bound the number of the temporary
+ * files, the workers do not start a problem that is more than COCO_PARALLEL_WINDOW_PER_THREAD times the number
+ * of threads ahead of the problem that is replayed. To bound their size, a worker waits before it records a
+ * chunk as long as the recorded bytes that are not yet replayed exceed the limit given to
+ * coco_run_benchmark_parallel(), and a file is rewound whenever all of its chunks have been replayed. The
+ * worker of the problem that is replayed only waits for its own chunks to be replayed, so that the replay always
+ * makes progress.
+ */
+#include <assert.h>
+#include <stdio.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_problem.c"
+#include "coco_thread.c"
+
+#if defined(HAVE_THREADS)
+
+#define COCO_PARALLEL_CHUNK_SIZE 1024
+#define COCO_PARALLEL_WINDOW_PER_THREAD 4
+
+/**
+ * A chunk of evaluations (the buffer of a recorder or of the replaying thread)
+ */
+typedef struct {
+  size_t number_of_evaluations;
+  double *x;
+  double *y;
+} coco_parallel_chunk_t;
+
+/**
+ * The optimization of a problem: the temporary file with its recorded chunks (each one written as the number
+ * of evaluations followed by their x and y), the number of recorded and replayed chunks and whether the
+ * optimization is finished
+ */
+typedef struct {
+  size_t problem_index;
+  FILE *file;
+  coco_mutex_t file_mutex; /* Protects the file and the positions, as chunks are written and read concurrently */
+  long read_position; /* The position of the next chunk to be replayed */
+  long write_position; /* The position of the next chunk to be recorded */
+  size_t number_of_chunks;
+  size_t number_of_replayed_chunks;
+  int is_finished;
+} coco_parallel_task_t;
+
+/**
+ * The state shared by the workers and the replaying thread. All fields except for the constant ones
+ * (suite_name, suite_instance, suite_options, optimizer, tasks[i].problem_index, number_of_tasks and window)
+ * and the files of the tasks (see coco_parallel_task_t) are protected by the mutex.
+ */
+typedef struct {
+  coco_mutex_t mutex;
+  coco_condition_t chunk_recorded; /* Signaled when a chunk is recorded or a task is finished */
+  coco_condition_t chunk_replayed; /* Signaled when a chunk is replayed or the replay moves on to the next task */
+  const char *suite_name; /* The suite from which the workers construct their problems */
+  const char *suite_instance;
+  const char *suite_options;
+  coco_optimizer_t optimizer;
+  coco_parallel_task_t *tasks;
+  size_t number_of_tasks;
+  size_t next_task; /* The next task to be started by a worker */
+  size_t replayed_task; /* The task that is currently replayed */
+  size_t window;
+  size_t max_recorded_bytes; /* The limit of the recorded bytes that are not yet replayed (0 for no limit) */
+  size_t recorded_bytes; /* The recorded bytes that are not yet replayed */
+} coco_parallel_benchmark_t;
+
+/**
+ * Data of the recorder wrapped around the problems optimized by the workers
+ */
+typedef struct {
+  coco_parallel_benchmark_t *benchmark;
+  coco_parallel_task_t *task;
+  coco_parallel_chunk_t chunk; /* The chunk being filled */
+} coco_parallel_recorder_data_t;
+
+static void coco_parallel_chunk_allocate(coco_parallel_chunk_t *chunk, const coco_problem_t *problem) {
+  chunk->number_of_evaluations = 0;
+  chunk->x = coco_allocate_vector(COCO_PARALLEL_CHUNK_SIZE * problem->number_of_variables);
+  chunk->y = coco_allocate_vector(COCO_PARALLEL_CHUNK_SIZE * problem->number_of_objectives);
+}
+
+static void coco_parallel_chunk_free(coco_parallel_chunk_t *chunk) {
+  coco_free_memory(chunk->x);
+  coco_free_memory(chunk->y);
+}
+
+/**
+ * Returns the number of bytes that a chunk of ${number_of_evaluations} evaluations takes in a temporary file.
+ */
+static size_t coco_parallel_chunk_get_size(const size_t number_of_evaluations, const coco_problem_t *problem) {
+  return sizeof(size_t)
+      + number_of_evaluations * (problem->number_of_variables + problem->number_of_objectives) * sizeof(double);
+}
+
+/**
+ * Appends the chunk of the recorder to the file of its task and hands it over to the replaying thread. Waits
+ * first while the recorded bytes that are not yet replayed exceed the limit, unless the task is replayed and
+ * all of its chunks have been replayed.
+ */
+static void coco_parallel_recorder_submit(coco_parallel_recorder_data_t *data, const coco_problem_t *problem) {
+  coco_parallel_benchmark_t *benchmark = data->benchmark;
+  coco_parallel_task_t *task = data->task;
+  coco_parallel_chunk_t *chunk = &data->chunk;
+  size_t number_of_values, number_of_bytes;
+  int is_written;
+
+  number_of_bytes = coco_parallel_chunk_get_size(chunk->number_of_evaluations, problem);
+  coco_mutex_lock(&benchmark->mutex);
+  while ((benchmark->max_recorded_bytes > 0)
+      && (benchmark->recorded_bytes + number_of_bytes > benchmark->max_recorded_bytes)
+      && ((task != &benchmark->tasks[benchmark->replayed_task])
+          || (task->number_of_replayed_chunks < task->number_of_chunks)))
+    coco_condition_wait(&benchmark->chunk_replayed, &benchmark->mutex);
+  benchmark->recorded_bytes += number_of_bytes;
+  coco_mutex_unlock(&benchmark->mutex);
+
+  coco_mutex_lock(&task->file_mutex);
+  number_of_values = chunk->number_of_evaluations * problem->number_of_variables;
+  is_written = (fseek(task->file, task->write_position, SEEK_SET) == 0)
+      && (fwrite(&chunk->number_of_evaluations, sizeof(size_t), 1, task->file) == 1)
+      && (fwrite(chunk->x, sizeof(double), number_of_values, task->file) == number_of_values);
+  number_of_values = chunk->number_of_evaluations * problem->number_of_objectives;
+  is_written = is_written && (fwrite(chunk->y, sizeof(double), number_of_values, task->file) == number_of_values)
+      && (fflush(task->file) == 0);
+  task->write_position = ftell(task->file);
+  coco_mutex_unlock(&task->file_mutex);
+  if (!is_written)
+    coco_error("coco_run_benchmark_parallel(): could not write the evaluations of problem %s to a temporary file"
+        " (is the disk full?)", problem->problem_id);
+  chunk->number_of_evaluations = 0;
+
+  coco_mutex_lock(&benchmark->mutex);
+  task->number_of_chunks++;
+  coco_condition_broadcast(&benchmark->chunk_recorded);
+  coco_mutex_unlock(&benchmark->mutex);
+}
+
+static void coco_parallel_recorder_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  coco_parallel_recorder_data_t *data = (coco_parallel_recorder_data_t *) coco_transformed_get_data(problem);
+  coco_parallel_chunk_t *chunk = &data->chunk;
+  size_t i;
+
+  coco_evaluate_function(coco_transformed_get_inner_problem(problem), x, y);
+
+  for (i = 0; i < problem->number_of_variables; i++)
+    chunk->x[chunk->number_of_evaluations * problem->number_of_variables + i] = x[i];
+  for (i = 0; i < problem->number_of_objectives; i++)
+    chunk->y[chunk->number_of_evaluations * problem->number_of_objectives + i] = y[i];
+  chunk->number_of_evaluations++;
+  if (chunk->number_of_evaluations == COCO_PARALLEL_CHUNK_SIZE)
+    coco_parallel_recorder_submit(data, problem);
+}
+
+static void coco_parallel_recorder_free(void *stuff) {
+  coco_parallel_recorder_data_t *data = (coco_parallel_recorder_data_t *) stuff;
+
+  coco_parallel_chunk_free(&data->chunk);
+}
+
+/**
+ * Runs the optimizer on the problem of the ${task} and records its evaluations.
+ */
+static void coco_parallel_run_task(coco_parallel_benchmark_t *benchmark,
+                                   coco_parallel_task_t *task,
+                                   coco_problem_t *problem) {
+  coco_parallel_recorder_data_t *data;
+
+  task->file = tmpfile();
+  if (task->file == NULL)
+    coco_error("coco_run_benchmark_parallel(): could not create a temporary file for problem %s",
+        problem->problem_id);
+  coco_mutex_initialize(&task->file_mutex);
+
+  data = (coco_parallel_recorder_data_t *) coco_allocate_memory(sizeof(*data));
+  data->benchmark = benchmark;
+  data->task = task;
+  coco_parallel_chunk_allocate(&data->chunk, problem);
+  problem = coco_transformed_allocate(problem, data, coco_parallel_recorder_free);
+  problem->evaluate_function = coco_parallel_recorder_evaluate;
+
+  benchmark->optimizer(problem);
+
+  if (data->chunk.number_of_evaluations > 0)
+    coco_parallel_recorder_submit(data, problem);
+  coco_problem_free(problem);
+
+  coco_mutex_lock(&benchmark->mutex);
+  task->is_finished = 1;
+  coco_condition_broadcast(&benchmark->chunk_recorded);
+  coco_mutex_unlock(&benchmark->mutex);
+}
+
+/**
+ * The worker threads start the next task in the order of the suite, as long as it is within the window.
+ */
+static void coco_parallel_worker(void *argument) {
+  coco_parallel_benchmark_t *benchmark = (coco_parallel_benchmark_t *) argument;
+  coco_parallel_task_t *task;
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+
+  suite = coco_suite(benchmark->suite_name, benchmark->suite_instance, benchmark->suite_options);
+  coco_mutex_lock(&benchmark->mutex);
+  for (;;) {
+    while ((benchmark->next_task < benchmark->number_of_tasks)
+        && (benchmark->next_task >= benchmark->replayed_task + benchmark->window))
+      coco_condition_wait(&benchmark->chunk_replayed, &benchmark->mutex);
+    if (benchmark->next_task == benchmark->number_of_tasks)
+      break;
+    task = &benchmark->tasks[benchmark->next_task++];
+    coco_mutex_unlock(&benchmark->mutex);
+
+    /* The suite (and its problem cache) belongs to the worker */
+    problem = coco_suite_get_problem(suite, task->problem_index);
+    coco_parallel_run_task(benchmark, task, problem);
+
+    coco_mutex_lock(&benchmark->mutex);
+  }
+  coco_mutex_unlock(&benchmark->mutex);
+  coco_suite_free(suite);
+}
+
+/**
+ * Reads the next recorded chunk of the ${task} into the ${chunk}. Rewinds the file if all of its chunks have
+ * been read, so that it does not grow beyond the chunks that are not yet replayed.
+ */
+static void coco_parallel_read_chunk(coco_parallel_task_t *task,
+                                     const coco_problem_t *problem,
+                                     coco_parallel_chunk_t *chunk) {
+  size_t number_of_values;
+  int is_read;
+
+  coco_mutex_lock(&task->file_mutex);
+  is_read = (fseek(task->file, task->read_position, SEEK_SET) == 0)
+      && (fread(&chunk->number_of_evaluations, sizeof(size_t), 1, task->file) == 1)
+      && (chunk->number_of_evaluations <= COCO_PARALLEL_CHUNK_SIZE);
+  number_of_values = chunk->number_of_evaluations * problem->number_of_variables;
+  is_read = is_read && (fread(chunk->x, sizeof(double), number_of_values, task->file) == number_of_values);
+  number_of_values = chunk->number_of_evaluations * problem->number_of_objectives;
+  is_read = is_read && (fread(chunk->y, sizeof(double), number_of_values, task->file) == number_of_values);
+  task->read_position = ftell(task->file);
+  if (task->read_position == task->write_position) {
+    task->read_position = 0;
+    task->write_position = 0;
+  }
+  coco_mutex_unlock(&task->file_mutex);
+  if (!is_read)
+    coco_error("coco_run_benchmark_parallel(): could not read the evaluations of problem %s from a temporary file",
+        problem->problem_id);
+}
+
+/**
+ * Replays the recorded evaluations of all tasks in order through the observed problems.
+ */
+static void coco_parallel_replay(coco_parallel_benchmark_t *benchmark,
+                                 coco_suite_t *suite,
+                                 coco_observer_t *observer) {
+  coco_parallel_task_t *task;
+  coco_parallel_chunk_t chunk;
+  coco_problem_t *problem;
+
+  while (benchmark->replayed_task < benchmark->number_of_tasks) {
+    task = &benchmark->tasks[benchmark->replayed_task];
+    problem = coco_suite_get_problem(suite, task->problem_index);
+    problem = coco_problem_add_observer(problem, observer);
+    coco_parallel_chunk_allocate(&chunk, problem);
+
+    coco_mutex_lock(&benchmark->mutex);
+    for (;;) {
+      while ((task->number_of_chunks == task->number_of_replayed_chunks) && !task->is_finished)
+        coco_condition_wait(&benchmark->chunk_recorded, &benchmark->mutex);
+      if (task->number_of_chunks == task->number_of_replayed_chunks)
+        break;
+      coco_mutex_unlock(&benchmark->mutex);
+
+      coco_parallel_read_chunk(task, problem, &chunk);
+      coco_problem_merge_evaluations(problem, chunk.x, chunk.number_of_evaluations, chunk.y);
+
+      coco_mutex_lock(&benchmark->mutex);
+      task->number_of_replayed_chunks++;
+      benchmark->recorded_bytes -= coco_parallel_chunk_get_size(chunk.number_of_evaluations, problem);
+      coco_condition_broadcast(&benchmark->chunk_replayed);
+    }
+    coco_mutex_unlock(&benchmark->mutex);
+
+    /* The worker is done with the file */
+    fclose(task->file);
+    task->file = NULL;
+    coco_mutex_finalize(&task->file_mutex);
+    coco_parallel_chunk_free(&chunk);
+    coco_problem_free(problem);
+
+    coco_mutex_lock(&benchmark->mutex);
+    benchmark->replayed_task++;
+    coco_condition_broadcast(&benchmark->chunk_replayed);
+    coco_mutex_unlock(&benchmark->mutex);
+  }
+}
+
+#endif
+
+void coco_run_benchmark_parallel(const char *suite_name,
+                                 const char *suite_instance,
+                                 const char *suite_options,
+                                 const char *observer_name,
+                                 const char *observer_options,
+                                 coco_optimizer_t optimizer,
+                                 const size_t number_of_threads,
+                                 const size_t max_recorded_bytes) {
+#if defined(HAVE_THREADS)
+  coco_parallel_benchmark_t benchmark;
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_thread_t *threads;
+  char *problem_id, *problem_name;
+  size_t index, dimension, number_of_objectives, i;
+
+  if (number_of_threads <= 1) {
+    coco_run_benchmark(suite_name, suite_instance, suite_options, observer_name, observer_options, optimizer);
+    return;
+  }
+
+  /* The workers construct their problems from suites of their own */
+  benchmark.suite_name = suite_name;
+  benchmark.suite_instance = suite_instance;
+  benchmark.suite_options = suite_options;
+  suite = coco_suite(suite_name, suite_instance, suite_options);
+  observer = coco_observer(observer_name, observer_options);
+
+  benchmark.optimizer = optimizer;
+  benchmark.tasks = (coco_parallel_task_t *) coco_allocate_memory(
+      coco_suite_get_number_of_problems(suite) * sizeof(coco_parallel_task_t));
+  benchmark.number_of_tasks = 0;
+  for (index = 0; index < coco_suite_get_number_of_problems(suite); index++) {
+    if (!coco_suite_get_problem_metadata(suite, index, &problem_id, &problem_name, &dimension,
+        &number_of_objectives))
+      continue;
+    coco_free_memory(problem_id);
+    coco_free_memory(problem_name);
+    benchmark.tasks[benchmark.number_of_tasks].problem_index = index;
+    benchmark.tasks[benchmark.number_of_tasks].file = NULL;
+    benchmark.tasks[benchmark.number_of_tasks].read_position = 0;
+    benchmark.tasks[benchmark.number_of_tasks].write_position = 0;
+    benchmark.tasks[benchmark.number_of_tasks].number_of_chunks = 0;
+    benchmark.tasks[benchmark.number_of_tasks].number_of_replayed_chunks = 0;
+    benchmark.tasks[benchmark.number_of_tasks].is_finished = 0;
+    benchmark.number_of_tasks++;
+  }
+  benchmark.next_task = 0;
+  benchmark.replayed_task = 0;
+  benchmark.window = COCO_PARALLEL_WINDOW_PER_THREAD * number_of_threads;
+  benchmark.max_recorded_bytes = max_recorded_bytes;
+  benchmark.recorded_bytes = 0;
+  coco_mutex_initialize(&benchmark.mutex);
+  coco_condition_initialize(&benchmark.chunk_recorded);
+  coco_condition_initialize(&benchmark.chunk_replayed);
+
+  threads = (coco_thread_t *) coco_allocate_memory(number_of_threads * sizeof(coco_thread_t));
+  for (i = 0; i < number_of_threads; i++)
+    coco_thread_start(&threads[i], coco_parallel_worker, &benchmark);
+
+  coco_parallel_replay(&benchmark, suite, observer);
+
+  for (i = 0; i < number_of_threads; i++)
+    coco_thread_join(threads[i]);
+  coco_free_memory(threads);
+
+  coco_condition_finalize(&benchmark.chunk_replayed);
+  coco_condition_finalize(&benchmark.chunk_recorded);
+  coco_mutex_finalize(&benchmark.mutex);
+  coco_free_memory(benchmark.tasks);
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+#else
+  (void) number_of_threads; /* unused */
+  (void) max_recorded_bytes; /* unused */
+  coco_run_benchmark(suite_name, suite_instance, suite_options, observer_name, observer_options, optimizer);
+#endif
+}
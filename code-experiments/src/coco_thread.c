@@ -0,0 +1,275 @@
+/*
+ * Minimal portable layer over the threads of the platform (POSIX threads or Windows threads), used by the
+ * functions that can distribute their work over several threads.
+ *
+ * The layer is only available when HAVE_THREADS is defined (see coco_platform.h). The Windows version needs
+ * Windows Vista or later (for the condition variables).
+ */
+#include "coco_platform.h"
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+
+#if defined(HAVE_THREADS)
+
+typedef void (*coco_thread_function_t)(void *argument);
+
+#if defined(HAVE_PTHREADS)
+typedef pthread_t coco_thread_t;
+typedef pthread_mutex_t coco_mutex_t;
+typedef pthread_cond_t coco_condition_t;
+#elif defined(HAVE_WINTHREADS)
+typedef HANDLE coco_thread_t;
+typedef CRITICAL_SECTION coco_mutex_t;
+typedef CONDITION_VARIABLE coco_condition_t;
+#endif
+
+/**
+ * The function run by a thread and its argument
+ */
+typedef struct {
+  coco_thread_function_t function;
+  void *argument;
+} coco_thread_start_t;
+
+#if defined(HAVE_PTHREADS)
+static void *coco_thread_run(void *thread_start) {
+#else
+static DWORD WINAPI coco_thread_run(LPVOID thread_start) {
+#endif
+  coco_thread_start_t start = *(coco_thread_start_t *) thread_start;
+
+  coco_free_memory(thread_start);
+  start.function(start.argument);
+#if defined(HAVE_PTHREADS)
+  return NULL;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * Starts a new ${thread} that calls ${function} with the given ${argument}.
+ */
+static void coco_thread_start(coco_thread_t *thread, coco_thread_function_t function, void *argument) {
+  coco_thread_start_t *start;
+
+  start = (coco_thread_start_t *) coco_allocate_memory(sizeof(*start));
+  start->function = function;
+  start->argument = argument;
+#if defined(HAVE_PTHREADS)
+  if (pthread_create(thread, NULL, coco_thread_run, start) != 0)
+    coco_error("coco_thread_start(): failed to start a thread");
+#else
+  *thread = CreateThread(NULL, 0, coco_thread_run, start, 0, NULL);
+  if (*thread == NULL)
+    coco_error("coco_thread_start(): failed to start a thread");
+#endif
+}
+
+/**
+ * Waits until the ${thread} has finished.
+ */
+static void coco_thread_join(coco_thread_t thread) {
+#if defined(HAVE_PTHREADS)
+  pthread_join(thread, NULL);
+#else
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+#endif
+}
+
+static void coco_mutex_initialize(coco_mutex_t *mutex) {
+#if defined(HAVE_PTHREADS)
+  pthread_mutex_init(mutex, NULL);
+#else
+  InitializeCriticalSection(mutex);
+#endif
+}
+
+static void coco_mutex_finalize(coco_mutex_t *mutex) {
+#if defined(HAVE_PTHREADS)
+  pthread_mutex_destroy(mutex);
+#else
+  DeleteCriticalSection(mutex);
+#endif
+}
+
+static void coco_mutex_lock(coco_mutex_t *mutex) {
+#if defined(HAVE_PTHREADS)
+  pthread_mutex_lock(mutex);
+#else
+  EnterCriticalSection(mutex);
+#endif
+}
+
+static void coco_mutex_unlock(coco_mutex_t *mutex) {
+#if defined(HAVE_PTHREADS)
+  pthread_mutex_unlock(mutex);
+#else
+  LeaveCriticalSection(mutex);
+#endif
+}
+
+static void coco_condition_initialize(coco_condition_t *condition) {
+#if defined(HAVE_PTHREADS)
+  pthread_cond_init(condition, NULL);
+#else
+  InitializeConditionVariable(condition);
+#endif
+}
+
+static void coco_condition_finalize(coco_condition_t *condition) {
+#if defined(HAVE_PTHREADS)
+  pthread_cond_destroy(condition);
+#else
+  (void) condition; /* Windows condition variables need not be destroyed */
+#endif
+}
+
+/**
+ * Releases the ${mutex} (which must be locked by the calling thread), waits until the ${condition} is
+ * signaled and locks the ${mutex} again. Like with all condition variables, the wait can also end without
+ * a signal, so the caller needs to check its condition in a loop.
+ */
+static void coco_condition_wait(coco_condition_t *condition, coco_mutex_t *mutex) {
+#if defined(HAVE_PTHREADS)
+  pthread_cond_wait(condition, mutex);
+#else
+  SleepConditionVariableCS(condition, mutex, INFINITE);
+#endif
+}
+
+/**
+ * Wakes up all threads waiting for the ${condition}.
+ */
+static void coco_condition_broadcast(coco_condition_t *condition) {
+#if defined(HAVE_PTHREADS)
+  pthread_cond_broadcast(condition);
+#else
+  WakeAllConditionVariable(condition);
+#endif
+}
+
+/**
+ * A pool of threads that stay alive between the calls of coco_thread_pool_run(), so that work that is
+ * distributed over the threads again and again does not pay for starting them each time. All fields except
+ * for the threads are protected by the mutex.
+ */
+struct coco_thread_pool {
+  coco_thread_t *threads;
+  size_t number_of_threads;
+  coco_mutex_t mutex;
+  coco_condition_t task_available; /* Signaled when tasks are available or the pool is stopped */
+  coco_condition_t tasks_finished; /* Signaled when all tasks are finished */
+  coco_thread_function_t function;
+  char *arguments; /* The argument of the i-th task is at arguments + i * argument_size */
+  size_t argument_size;
+  size_t number_of_tasks;
+  size_t next_task;
+  size_t number_of_finished_tasks;
+  int is_stopped;
+};
+
+/**
+ * Runs the tasks of the ${pool} that are not taken yet (with the mutex of the ${pool} locked by the caller).
+ */
+static void coco_thread_pool_take_tasks(coco_thread_pool_t *pool) {
+  void *argument;
+
+  while (pool->next_task < pool->number_of_tasks) {
+    argument = pool->arguments + pool->next_task * pool->argument_size;
+    pool->next_task++;
+    coco_mutex_unlock(&pool->mutex);
+    pool->function(argument);
+    coco_mutex_lock(&pool->mutex);
+    pool->number_of_finished_tasks++;
+    if (pool->number_of_finished_tasks == pool->number_of_tasks)
+      coco_condition_broadcast(&pool->tasks_finished);
+  }
+}
+
+static void coco_thread_pool_work(void *argument) {
+  coco_thread_pool_t *pool = (coco_thread_pool_t *) argument;
+
+  coco_mutex_lock(&pool->mutex);
+  for (;;) {
+    while ((pool->next_task == pool->number_of_tasks) && !pool->is_stopped)
+      coco_condition_wait(&pool->task_available, &pool->mutex);
+    if (pool->is_stopped)
+      break;
+    coco_thread_pool_take_tasks(pool);
+  }
+  coco_mutex_unlock(&pool->mutex);
+}
+
+/**
+ * Returns a new pool of ${number_of_threads} threads, which wait for the tasks of coco_thread_pool_run().
+ */
+static coco_thread_pool_t *coco_thread_pool_allocate(const size_t number_of_threads) {
+  coco_thread_pool_t *pool;
+  size_t i;
+
+  pool = (coco_thread_pool_t *) coco_allocate_memory(sizeof(*pool));
+  pool->number_of_threads = number_of_threads;
+  coco_mutex_initialize(&pool->mutex);
+  coco_condition_initialize(&pool->task_available);
+  coco_condition_initialize(&pool->tasks_finished);
+  pool->function = NULL;
+  pool->arguments = NULL;
+  pool->argument_size = 0;
+  pool->number_of_tasks = 0;
+  pool->next_task = 0;
+  pool->number_of_finished_tasks = 0;
+  pool->is_stopped = 0;
+  pool->threads = (coco_thread_t *) coco_allocate_memory(number_of_threads * sizeof(coco_thread_t));
+  for (i = 0; i < number_of_threads; i++)
+    coco_thread_start(&pool->threads[i], coco_thread_pool_work, pool);
+  return pool;
+}
+
+/**
+ * Calls ${function} with each of the ${number_of_tasks} arguments of size ${argument_size} stored one after
+ * the other at ${arguments}, using the threads of the ${pool} and the calling thread. Returns when all calls
+ * have returned. The ${pool} must not be used by several threads at the same time.
+ */
+static void coco_thread_pool_run(coco_thread_pool_t *pool,
+                                 coco_thread_function_t function,
+                                 void *arguments,
+                                 const size_t argument_size,
+                                 const size_t number_of_tasks) {
+  coco_mutex_lock(&pool->mutex);
+  pool->function = function;
+  pool->arguments = (char *) arguments;
+  pool->argument_size = argument_size;
+  pool->number_of_tasks = number_of_tasks;
+  pool->next_task = 0;
+  pool->number_of_finished_tasks = 0;
+  coco_condition_broadcast(&pool->task_available);
+  coco_thread_pool_take_tasks(pool);
+  while (pool->number_of_finished_tasks < pool->number_of_tasks)
+    coco_condition_wait(&pool->tasks_finished, &pool->mutex);
+  coco_mutex_unlock(&pool->mutex);
+}
+
+/**
+ * Stops the threads of the ${pool} and frees it.
+ */
+static void coco_thread_pool_free(coco_thread_pool_t *pool) {
+  size_t i;
+
+  coco_mutex_lock(&pool->mutex);
+  pool->is_stopped = 1;
+  coco_condition_broadcast(&pool->task_available);
+  coco_mutex_unlock(&pool->mutex);
+  for (i = 0; i < pool->number_of_threads; i++)
+    coco_thread_join(pool->threads[i]);
+  coco_free_memory(pool->threads);
+  coco_condition_finalize(&pool->tasks_finished);
+  coco_condition_finalize(&pool->task_available);
+  coco_mutex_finalize(&pool->mutex);
+  coco_free_memory(pool);
+}
+
+#endif
@@ -36,6 +36,17 @@ static void f_attractive_sector_evaluate(coco_problem_t *self, const double *x,
   y[0] = f_attractive_sector_raw(x, self->number_of_variables, self->data);
 }
 
+static void f_attractive_sector_evaluate_batch(coco_problem_t *self,
+                                               const double *x,
+                                               const size_t number_of_points,
+                                               double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_attractive_sector_raw(x + i * self->number_of_variables, self->number_of_variables, self->data);
+  }
+}
+
 static void f_attractive_sector_free(coco_problem_t *self) {
   f_attractive_sector_data_t *data;
   data = self->data;
@@ -49,6 +60,7 @@ static coco_problem_t *f_attractive_sector_allocate(const size_t number_of_varia
   f_attractive_sector_data_t *data;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("attractive sector function",
       f_attractive_sector_evaluate, f_attractive_sector_free, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_attractive_sector_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "attractive_sector", number_of_variables);
 
   data = coco_allocate_memory(sizeof(*data));
@@ -71,15 +83,16 @@ static coco_problem_t *f_attractive_sector_bbob_problem_allocate(const size_t fu
   size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double *current_row;
+  coco_matrix_t *rot1, *rot2;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
   /* Compute affine transformation M from two rotation matrices */
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
+  rot2 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
   for (i = 0; i < dimension; ++i) {
@@ -89,12 +102,12 @@ static coco_problem_t *f_attractive_sector_bbob_problem_allocate(const size_t fu
       current_row[j] = 0.0;
       for (k = 0; k < dimension; ++k) {
         double exponent = 1.0 * (int) k / ((double) (long) dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(10.0), exponent) * rot2[k][j];
+        current_row[j] += rot1->data[i * dimension + k] * pow(sqrt(10.0), exponent) * rot2->data[k * dimension + j];
       }
     }
   }
-  bbob2009_free_matrix(rot1, dimension);
-  bbob2009_free_matrix(rot2, dimension);
+  coco_matrix_free(rot1);
+  coco_matrix_free(rot2);
 
   problem = f_attractive_sector_allocate(dimension, xopt);
   problem = f_transform_obj_oscillate(problem);
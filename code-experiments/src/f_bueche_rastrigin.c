@@ -30,10 +30,22 @@ static void f_bueche_rastrigin_evaluate(coco_problem_t *self, const double *x, d
   y[0] = f_bueche_rastrigin_raw(x, self->number_of_variables);
 }
 
+static void f_bueche_rastrigin_evaluate_batch(coco_problem_t *self,
+                                              const double *x,
+                                              const size_t number_of_points,
+                                              double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_bueche_rastrigin_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_bueche_rastrigin_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Bueche-Rastrigin function",
       f_bueche_rastrigin_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_bueche_rastrigin_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "bueche-rastrigin", number_of_variables);
 
   /* Compute best solution */
@@ -28,10 +28,22 @@ static void f_different_powers_evaluate(coco_problem_t *self, const double *x, d
   y[0] = f_different_powers_raw(x, self->number_of_variables);
 }
 
+static void f_different_powers_evaluate_batch(coco_problem_t *self,
+                                              const double *x,
+                                              const size_t number_of_points,
+                                              double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_different_powers_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_different_powers_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("different powers function",
       f_different_powers_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_different_powers_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "different_powers", number_of_variables);
 
   /* Compute best solution */
@@ -51,16 +63,16 @@ static coco_problem_t *f_different_powers_bbob_problem_allocate(const size_t fun
 
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  coco_matrix_t *rot1;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  coco_matrix_free(rot1);
 
   problem = f_different_powers_allocate(dimension);
   problem = f_transform_obj_shift(problem, fopt);
@@ -2,6 +2,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_vars_oscillate.c"
 #include "transform_vars_affine.c"
@@ -11,13 +12,10 @@
 static double f_discus_raw(const double *x, const size_t number_of_variables) {
 
   static const double condition = 1.0e6;
-  size_t i;
   double result;
 
   result = condition * x[0] * x[0];
-  for (i = 1; i < number_of_variables; ++i) {
-    result += x[i] * x[i];
-  }
+  result = coco_vector_add_squares(result, x + 1, 1.0, number_of_variables - 1);
 
   return result;
 }
@@ -27,10 +25,22 @@ static void f_discus_evaluate(coco_problem_t *self, const double *x, double *y)
   y[0] = f_discus_raw(x, self->number_of_variables);
 }
 
+static void f_discus_evaluate_batch(coco_problem_t *self,
+                                    const double *x,
+                                    const size_t number_of_points,
+                                    double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_discus_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_discus_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("discus function",
       f_discus_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_discus_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "discus", number_of_variables);
 
   /* Compute best solution */
@@ -50,16 +60,16 @@ static coco_problem_t *f_discus_bbob_problem_allocate(const size_t function,
 
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  coco_matrix_t *rot1;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  coco_matrix_free(rot1);
 
   problem = f_discus_allocate(dimension);
   problem = f_transform_vars_oscillate(problem);
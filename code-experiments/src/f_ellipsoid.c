@@ -4,37 +4,69 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "transform_vars_oscillate.c"
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
 #include "transform_obj_shift.c"
 
-static double f_ellipsoid_raw(const double *x, const size_t number_of_variables) {
+typedef struct {
+  double *coefficients; /* condition^(i / (D - 1)), computed once in f_ellipsoid_allocate() */
+} f_ellipsoid_data_t;
+
+static double f_ellipsoid_raw(const double *x, const size_t number_of_variables, f_ellipsoid_data_t *data) {
 
-  static const double condition = 1.0e6;
-  size_t i = 0;
   double result;
 
-  result = x[i] * x[i];
-  for (i = 1; i < number_of_variables; ++i) {
-    const double exponent = 1.0 * (double) (long) i / ((double) (long) number_of_variables - 1.0);
-    result += pow(condition, exponent) * x[i] * x[i];
-  }
+  result = x[0] * x[0];
+  result = coco_vector_add_weighted_squares(result, x + 1, data->coefficients + 1, number_of_variables - 1);
 
   return result;
 }
 
 static void f_ellipsoid_evaluate(coco_problem_t *self, const double *x, double *y) {
   assert(self->number_of_objectives == 1);
-  y[0] = f_ellipsoid_raw(x, self->number_of_variables);
+  y[0] = f_ellipsoid_raw(x, self->number_of_variables, self->data);
+}
+
+static void f_ellipsoid_evaluate_batch(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_ellipsoid_raw(x + i * self->number_of_variables, self->number_of_variables, self->data);
+  }
+}
+
+static void f_ellipsoid_free(coco_problem_t *self) {
+  f_ellipsoid_data_t *data;
+  data = self->data;
+  coco_free_memory(data->coefficients);
+  self->free_problem = NULL;
+  coco_problem_free(self);
 }
 
 static coco_problem_t *f_ellipsoid_allocate(const size_t number_of_variables) {
 
+  static const double condition = 1.0e6;
+  size_t i;
+  f_ellipsoid_data_t *data;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("ellipsoid function",
-      f_ellipsoid_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+      f_ellipsoid_evaluate, f_ellipsoid_free, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_ellipsoid_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "ellipsoid", number_of_variables);
 
+  data = coco_allocate_memory(sizeof(*data));
+  data->coefficients = coco_allocate_vector(number_of_variables);
+  data->coefficients[0] = 1.0;
+  for (i = 1; i < number_of_variables; ++i) {
+    const double exponent = 1.0 * (double) (long) i / ((double) (long) number_of_variables - 1.0);
+    data->coefficients[i] = pow(condition, exponent);
+  }
+  problem->data = data;
+
   /* Compute best solution */
   f_ellipsoid_evaluate(problem, problem->best_parameter, problem->best_value);
   return problem;
@@ -77,16 +109,16 @@ static coco_problem_t *f_ellipsoid_rotated_bbob_problem_allocate(const size_t fu
 
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  coco_matrix_t *rot1;
 
   xopt = coco_allocate_vector(dimension);
   bbob2009_compute_xopt(xopt, rseed, dimension);
   fopt = bbob2009_compute_fopt(function, instance);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  coco_matrix_free(rot1);
 
   problem = f_ellipsoid_allocate(dimension);
   problem = f_transform_vars_oscillate(problem);
@@ -7,32 +7,74 @@
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_shift.c"
 
-static double *gallagher_peaks;
-
+/*
+ * The peak data is stored coordinate-major as a structure of arrays: x_local[j * number_of_peaks + i] and
+ * arr_scales[j * number_of_peaks + i] hold coordinate j of peak i. The computation core can then update the
+ * weighted distances to all peaks at once with unit stride while keeping the summation order of each
+ * distance unchanged.
+ */
 typedef struct {
   long rseed;
   size_t number_of_peaks;
   double *xopt;
-  double **rotation, **x_local, **arr_scales;
+  coco_matrix_t *rotation;
+  double *x_local, *arr_scales;
   double *peak_values;
+  double *tmx;       /* scratch: rotated x */
+  double *distances; /* scratch: weighted squared distance to each peak */
   coco_free_function_t old_free_problem;
 } f_gallagher_data_t;
 
 /**
- * Comparison function used for sorting.
+ * Value/index pair used to compute the permutation that sorts an array of random numbers.
+ */
+typedef struct {
+  double value;
+  size_t index;
+} f_gallagher_permutation_t;
+
+/**
+ * Comparison function used for sorting. Ties are broken by index so that the result does not depend on the
+ * qsort implementation.
  */
 static int f_gallagher_compare_doubles(const void *a, const void *b) {
-  double temp = gallagher_peaks[*(const size_t *) a] - gallagher_peaks[*(const size_t *) b];
+  const f_gallagher_permutation_t *pa = (const f_gallagher_permutation_t *) a;
+  const f_gallagher_permutation_t *pb = (const f_gallagher_permutation_t *) b;
+  double temp = pa->value - pb->value;
   if (temp > 0)
     return 1;
   else if (temp < 0)
     return -1;
+  else if (pa->index > pb->index)
+    return 1;
+  else if (pa->index < pb->index)
+    return -1;
   else
     return 0;
 }
+
+/**
+ * Sets rperm to the permutation that sorts the first n values in ascending order.
+ */
+static void f_gallagher_compute_permutation(const double *values,
+                                            const size_t n,
+                                            f_gallagher_permutation_t *pairs,
+                                            size_t *rperm) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    pairs[i].value = values[i];
+    pairs[i].index = i;
+  }
+  qsort(pairs, n, sizeof(*pairs), f_gallagher_compare_doubles);
+  for (i = 0; i < n; ++i)
+    rperm[i] = pairs[i].index;
+}
+
 static double f_gallagher_raw(const double *x, const size_t number_of_variables, f_gallagher_data_t *data) {
   size_t i, j; /* Loop over dim */
-  double *tmx;
+  const size_t number_of_peaks = data->number_of_peaks;
+  double *tmx = data->tmx;
+  double *distances = data->distances;
   double a = 0.1;
   double tmp2, f = 0., Fadd, tmp, Fpen = 0., Ftrue = 0.;
   double fac;
@@ -50,21 +92,21 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   Fadd = Fpen;
   /* Transformation in search space */
   /* TODO: this should rather be done in f_gallagher */
-  tmx = coco_allocate_vector(number_of_variables);
-  for (i = 0; i < number_of_variables; i++) {
-    tmx[i] = 0;
-    for (j = 0; j < number_of_variables; ++j) {
-      tmx[i] += data->rotation[i][j] * x[j];
+  coco_matrix_multiply_vector(data->rotation, x, NULL, tmx);
+  /* Computation core: weighted distances to all peaks, one coordinate at a time */
+  for (i = 0; i < number_of_peaks; ++i)
+    distances[i] = 0.;
+  for (j = 0; j < number_of_variables; ++j) {
+    const double *x_local = data->x_local + j * number_of_peaks;
+    const double *arr_scales = data->arr_scales + j * number_of_peaks;
+    const double tmx_j = tmx[j];
+    for (i = 0; i < number_of_peaks; ++i) {
+      tmp = tmx_j - x_local[i];
+      distances[i] += arr_scales[i] * tmp * tmp;
     }
   }
-  /* Computation core*/
-  for (i = 0; i < data->number_of_peaks; ++i) {
-    tmp2 = 0.;
-    for (j = 0; j < number_of_variables; ++j) {
-      tmp = (tmx[j] - data->x_local[j][i]);
-      tmp2 += data->arr_scales[i][j] * tmp * tmp;
-    }
-    tmp2 = data->peak_values[i] * exp(fac * tmp2);
+  for (i = 0; i < number_of_peaks; ++i) {
+    tmp2 = data->peak_values[i] * exp(fac * distances[i]);
     f = coco_max_double(f, tmp2);
   }
 
@@ -81,7 +123,6 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   Ftrue *= Ftrue;
   Ftrue += Fadd;
   result = Ftrue;
-  coco_free_memory(tmx);
   return result;
 }
 
@@ -91,21 +132,30 @@ static void f_gallagher_evaluate(coco_problem_t *self, const double *x, double *
   assert(y[0] >= self->best_value[0]);
 }
 
+static void f_gallagher_evaluate_batch(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_gallagher_raw(x + i * self->number_of_variables, self->number_of_variables, self->data);
+    assert(y[i] >= self->best_value[0]);
+  }
+}
+
 static void f_gallagher_free(coco_problem_t *self) {
   f_gallagher_data_t *data;
   data = self->data;
   coco_free_memory(data->xopt);
   coco_free_memory(data->peak_values);
-  bbob2009_free_matrix(data->rotation, self->number_of_variables);
-  bbob2009_free_matrix(data->x_local, self->number_of_variables);
-  bbob2009_free_matrix(data->arr_scales, data->number_of_peaks);
+  coco_free_memory(data->x_local);
+  coco_free_memory(data->arr_scales);
+  coco_free_memory(data->tmx);
+  coco_free_memory(data->distances);
+  coco_matrix_free(data->rotation);
   self->free_problem = NULL;
   coco_problem_free(self);
-
-  if (gallagher_peaks != NULL) {
-    coco_free_memory(gallagher_peaks);
-    gallagher_peaks = NULL;
-  }
 }
 
 /* Note: there is no separate f_gallagher_allocate() function! */
@@ -132,44 +182,45 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   /* maxcondition1 satisfies the old code and the doc but seems wrong in that it is, with very high
    * probability, not the largest condition level!!! */
   double maxcondition1 = 1000.;
-  double *arrCondition;
+  double *arrCondition, *random_numbers;
+  f_gallagher_permutation_t *pairs;
   double fitvalues[2] = { 1.1, 9.1 };
   /* Parameters for generating local optima. In the old code, they are different in f21 and f22 */
   double b, c;
 
-  data = coco_allocate_memory(sizeof(*data));
-  /* Allocate temporary storage and space for the rotation matrices */
-  data->number_of_peaks = number_of_peaks;
-  data->xopt = coco_allocate_vector(dimension);
-  data->rotation = bbob2009_allocate_matrix(dimension, dimension);
-  data->x_local = bbob2009_allocate_matrix(dimension, number_of_peaks);
-  data->arr_scales = bbob2009_allocate_matrix(number_of_peaks, dimension);
-
+  problem->evaluate_function_batch = f_gallagher_evaluate_batch;
   if (number_of_peaks == peaks_101) {
-    if (gallagher_peaks != NULL)
-      coco_free_memory(gallagher_peaks);
-    gallagher_peaks = coco_allocate_vector(peaks_101 * dimension);
     maxcondition1 = sqrt(maxcondition1);
     b = 10.;
     c = 5.;
   } else if (number_of_peaks == peaks_21) {
-    if (gallagher_peaks != NULL)
-      coco_free_memory(gallagher_peaks);
-    gallagher_peaks = coco_allocate_vector(peaks_21 * dimension);
     b = 9.8;
     c = 4.9;
   } else {
     coco_error("f_gallagher(): '%lu' is a bad number of peaks", number_of_peaks);
+    return NULL; /* Never reached */
   }
+
+  data = coco_allocate_memory(sizeof(*data));
+  /* Allocate temporary storage and space for the rotation matrix and the peaks */
+  data->number_of_peaks = number_of_peaks;
+  data->xopt = coco_allocate_vector(dimension);
+  data->rotation = coco_matrix_allocate(dimension, dimension);
+  data->x_local = coco_allocate_vector(dimension * number_of_peaks);
+  data->arr_scales = coco_allocate_vector(dimension * number_of_peaks);
+  data->tmx = coco_allocate_vector(dimension);
+  data->distances = coco_allocate_vector(number_of_peaks);
+
+  random_numbers = coco_allocate_vector(number_of_peaks * dimension);
+  pairs = (f_gallagher_permutation_t *) coco_allocate_memory(
+      (number_of_peaks > dimension ? number_of_peaks : dimension) * sizeof(*pairs));
   data->rseed = rseed;
   bbob2009_compute_rotation(data->rotation, rseed, dimension);
 
   /* Initialize all the data of the inner problem */
-  bbob2009_unif(gallagher_peaks, number_of_peaks - 1, data->rseed);
+  bbob2009_unif(random_numbers, number_of_peaks - 1, data->rseed);
   rperm = (size_t *) coco_allocate_memory((number_of_peaks - 1) * sizeof(size_t));
-  for (i = 0; i < number_of_peaks - 1; ++i)
-    rperm[i] = i;
-  qsort(rperm, number_of_peaks - 1, sizeof(size_t), f_gallagher_compare_doubles);
+  f_gallagher_compute_permutation(random_numbers, number_of_peaks - 1, pairs, rperm);
 
   /* Random permutation */
   arrCondition = coco_allocate_vector(number_of_peaks);
@@ -185,32 +236,34 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
 
   rperm = (size_t *) coco_allocate_memory(dimension * sizeof(size_t));
   for (i = 0; i < number_of_peaks; ++i) {
-    bbob2009_unif(gallagher_peaks, dimension, data->rseed + (long) (1000 * i));
-    for (j = 0; j < dimension; ++j)
-      rperm[j] = j;
-    qsort(rperm, dimension, sizeof(size_t), f_gallagher_compare_doubles);
+    bbob2009_unif(random_numbers, dimension, data->rseed + (long) (1000 * i));
+    f_gallagher_compute_permutation(random_numbers, dimension, pairs, rperm);
     for (j = 0; j < dimension; ++j) {
-      data->arr_scales[i][j] = pow(arrCondition[i],
+      data->arr_scales[j * number_of_peaks + i] = pow(arrCondition[i],
           ((double) rperm[j]) / ((double) (dimension - 1)) - 0.5);
     }
   }
   coco_free_memory(rperm);
+  coco_free_memory(pairs);
 
-  bbob2009_unif(gallagher_peaks, dimension * number_of_peaks, data->rseed);
+  bbob2009_unif(random_numbers, dimension * number_of_peaks, data->rseed);
   for (i = 0; i < dimension; ++i) {
-    data->xopt[i] = 0.8 * (b * gallagher_peaks[i] - c);
-    problem->best_parameter[i] = 0.8 * (b * gallagher_peaks[i] - c);
+    const double *rotation_row = coco_matrix_row(data->rotation, i);
+    data->xopt[i] = 0.8 * (b * random_numbers[i] - c);
+    problem->best_parameter[i] = 0.8 * (b * random_numbers[i] - c);
     for (j = 0; j < number_of_peaks; ++j) {
-      data->x_local[i][j] = 0.;
+      double *x_local = &data->x_local[i * number_of_peaks + j];
+      *x_local = 0.;
       for (k = 0; k < dimension; ++k) {
-        data->x_local[i][j] += data->rotation[i][k] * (b * gallagher_peaks[j * dimension + k] - c);
+        *x_local += rotation_row[k] * (b * random_numbers[j * dimension + k] - c);
       }
       if (j == 0) {
-        data->x_local[i][j] *= 0.8;
+        *x_local *= 0.8;
       }
     }
   }
   coco_free_memory(arrCondition);
+  coco_free_memory(random_numbers);
 
   problem->data = data;
 
@@ -33,10 +33,22 @@ static void f_griewank_rosenbrock_evaluate(coco_problem_t *self, const double *x
   y[0] = f_griewank_rosenbrock_raw(x, self->number_of_variables);
 }
 
+static void f_griewank_rosenbrock_evaluate_batch(coco_problem_t *self,
+                                                 const double *x,
+                                                 const size_t number_of_points,
+                                                 double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_griewank_rosenbrock_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_griewank_rosenbrock_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Griewank Rosenbrock function",
       f_griewank_rosenbrock_evaluate, NULL, number_of_variables, -5.0, 5.0, 1);
+  problem->evaluate_function_batch = f_griewank_rosenbrock_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "griewank_rosenbrock", number_of_variables);
 
   /* Compute best solution */
@@ -57,19 +69,20 @@ static coco_problem_t *f_griewank_rosenbrock_bbob_problem_allocate(const size_t
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
   double *shift = coco_allocate_vector(dimension);
-  double scales, **rot1;
+  double scales;
+  coco_matrix_t *rot1;
 
   fopt = bbob2009_compute_fopt(function, instance);
   for (i = 0; i < dimension; ++i) {
     shift[i] = -0.5;
   }
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed, dimension);
   scales = coco_max_double(1., sqrt((double) dimension) / 8.);
   for (i = 0; i < dimension; ++i) {
     for (j = 0; j < dimension; ++j) {
-      rot1[i][j] *= scales;
+      rot1->data[i * dimension + j] *= scales;
     }
   }
 
@@ -79,7 +92,7 @@ static coco_problem_t *f_griewank_rosenbrock_bbob_problem_allocate(const size_t
   bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
   problem = f_transform_vars_affine(problem, M, b, dimension);
 
-  bbob2009_free_matrix(rot1, dimension);
+  coco_matrix_free(rot1);
 
   coco_problem_set_id(problem, problem_id_template, function, instance, dimension);
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
@@ -39,10 +39,22 @@ static void f_katsuura_evaluate(coco_problem_t *self, const double *x, double *y
   y[0] = f_katsuura_raw(x, self->number_of_variables);
 }
 
+static void f_katsuura_evaluate_batch(coco_problem_t *self,
+                                      const double *x,
+                                      const size_t number_of_points,
+                                      double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_katsuura_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_katsuura_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Katsuura function",
       f_katsuura_evaluate, NULL, number_of_variables, -5.0, 5.0, 1);
+  problem->evaluate_function_batch = f_katsuura_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "katsuura", number_of_variables);
 
   /* Compute best solution */
@@ -60,7 +72,8 @@ static coco_problem_t *f_katsuura_bbob_problem_allocate(const size_t function,
   size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double *current_row;
+  coco_matrix_t *rot1, *rot2;
 
   const double penalty_factor = 1.0;
 
@@ -68,8 +81,8 @@ static coco_problem_t *f_katsuura_bbob_problem_allocate(const size_t function,
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
+  rot2 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
 
@@ -80,7 +93,7 @@ static coco_problem_t *f_katsuura_bbob_problem_allocate(const size_t function,
       current_row[j] = 0.0;
       for (k = 0; k < dimension; ++k) {
         double exponent = 1.0 * (int) k / ((double) (long) dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(100), exponent) * rot2[k][j];
+        current_row[j] += rot1->data[i * dimension + k] * pow(sqrt(100), exponent) * rot2->data[k * dimension + j];
       }
     }
   }
@@ -91,8 +104,8 @@ static coco_problem_t *f_katsuura_bbob_problem_allocate(const size_t function,
   problem = f_transform_vars_shift(problem, xopt, 0);
   problem = f_transform_obj_penalize(problem, penalty_factor);
 
-  bbob2009_free_matrix(rot1, dimension);
-  bbob2009_free_matrix(rot2, dimension);
+  coco_matrix_free(rot1);
+  coco_matrix_free(rot2);
 
   coco_problem_set_id(problem, problem_id_template, function, instance, dimension);
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
@@ -36,12 +36,24 @@ static void f_linear_slope_evaluate(coco_problem_t *self, const double *x, doubl
   y[0] = f_linear_slope_raw(x, self->number_of_variables, self->best_parameter);
 }
 
+static void f_linear_slope_evaluate_batch(coco_problem_t *self,
+                                          const double *x,
+                                          const size_t number_of_points,
+                                          double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_linear_slope_raw(x + i * self->number_of_variables, self->number_of_variables, self->best_parameter);
+  }
+}
+
 static coco_problem_t *f_linear_slope_allocate(const size_t number_of_variables, const double *best_parameter) {
 
   size_t i;
   /* best_parameter will be overwritten below */
   coco_problem_t *problem = coco_problem_allocate_from_scalars("linear slope function",
       f_linear_slope_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_linear_slope_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "linear_slope", number_of_variables);
 
   /* Compute best solution */
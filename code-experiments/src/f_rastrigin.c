@@ -4,6 +4,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_vars_conditioning.c"
 #include "transform_vars_asymmetric.c"
@@ -14,14 +15,11 @@
 
 static double f_rastrigin_raw(const double *x, const size_t number_of_variables) {
 
-  size_t i = 0;
   double result;
-  double sum1 = 0.0, sum2 = 0.0;
+  double sum1, sum2;
 
-  for (i = 0; i < number_of_variables; ++i) {
-    sum1 += cos(coco_two_pi * x[i]);
-    sum2 += x[i] * x[i];
-  }
+  sum1 = coco_vector_sum_of_cosines(x, number_of_variables);
+  sum2 = coco_vector_add_squares(0.0, x, 1.0, number_of_variables);
   result = 10.0 * ((double) (long) number_of_variables - sum1) + sum2;
 
   return result;
@@ -32,10 +30,22 @@ static void f_rastrigin_evaluate(coco_problem_t *self, const double *x, double *
   y[0] = f_rastrigin_raw(x, self->number_of_variables);
 }
 
+static void f_rastrigin_evaluate_batch(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_rastrigin_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_rastrigin_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Rastrigin function",
       f_rastrigin_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_rastrigin_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "rastrigin", number_of_variables);
 
   /* Compute best solution */
@@ -83,16 +93,18 @@ static coco_problem_t *f_rastrigin_rotated_bbob_problem_allocate(const size_t fu
   size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double *current_row;
+  coco_matrix_t *rot1, *rot2;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
+  rot2 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
+  assert(dimension > 0);
   for (i = 0; i < dimension; ++i) {
     b[i] = 0.0;
     current_row = M + i * dimension;
@@ -100,7 +112,7 @@ static coco_problem_t *f_rastrigin_rotated_bbob_problem_allocate(const size_t fu
       current_row[j] = 0.0;
       for (k = 0; k < dimension; ++k) {
         double exponent = 1.0 * (int) k / ((double) (long) dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(10), exponent) * rot2[k][j];
+        current_row[j] += rot1->data[i * dimension + k] * pow(sqrt(10), exponent) * rot2->data[k * dimension + j];
       }
     }
   }
@@ -114,8 +126,8 @@ static coco_problem_t *f_rastrigin_rotated_bbob_problem_allocate(const size_t fu
   problem = f_transform_vars_affine(problem, M, b, dimension);
   problem = f_transform_vars_shift(problem, xopt, 0);
 
-  bbob2009_free_matrix(rot1, dimension);
-  bbob2009_free_matrix(rot2, dimension);
+  coco_matrix_free(rot1);
+  coco_matrix_free(rot2);
 
   coco_problem_set_id(problem, problem_id_template, function, instance, dimension);
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
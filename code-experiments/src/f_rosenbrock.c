@@ -32,10 +32,22 @@ static void f_rosenbrock_evaluate(coco_problem_t *self, const double *x, double
   y[0] = f_rosenbrock_raw(x, self->number_of_variables);
 }
 
+static void f_rosenbrock_evaluate_batch(coco_problem_t *self,
+                                        const double *x,
+                                        const size_t number_of_points,
+                                        double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_rosenbrock_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_rosenbrock_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Rosenbrock function",
       f_rosenbrock_evaluate, NULL, number_of_variables, -5.0, 5.0, 1.0);
+  problem->evaluate_function_batch = f_rosenbrock_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "rosenbrock", number_of_variables);
 
   /* Compute best solution */
@@ -92,10 +104,11 @@ static coco_problem_t *f_rosenbrock_rotated_bbob_problem_allocate(const size_t f
   size_t row, column;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, factor;
+  double *current_row, factor;
+  coco_matrix_t *rot1;
 
   fopt = bbob2009_compute_fopt(function, instance);
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed, dimension);
 
   factor = coco_max_double(1.0, sqrt((double) dimension) / 8.0);
@@ -103,13 +116,13 @@ static coco_problem_t *f_rosenbrock_rotated_bbob_problem_allocate(const size_t f
   for (row = 0; row < dimension; ++row) {
     current_row = M + row * dimension;
     for (column = 0; column < dimension; ++column) {
-      current_row[column] = rot1[row][column];
+      current_row[column] = rot1->data[row * dimension + column];
       if (row == column)
         current_row[column] *= factor;
     }
     b[row] = 0.5;
   }
-  bbob2009_free_matrix(rot1, dimension);
+  coco_matrix_free(rot1);
 
   problem = f_rosenbrock_allocate(dimension);
   problem = f_transform_vars_affine(problem, M, b, dimension);
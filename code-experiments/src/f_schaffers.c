@@ -36,10 +36,22 @@ static void f_schaffers_evaluate(coco_problem_t *self, const double *x, double *
   y[0] = f_schaffers_raw(x, self->number_of_variables);
 }
 
+static void f_schaffers_evaluate_batch(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_schaffers_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_schaffers_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Schaffer's function",
       f_schaffers_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_schaffers_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "schaffers", number_of_variables);
 
   /* Compute best solution */
@@ -59,7 +71,8 @@ static coco_problem_t *f_schaffers_bbob_problem_allocate(const size_t function,
   size_t i, j;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double *current_row;
+  coco_matrix_t *rot1, *rot2;
 
   const double penalty_factor = 10.0;
 
@@ -67,8 +80,8 @@ static coco_problem_t *f_schaffers_bbob_problem_allocate(const size_t function,
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
+  rot2 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
   for (i = 0; i < dimension; ++i) {
@@ -76,7 +89,7 @@ static coco_problem_t *f_schaffers_bbob_problem_allocate(const size_t function,
     current_row = M + i * dimension;
     for (j = 0; j < dimension; ++j) {
       double exponent = 1.0 * (int) i / ((double) (long) dimension - 1.0);
-      current_row[j] = rot2[i][j] * pow(sqrt(conditioning), exponent);
+      current_row[j] = rot2->data[i * dimension + j] * pow(sqrt(conditioning), exponent);
     }
   }
 
@@ -89,8 +102,8 @@ static coco_problem_t *f_schaffers_bbob_problem_allocate(const size_t function,
   problem = f_transform_vars_shift(problem, xopt, 0);
   problem = f_transform_obj_penalize(problem, penalty_factor);
 
-  bbob2009_free_matrix(rot1, dimension);
-  bbob2009_free_matrix(rot2, dimension);
+  coco_matrix_free(rot1);
+  coco_matrix_free(rot2);
 
   coco_problem_set_id(problem, problem_id_template, function, instance, dimension);
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
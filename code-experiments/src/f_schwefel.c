@@ -43,10 +43,23 @@ static void f_schwefel_evaluate(coco_problem_t *self, const double *x, double *y
   assert(y[0] >= self->best_value[0]);
 }
 
+static void f_schwefel_evaluate_batch(coco_problem_t *self,
+                                      const double *x,
+                                      const size_t number_of_points,
+                                      double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_schwefel_raw(x + i * self->number_of_variables, self->number_of_variables);
+    assert(y[i] >= self->best_value[0]);
+  }
+}
+
 static coco_problem_t *f_schwefel_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Schwefel function",
       f_schwefel_evaluate, NULL, number_of_variables, -5.0, 5.0, 420.96874633);
+  problem->evaluate_function_batch = f_schwefel_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "schwefel", number_of_variables);
 
   /* Compute best solution: best_parameter[i] = 200 * fabs(xopt[i]) */
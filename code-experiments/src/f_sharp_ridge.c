@@ -3,6 +3,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_shift.c"
 #include "transform_vars_affine.c"
@@ -11,15 +12,11 @@
 static double f_sharp_ridge_raw(const double *x, const size_t number_of_variables) {
 
   static const double alpha = 100.0;
-  size_t i = 0;
   double result;
 
   assert(number_of_variables > 1);
 
-  result = 0.0;
-  for (i = 1; i < number_of_variables; ++i) {
-    result += x[i] * x[i];
-  }
+  result = coco_vector_add_squares(0.0, x + 1, 1.0, number_of_variables - 1);
   result = alpha * sqrt(result) + x[0] * x[0];
 
   return result;
@@ -30,10 +27,22 @@ static void f_sharp_ridge_evaluate(coco_problem_t *self, const double *x, double
   y[0] = f_sharp_ridge_raw(x, self->number_of_variables);
 }
 
+static void f_sharp_ridge_evaluate_batch(coco_problem_t *self,
+                                         const double *x,
+                                         const size_t number_of_points,
+                                         double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_sharp_ridge_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_sharp_ridge_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("sharp ridge function",
       f_sharp_ridge_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_sharp_ridge_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "sharp_ridge", number_of_variables);
 
   /* Compute best solution */
@@ -51,14 +60,15 @@ static coco_problem_t *f_sharp_ridge_bbob_problem_allocate(const size_t function
   size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double *current_row;
+  coco_matrix_t *rot1, *rot2;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
+  rot2 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
   for (i = 0; i < dimension; ++i) {
@@ -68,12 +78,12 @@ static coco_problem_t *f_sharp_ridge_bbob_problem_allocate(const size_t function
       current_row[j] = 0.0;
       for (k = 0; k < dimension; ++k) {
         double exponent = 1.0 * (int) k / ((double) (long) dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(10), exponent) * rot2[k][j];
+        current_row[j] += rot1->data[i * dimension + k] * pow(sqrt(10), exponent) * rot2->data[k * dimension + j];
       }
     }
   }
-  bbob2009_free_matrix(rot1, dimension);
-  bbob2009_free_matrix(rot2, dimension);
+  coco_matrix_free(rot1);
+  coco_matrix_free(rot2);
   problem = f_sharp_ridge_allocate(dimension);
   problem = f_transform_obj_shift(problem, fopt);
   problem = f_transform_vars_affine(problem, M, b, dimension);
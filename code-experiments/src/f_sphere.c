@@ -3,21 +3,13 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_shift.c"
 #include "transform_vars_shift.c"
 
 static double f_sphere_raw(const double *x, const size_t number_of_variables) {
-
-  size_t i = 0;
-  double result;
-
-  result = 0.0;
-  for (i = 0; i < number_of_variables; ++i) {
-    result += x[i] * x[i];
-  }
-
-  return result;
+  return coco_vector_add_squares(0.0, x, 1.0, number_of_variables);
 }
 
 static void f_sphere_evaluate(coco_problem_t *self, const double *x, double *y) {
@@ -25,10 +17,22 @@ static void f_sphere_evaluate(coco_problem_t *self, const double *x, double *y)
   y[0] = f_sphere_raw(x, self->number_of_variables);
 }
 
+static void f_sphere_evaluate_batch(coco_problem_t *self,
+                                    const double *x,
+                                    const size_t number_of_points,
+                                    double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_sphere_raw(x + i * self->number_of_variables, self->number_of_variables);
+  }
+}
+
 static coco_problem_t *f_sphere_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("sphere function",
       f_sphere_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_function_batch = f_sphere_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "sphere", number_of_variables);
 
   /* Compute best solution */
@@ -18,14 +18,15 @@
 typedef struct {
   double *x, *xx;
   double *xopt, fopt;
-  double **rot1, **rot2;
+  coco_matrix_t *rot1;
+  coco_matrix_t *rot2; /* Row i is scaled by sqrt((condition / 10)^(i / (D - 1))) */
+  double *weights;     /* condition^(i / (D - 1)), used in the computation core */
 } f_step_ellipsoid_data_t;
 
 static double f_step_ellipsoid_raw(const double *x, size_t number_of_variables, f_step_ellipsoid_data_t *data) {
 
-  static const double condition = 100;
   static const double alpha = 10.0;
-  size_t i, j;
+  size_t i;
   double penalty = 0.0, x1;
   double result;
 
@@ -39,13 +40,9 @@ static double f_step_ellipsoid_raw(const double *x, size_t number_of_variables,
   }
 
   for (i = 0; i < number_of_variables; ++i) {
-    double c1;
-    data->x[i] = 0.0;
-    c1 = sqrt(pow(condition / 10., (double) i / (double) (number_of_variables - 1)));
-    for (j = 0; j < number_of_variables; ++j) {
-      data->x[i] += c1 * data->rot2[i][j] * (x[j] - data->xopt[j]);
-    }
+    data->xx[i] = x[i] - data->xopt[i];
   }
+  coco_matrix_multiply_vector(data->rot2, data->xx, NULL, data->x);
   x1 = data->x[0];
 
   for (i = 0; i < number_of_variables; ++i) {
@@ -55,20 +52,12 @@ static double f_step_ellipsoid_raw(const double *x, size_t number_of_variables,
       data->x[i] = coco_round_double(alpha * data->x[i]) / alpha;
   }
 
-  for (i = 0; i < number_of_variables; ++i) {
-    data->xx[i] = 0.0;
-    for (j = 0; j < number_of_variables; ++j) {
-      data->xx[i] += data->rot1[i][j] * data->x[j];
-    }
-  }
+  coco_matrix_multiply_vector(data->rot1, data->x, NULL, data->xx);
 
   /* Computation core */
   result = 0.0;
   for (i = 0; i < number_of_variables; ++i) {
-    double exponent;
-    exponent = (double) (long) i / ((double) (long) number_of_variables - 1.0);
-    result += pow(condition, exponent) * data->xx[i] * data->xx[i];
-    ;
+    result += data->weights[i] * data->xx[i] * data->xx[i];
   }
   result = 0.1 * coco_max_double(fabs(x1) * 1.0e-4, result) + penalty + data->fopt;
 
@@ -80,14 +69,26 @@ static void f_step_ellipsoid_evaluate(coco_problem_t *self, const double *x, dou
   y[0] = f_step_ellipsoid_raw(x, self->number_of_variables, self->data);
 }
 
+static void f_step_ellipsoid_evaluate_batch(coco_problem_t *self,
+                                            const double *x,
+                                            const size_t number_of_points,
+                                            double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_step_ellipsoid_raw(x + i * self->number_of_variables, self->number_of_variables, self->data);
+  }
+}
+
 static void f_step_ellipsoid_free(coco_problem_t *self) {
   f_step_ellipsoid_data_t *data;
   data = self->data;
   coco_free_memory(data->x);
   coco_free_memory(data->xx);
   coco_free_memory(data->xopt);
-  bbob2009_free_matrix(data->rot1, self->number_of_variables);
-  bbob2009_free_matrix(data->rot2, self->number_of_variables);
+  coco_free_memory(data->weights);
+  coco_matrix_free(data->rot1);
+  coco_matrix_free(data->rot2);
   /* Let the generic free problem code deal with all of the coco_problem_t fields */
   self->free_problem = NULL;
   coco_problem_free(self);
@@ -102,24 +103,38 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
                                                               const char *problem_id_template,
                                                               const char *problem_name_template) {
 
+  static const double condition = 100;
   f_step_ellipsoid_data_t *data;
-  size_t i;
+  size_t i, j;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("step ellipsoid function",
       f_step_ellipsoid_evaluate, f_step_ellipsoid_free, dimension, -5.0, 5.0, NAN);
+  problem->evaluate_function_batch = f_step_ellipsoid_evaluate_batch;
 
   data = coco_allocate_memory(sizeof(*data));
   /* Allocate temporary storage and space for the rotation matrices */
   data->x = coco_allocate_vector(dimension);
   data->xx = coco_allocate_vector(dimension);
   data->xopt = coco_allocate_vector(dimension);
-  data->rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  data->rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  data->rot1 = coco_matrix_allocate(dimension, dimension);
+  data->rot2 = coco_matrix_allocate(dimension, dimension);
+  data->weights = coco_allocate_vector(dimension);
 
   data->fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(data->xopt, rseed, dimension);
   bbob2009_compute_rotation(data->rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(data->rot2, rseed, dimension);
 
+  /* Per-coordinate coefficients do not depend on x, so compute them only once */
+  for (i = 0; i < dimension; ++i) {
+    const double exponent = (double) (long) i / ((double) (long) dimension - 1.0);
+    const double c1 = sqrt(pow(condition / 10., (double) i / (double) (dimension - 1)));
+    double *row = coco_matrix_row(data->rot2, i);
+    for (j = 0; j < dimension; ++j) {
+      row[j] = c1 * row[j];
+    }
+    data->weights[i] = pow(condition, exponent);
+  }
+
   problem->data = data;
   
   /* Compute best solution
@@ -40,6 +40,17 @@ static void f_weierstrass_evaluate(coco_problem_t *self, const double *x, double
   y[0] = f_weierstrass_raw(x, self->number_of_variables, self->data);
 }
 
+static void f_weierstrass_evaluate_batch(coco_problem_t *self,
+                                         const double *x,
+                                         const size_t number_of_points,
+                                         double *y) {
+  size_t i;
+  assert(self->number_of_objectives == 1);
+  for (i = 0; i < number_of_points; ++i) {
+    y[i] = f_weierstrass_raw(x + i * self->number_of_variables, self->number_of_variables, self->data);
+  }
+}
+
 static coco_problem_t *f_weierstrass_allocate(const size_t number_of_variables) {
 
   f_weierstrass_data_t *data;
@@ -47,6 +58,7 @@ static coco_problem_t *f_weierstrass_allocate(const size_t number_of_variables)
   double *non_unique_best_value;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Weierstrass function",
       f_weierstrass_evaluate, NULL, number_of_variables, -5.0, 5.0, NAN);
+  problem->evaluate_function_batch = f_weierstrass_evaluate_batch;
   coco_problem_set_id(problem, "%s_d%02lu", "weierstrass", number_of_variables);
 
   data = coco_allocate_memory(sizeof(*data));
@@ -78,7 +90,8 @@ static coco_problem_t *f_weierstrass_bbob_problem_allocate(const size_t function
   size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double *current_row;
+  coco_matrix_t *rot1, *rot2;
 
   const double condition = 100.0;
   const double penalty_factor = 10.0 / (double) dimension;
@@ -87,8 +100,8 @@ static coco_problem_t *f_weierstrass_bbob_problem_allocate(const size_t function
   fopt = bbob2009_compute_fopt(function, instance);
   bbob2009_compute_xopt(xopt, rseed, dimension);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  rot1 = coco_matrix_allocate(dimension, dimension);
+  rot2 = coco_matrix_allocate(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
   for (i = 0; i < dimension; ++i) {
@@ -99,7 +112,7 @@ static coco_problem_t *f_weierstrass_bbob_problem_allocate(const size_t function
       for (k = 0; k < dimension; ++k) {
         const double base = 1.0 / sqrt(condition);
         const double exponent = 1.0 * (int) k / ((double) (long) dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(base, exponent) * rot2[k][j];
+        current_row[j] += rot1->data[i * dimension + k] * pow(base, exponent) * rot2->data[k * dimension + j];
       }
     }
   }
@@ -113,8 +126,8 @@ static coco_problem_t *f_weierstrass_bbob_problem_allocate(const size_t function
   problem = f_transform_vars_shift(problem, xopt, 0);
   problem = f_transform_obj_penalize(problem, penalty_factor);
 
-  bbob2009_free_matrix(rot1, dimension);
-  bbob2009_free_matrix(rot2, dimension);
+  coco_matrix_free(rot1);
+  coco_matrix_free(rot2);
 
   coco_problem_set_id(problem, problem_id_template, function, instance, dimension);
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
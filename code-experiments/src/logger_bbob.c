@@ -11,30 +11,15 @@
 #include "coco_utilities.c"
 #include "coco_problem.c"
 #include "coco_string.c"
+#include "coco_format.c"
+#include "coco_log_format.c"
 #include "observer_bbob.c"
 
-static int bbob_raisedOptValWarning;
 /*static const size_t bbob_nbpts_nbevals = 20; Wassim: tentative, are now observer options with these default values*/
 /*static const size_t bbob_nbpts_fval = 5;*/
-static size_t bbob_current_dim = 0;
-static size_t bbob_current_funId = 0;
-static size_t bbob_infoFile_firstInstance = 0;
-char bbob_infoFile_firstInstance_char[3];
-/* a possible solution: have a list of dims that are already in the file, if the ones we're about to log
- * is != bbob_current_dim and the funId is currend_funId, create a new .info file with as suffix the
- * number of the first instance */
-static const int bbob_number_of_dimensions = 6;
-static size_t bbob_dimensions_in_current_infoFile[6] = { 0, 0, 0, 0, 0, 0 }; /* TODO should use dimensions from the suite */
-
-/* The current_... mechanism fails if several problems are open.
- * For the time being this should lead to an error.
- *
- * A possible solution: bbob_logger_is_open becomes a reference
- * counter and as long as another logger is open, always a new info
- * file is generated.
- * TODO: Shouldn't the new way of handling observers already fix this?
- */
-static int bbob_logger_is_open = 0; /* this could become lock-list of .info files */
+
+/* The bookkeeping of the index files (formerly in static variables of this file, which allowed only one
+ * open logger at a time) is now done by the observer, see observer_bbob_index_t. */
 
 /* TODO: add possibility of adding a prefix to the index files (easy to do through observer options) */
 
@@ -43,15 +28,18 @@ typedef struct {
   int is_initialized;
   /*char *path;// relative path to the data folder. //Wassim: now fetched from the observer */
   /*const char *alg_name; the alg name, for now, temporarily the same as the path. Wassim: Now in the observer */
-  FILE *index_file; /* index file */
+  observer_bbob_index_t *index; /* shared with the observer, which can be freed before the logger */
+  char *index_file_path; /* path of the index file */
+  char *data_file; /* relative path of the data files without extension from where the index file is */
   FILE *fdata_file; /* function value aligned data file */
   FILE *tdata_file; /* number of function evaluations aligned data file */
   FILE *rdata_file; /* restart info data file */
   double f_trigger; /* next upper bound on the fvalue to trigger a log in the .dat file*/
   long t_trigger; /* next lower bound on nb fun evals to trigger a log in the .tdat file*/
   int idx_f_trigger; /* allows to track the index i in logging target = {10**(i/bbob_nbpts_fval), i \in Z} */
-  int idx_t_trigger; /* allows to track the index i in logging nbevals = {int(10**(i/bbob_nbpts_nbevals)), i \in Z} */
-  int idx_tdim_trigger; /* allows to track the index i in logging nbevals = {dim * 10**i, i \in Z} */
+  long *t_ladder; /* increasing nbevals triggers {int(10**(i/bbob_nbpts_nbevals))} U {dim * 10**i}, i = 0, 1, ... */
+  size_t t_ladder_length;
+  size_t idx_t_trigger; /* index of t_trigger in t_ladder */
   long number_of_evaluations;
   double best_fvalue;
   double last_fvalue;
@@ -65,6 +53,9 @@ typedef struct {
   size_t instance_id;
   size_t number_of_variables;
   double optimal_fvalue;
+  int raised_optimal_value_warning;
+  coco_flush_state_t flush_state;
+  coco_log_format_t format; /* copied from the observer, which can be freed before the logger */
 } logger_bbob_t;
 
 static const char *bbob_file_header_str = "%% function evaluation | "
@@ -75,6 +66,16 @@ static const char *bbob_file_header_str = "%% function evaluation | "
     "x1 | "
     "x2...\n";
 
+/**
+ * Returns the f target 10**(idx_f_trigger/bbob_nbpts_fval), looked up in the ladder of the observer if possible
+ */
+static double logger_bbob_f_target(const observer_bbob_t *observer_bbob, const int idx_f_trigger) {
+  if ((idx_f_trigger >= observer_bbob->f_ladder_first_index)
+      && (idx_f_trigger - observer_bbob->f_ladder_first_index < (long) observer_bbob->f_ladder_length))
+    return observer_bbob->f_ladder[idx_f_trigger - observer_bbob->f_ladder_first_index];
+  return pow(10, idx_f_trigger * 1.0 / (double) (long) observer_bbob->bbob_nbpts_fval);
+}
+
 static void logger_bbob_update_f_trigger(logger_bbob_t *logger, double fvalue) {
   /* "jump" directly to the next closest (but larger) target to the
    * current fvalue from the initial target
@@ -91,33 +92,74 @@ static void logger_bbob_update_f_trigger(logger_bbob_t *logger, double fvalue) {
     } else { /* We only call this function when we reach the current f_trigger*/
       logger->idx_f_trigger--;
     }
-    logger->f_trigger = pow(10, logger->idx_f_trigger * 1.0 / (double) (long) observer_bbob->bbob_nbpts_fval);
+    logger->f_trigger = logger_bbob_f_target(observer_bbob, logger->idx_f_trigger);
     while (fvalue - logger->optimal_fvalue <= logger->f_trigger) {
       logger->idx_f_trigger--;
-      logger->f_trigger = pow(10,
-          logger->idx_f_trigger * 1.0 / (double) (long) observer_bbob->bbob_nbpts_fval);
+      logger->f_trigger = logger_bbob_f_target(observer_bbob, logger->idx_f_trigger);
     }
   }
 }
 
-static void logger_bbob_update_t_trigger(logger_bbob_t *logger, size_t number_of_variables) {
-  observer_bbob_t *observer_bbob;
-  observer_bbob = (observer_bbob_t *) logger->observer->data;
-  while (logger->number_of_evaluations
-      >= floor(pow(10, (double) logger->idx_t_trigger / (double) (long) observer_bbob->bbob_nbpts_nbevals)))
+/**
+ * Computes the ladder of the nbevals triggers, i.e., the union of {int(10**(i/bbob_nbpts_nbevals))} and
+ * {dim * 10**i} for i = 0, 1, ... in increasing order and without duplicates.
+ */
+static void logger_bbob_compute_t_ladder(logger_bbob_t *logger, size_t nbpts_nbevals, size_t number_of_variables) {
+  double value_nbevals, value_dim;
+  int idx_nbevals = 0, idx_dim = 0;
+  size_t maximal_length;
+
+  /* Each sequence has at most nbpts_nbevals values per decade and the nbevals fit into a long */
+  maximal_length = (nbpts_nbevals + 1) * 20 + 1;
+  logger->t_ladder = (long *) coco_allocate_memory(maximal_length * sizeof(long));
+  logger->t_ladder_length = 0;
+  value_nbevals = floor(pow(10, (double) idx_nbevals / (double) (long) nbpts_nbevals));
+  value_dim = (double) (long) number_of_variables * pow(10, (double) idx_dim);
+  while (logger->t_ladder_length < maximal_length) {
+    double value = coco_min_double(value_nbevals, value_dim);
+    if (value >= (double) LONG_MAX)
+      break;
+    if ((logger->t_ladder_length == 0) || ((long) value > logger->t_ladder[logger->t_ladder_length - 1]))
+      logger->t_ladder[logger->t_ladder_length++] = (long) value;
+    if (value_nbevals <= value) {
+      idx_nbevals++;
+      value_nbevals = floor(pow(10, (double) idx_nbevals / (double) (long) nbpts_nbevals));
+    }
+    if (value_dim <= value) {
+      idx_dim++;
+      value_dim = (double) (long) number_of_variables * pow(10, (double) idx_dim);
+    }
+  }
+}
+
+/**
+ * Moves t_trigger to the first nbevals trigger larger than the current number of evaluations.
+ */
+static void logger_bbob_update_t_trigger(logger_bbob_t *logger) {
+  while ((logger->idx_t_trigger < logger->t_ladder_length)
+      && (logger->number_of_evaluations >= logger->t_ladder[logger->idx_t_trigger]))
     logger->idx_t_trigger++;
 
-  while (logger->number_of_evaluations
-      >= (double) (long) number_of_variables * pow(10, (double) logger->idx_tdim_trigger))
-    logger->idx_tdim_trigger++;
+  if (logger->idx_t_trigger < logger->t_ladder_length)
+    logger->t_trigger = logger->t_ladder[logger->idx_t_trigger];
+  else
+    logger->t_trigger = LONG_MAX;
+}
 
-  logger->t_trigger = (long) coco_min_double(
-      floor(pow(10, (double) logger->idx_t_trigger / (double) (long) observer_bbob->bbob_nbpts_nbevals)),
-      (double) (long) number_of_variables * pow(10, (double) logger->idx_tdim_trigger));
+/**
+ * Returns the number of columns of the data files (the variables are only logged if there are less than 22)
+ */
+static size_t logger_bbob_number_of_columns(size_t number_of_variables) {
+  return 5 + ((number_of_variables < 22) ? number_of_variables : 0);
 }
 
 /**
  * adds a formated line to a data file
+ *
+ * The line is the same as the one written by
+ * fprintf("%ld %+10.9e %+10.9e %+10.9e %+10.9e", ...) followed by " %+5.4e" for
+ * each variable, but is formatted with coco_format_exponential() and written at once.
+ * In the binary format, the same numbers are written as a record of doubles.
  */
 static void logger_bbob_write_data(FILE *target_file,
                                    long number_of_evaluations,
@@ -125,19 +167,45 @@ static void logger_bbob_write_data(FILE *target_file,
                                    double best_fvalue,
                                    double best_value,
                                    const double *x,
-                                   size_t number_of_variables) {
+                                   size_t number_of_variables,
+                                   coco_log_format_t format) {
   /* for some reason, it's %.0f in the old code instead of the 10.9e
    * in the documentation
    */
-  fprintf(target_file, "%ld %+10.9e %+10.9e %+10.9e %+10.9e", number_of_evaluations, fvalue - best_value,
-      best_fvalue - best_value, fvalue, best_fvalue);
+  char line[26 * (COCO_FORMAT_BUFFER_SIZE + 1)];
+  double record[26];
+  size_t length;
+
+  if (format == COCO_LOG_FORMAT_BINARY) {
+    record[0] = (double) number_of_evaluations;
+    record[1] = fvalue - best_value;
+    record[2] = best_fvalue - best_value;
+    record[3] = fvalue;
+    record[4] = best_fvalue;
+    if (number_of_variables < 22)
+      memcpy(record + 5, x, number_of_variables * sizeof(double));
+    coco_log_format_write_record(target_file, record, logger_bbob_number_of_columns(number_of_variables));
+    return;
+  }
+
+  length = coco_format_unsigned_long(line, (unsigned long) number_of_evaluations);
+  line[length++] = ' ';
+  length += coco_format_exponential(line + length, fvalue - best_value, 10, 9, 1);
+  line[length++] = ' ';
+  length += coco_format_exponential(line + length, best_fvalue - best_value, 10, 9, 1);
+  line[length++] = ' ';
+  length += coco_format_exponential(line + length, fvalue, 10, 9, 1);
+  line[length++] = ' ';
+  length += coco_format_exponential(line + length, best_fvalue, 10, 9, 1);
   if (number_of_variables < 22) {
     size_t i;
     for (i = 0; i < number_of_variables; i++) {
-      fprintf(target_file, " %+5.4e", x[i]);
+      line[length++] = ' ';
+      length += coco_format_exponential(line + length, x[i], 5, 4, 1);
     }
   }
-  fprintf(target_file, "\n");
+  line[length++] = '\n';
+  fwrite(line, 1, length, target_file);
 }
 
 /**
@@ -161,7 +229,8 @@ static void logger_bbob_error_io(FILE *path, int errnum) {
 static void logger_bbob_open_dataFile(FILE **target_file,
                                       const char *path,
                                       const char *dataFile_path,
-                                      const char *file_extension) {
+                                      const char *file_extension,
+                                      coco_log_format_t format) {
   char file_path[COCO_PATH_MAX] = { 0 };
   char relative_filePath[COCO_PATH_MAX] = { 0 };
   int errnum;
@@ -171,14 +240,26 @@ static void logger_bbob_open_dataFile(FILE **target_file,
   COCO_PATH_MAX - strlen(relative_filePath) - 1);
   coco_join_path(file_path, sizeof(file_path), path, relative_filePath, NULL);
   if (*target_file == NULL) {
-    *target_file = fopen(file_path, "a+");
+    *target_file = fopen(file_path, (format == COCO_LOG_FORMAT_BINARY) ? "a+b" : "a+");
     errnum = errno;
     if (*target_file == NULL) {
       logger_bbob_error_io(*target_file, errnum);
     }
+    coco_flush_set_buffer(*target_file);
   }
 }
 
+/**
+ * Writes the header of a new run of the ${problem} to a data file
+ */
+static void logger_bbob_write_header(logger_bbob_t *logger, FILE *target_file, const coco_problem_t *problem) {
+  if (logger->format == COCO_LOG_FORMAT_BINARY)
+    coco_log_format_write_header(target_file, logger_bbob_number_of_columns(logger->number_of_variables),
+        logger->optimal_fvalue, problem->suite_dep_index, logger->instance_id, problem->problem_name);
+  else
+    fprintf(target_file, bbob_file_header_str, logger->optimal_fvalue);
+}
+
 /*
 static void logger_bbob_open_dataFile(FILE **target_file,
                                       const char *path,
@@ -202,109 +283,175 @@ static void logger_bbob_open_dataFile(FILE **target_file,
 }*/
 
 /**
- * Creates the index file fileName_prefix+problem_id+file_extension in
- * folde_path
+ * Chooses the index file fileName_prefix+function_id+first_instance+".info" in folder_path and the data
+ * files (dataFile_path+first_instance) of the logger. If the data files are open in another logger of the
+ * observer, a suffix is appended to keep the data of the two loggers apart. The caller holds the lock of
+ * the index bookkeeping.
  */
-static void logger_bbob_openIndexFile(logger_bbob_t *logger,
-                                      const char *folder_path,
-                                      const char *indexFile_prefix,
-                                      const char *function_id,
-                                      const char *dataFile_path) {
-  /* to add the instance number TODO: this should be done outside to avoid redoing this for the .*dat files */
+static void logger_bbob_choose_files(logger_bbob_t *logger,
+                                     const char *folder_path,
+                                     const char *indexFile_prefix,
+                                     const char *dataFile_path) {
+  observer_bbob_index_t *index = logger->index;
   char used_dataFile_path[COCO_PATH_MAX] = { 0 };
-  int errnum, newLine; /* newLine is at 1 if we need a new line in the info file */
-  char function_id_char[3]; /* TODO: consider adding them to logger */
   char file_name[COCO_PATH_MAX] = { 0 };
   char file_path[COCO_PATH_MAX] = { 0 };
-  FILE **target_file;
-  FILE *tmp_file;
-  strncpy(used_dataFile_path, dataFile_path, COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
-  if (bbob_infoFile_firstInstance == 0) {
-    bbob_infoFile_firstInstance = logger->instance_id;
+  char suffix[30];
+  size_t i, j, number;
+
+  if (index->infoFile_firstInstance == 0) {
+    index->infoFile_firstInstance = logger->instance_id;
   }
-  sprintf(function_id_char, "%lu", logger->function_id);
-  sprintf(bbob_infoFile_firstInstance_char, "%ld", bbob_infoFile_firstInstance);
-  target_file = &(logger->index_file);
-  tmp_file = NULL; /* to check whether the file already exists. Don't want to use target_file */
-  strncpy(file_name, indexFile_prefix, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, "_f", COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, function_id_char, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, "_i", COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, bbob_infoFile_firstInstance_char, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, ".info", COCO_PATH_MAX - strlen(file_name) - 1);
-  coco_join_path(file_path, sizeof(file_path), folder_path, file_name, NULL);
-  if (*target_file == NULL) {
-    tmp_file = fopen(file_path, "r"); /* to check for existence */
-    if ((tmp_file) && (bbob_current_dim == logger->number_of_variables)
-        && (bbob_current_funId == logger->function_id)) {
-        /* new instance of current funId and current dim */
-      newLine = 0;
-      *target_file = fopen(file_path, "a+");
-      if (*target_file == NULL) {
-        errnum = errno;
-        logger_bbob_error_io(*target_file, errnum);
+  if ((index->current_dim != logger->number_of_variables) || (index->current_funId != logger->function_id)) {
+    /* new dim or new funId, check that the dim was not already present earlier in the file, if so,
+     * create a new info file */
+    if (index->current_dim != logger->number_of_variables) {
+      for (i = 0;
+          i < OBSERVER_BBOB_NUMBER_OF_DIMENSIONS && index->dimensions_in_current_infoFile[i] != 0
+              && index->dimensions_in_current_infoFile[i] != logger->number_of_variables; i++) {
+        ; /* checks whether dimension already present in the current infoFile */
       }
-      fclose(tmp_file);
-    } else { /* either file doesn't exist (new funId) or new Dim */
-      /* check that the dim was not already present earlier in the file, if so, create a new info file */
-      if (bbob_current_dim != logger->number_of_variables) {
-        int i, j;
-        for (i = 0;
-            i < bbob_number_of_dimensions && bbob_dimensions_in_current_infoFile[i] != 0
-                && bbob_dimensions_in_current_infoFile[i] != logger->number_of_variables; i++) {
-          ; /* checks whether dimension already present in the current infoFile */
-        }
-        if (i < bbob_number_of_dimensions && bbob_dimensions_in_current_infoFile[i] == 0) {
-          /* new dimension seen for the first time */
-          bbob_dimensions_in_current_infoFile[i] = logger->number_of_variables;
-          newLine = 1;
-        } else {
-          if (i < bbob_number_of_dimensions) { /* dimension already present, need to create a new file */
-            newLine = 0;
-            file_path[strlen(file_path) - strlen(bbob_infoFile_firstInstance_char) - 7] = 0; /* truncate the instance part */
-            bbob_infoFile_firstInstance = logger->instance_id;
-            sprintf(bbob_infoFile_firstInstance_char, "%ld", bbob_infoFile_firstInstance);
-            strncat(file_path, "_i", COCO_PATH_MAX - strlen(file_name) - 1);
-            strncat(file_path, bbob_infoFile_firstInstance_char, COCO_PATH_MAX - strlen(file_name) - 1);
-            strncat(file_path, ".info", COCO_PATH_MAX - strlen(file_name) - 1);
-          } else {/*we have all dimensions*/
-            newLine = 1;
-          }
-          for (j = 0; j < bbob_number_of_dimensions; j++) { /* new info file, reinitialize list of dims */
-            bbob_dimensions_in_current_infoFile[j] = 0;
-          }
-          bbob_dimensions_in_current_infoFile[i] = logger->number_of_variables;
-        }
+      if (i < OBSERVER_BBOB_NUMBER_OF_DIMENSIONS && index->dimensions_in_current_infoFile[i] == 0) {
+        /* new dimension seen for the first time */
+        index->dimensions_in_current_infoFile[i] = logger->number_of_variables;
       } else {
-        if ( bbob_current_funId != logger->function_id ) {
-          /*new function in the same file */
-          newLine = 1;
+        if (i < OBSERVER_BBOB_NUMBER_OF_DIMENSIONS) { /* dimension already present, need to create a new file */
+          index->infoFile_firstInstance = logger->instance_id;
         }
-      }
-      *target_file = fopen(file_path, "a+"); /* in any case, we append */
-      if (*target_file == NULL) {
-        errnum = errno;
-        logger_bbob_error_io(*target_file, errnum);
-      }
-      if (tmp_file) { /* File already exists, new dim so just a new line. Also, close the tmp_file */
-        if (newLine) {
-          fprintf(*target_file, "\n");
+        for (j = 0; j < OBSERVER_BBOB_NUMBER_OF_DIMENSIONS; j++) { /* new info file, reinitialize list of dims */
+          index->dimensions_in_current_infoFile[j] = 0;
         }
-        fclose(tmp_file);
+        index->dimensions_in_current_infoFile[(i < OBSERVER_BBOB_NUMBER_OF_DIMENSIONS) ? i : 0] =
+            logger->number_of_variables;
       }
+    }
+    index->current_dim = logger->number_of_variables;
+    index->current_funId = logger->function_id;
+  }
+
+  sprintf(file_name, "%s_f%lu_i%lu.info", indexFile_prefix, (unsigned long) logger->function_id,
+      (unsigned long) index->infoFile_firstInstance);
+  coco_join_path(file_path, sizeof(file_path), folder_path, file_name, NULL);
+  logger->index_file_path = coco_strdup(file_path);
+
+  sprintf(suffix, "_i%lu", (unsigned long) index->infoFile_firstInstance);
+  strncpy(used_dataFile_path, dataFile_path, COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
+  strncat(used_dataFile_path, suffix, COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
+  logger->data_file = coco_strdup(used_dataFile_path);
+  for (number = 2; observer_bbob_index_is_open(index, logger->data_file); number++) {
+    coco_free_memory(logger->data_file);
+    logger->data_file = coco_strdupf("%s-%lu", used_dataFile_path, (unsigned long) number);
+  }
+  observer_bbob_index_open(index, logger->data_file);
+}
+
+/**
+ * Opens the index file ${index_file_path} for appending.
+ */
+static FILE *logger_bbob_open_index_file(const char *index_file_path) {
+  FILE *index_file;
+  int errnum;
+
+  index_file = fopen(index_file_path, "a+"); /* in any case, we append */
+  if (index_file == NULL) {
+    errnum = errno;
+    logger_bbob_error_io(index_file, errnum);
+  }
+  return index_file;
+}
 
-      fprintf(*target_file, "funcId = %d, DIM = %lu, Precision = %.3e, algId = '%s'\n",
-          (int) strtol(function_id, NULL, 10), logger->number_of_variables, pow(10, -8),
-          logger->observer->algorithm_name);
-      fprintf(*target_file, "%%\n");
-      strncat(used_dataFile_path, "_i", COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
-      strncat(used_dataFile_path, bbob_infoFile_firstInstance_char,
-      COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
-      fprintf(*target_file, "%s.dat", used_dataFile_path); /* dataFile_path does not have the extension */
-      bbob_current_dim = logger->number_of_variables;
-      bbob_current_funId = logger->function_id;
+/**
+ * Appends ${entry} to the index file. A new line with a header is started if the last line written to the
+ * index file belongs to another data file. The caller holds the lock of the index bookkeeping.
+ */
+static void logger_bbob_write_index_entry(observer_bbob_index_t *index,
+                                          const char *index_file_path,
+                                          const char *data_file,
+                                          const size_t function_id,
+                                          const size_t number_of_variables,
+                                          const char *entry) {
+  FILE *index_file;
+  int file_exists;
+
+  file_exists = coco_file_exists(index_file_path);
+  index_file = logger_bbob_open_index_file(index_file_path);
+  if (!file_exists || (index->last_index_file == NULL)
+      || (strcmp(index->last_index_file, index_file_path) != 0)
+      || (strcmp(index->last_data_file, data_file) != 0)) {
+    if (file_exists) { /* File already exists, so just a new line */
+      fprintf(index_file, "\n");
+    }
+    fprintf(index_file, "funcId = %d, DIM = %lu, Precision = %.3e, algId = '%s'\n", (int) function_id,
+        (unsigned long) number_of_variables, pow(10, -8), index->algorithm_name);
+    fprintf(index_file, "%%\n");
+    fprintf(index_file, "%s.dat", data_file); /* data_file does not have the extension */
+    if (index->last_index_file != NULL) {
+      coco_free_memory(index->last_index_file);
+      coco_free_memory(index->last_data_file);
     }
+    index->last_index_file = coco_strdup(index_file_path);
+    index->last_data_file = coco_strdup(data_file);
   }
+  fputs(entry, index_file);
+  fclose(index_file);
+}
+
+/**
+ * Writes the start of the entry of the run (", instance") to the index file when the logger is
+ * initialized, unless the entry of another logger is unfinished (see observer_bbob_index_t).
+ */
+static void logger_bbob_start_index_entry(logger_bbob_t *logger) {
+  observer_bbob_index_t *index = logger->index;
+  char entry[30];
+
+  observer_bbob_index_lock(index);
+  if (index->unfinished_entry_owner == NULL) {
+    sprintf(entry, ", %lu", (unsigned long) logger->instance_id);
+    logger_bbob_write_index_entry(index, logger->index_file_path, logger->data_file, logger->function_id,
+        logger->number_of_variables, entry);
+    index->unfinished_entry_owner = logger;
+  }
+  observer_bbob_index_unlock(index);
+}
+
+/**
+ * Finishes the entry of the run in the index file when the logger is freed. If the logger did not start
+ * its entry, the complete entry is written, or deferred while the entry of another logger is unfinished.
+ * Finishing an entry writes the deferred entries.
+ */
+static void logger_bbob_finish_index_entry(logger_bbob_t *logger) {
+  observer_bbob_index_t *index = logger->index;
+  observer_bbob_deferred_entry_t *deferred;
+  FILE *index_file;
+  char entry[100];
+
+  observer_bbob_index_lock(index);
+  if (index->unfinished_entry_owner == logger) {
+    index_file = logger_bbob_open_index_file(logger->index_file_path);
+    fprintf(index_file, ":%ld|%.1e", logger->number_of_evaluations, logger->best_fvalue - logger->optimal_fvalue);
+    fclose(index_file);
+    index->unfinished_entry_owner = NULL;
+    while ((deferred = index->first_deferred_entry) != NULL) {
+      logger_bbob_write_index_entry(index, deferred->index_file, deferred->data_file, deferred->function_id,
+          deferred->number_of_variables, deferred->entry);
+      index->first_deferred_entry = deferred->next;
+      coco_free_memory(deferred->index_file);
+      coco_free_memory(deferred->data_file);
+      coco_free_memory(deferred->entry);
+      coco_free_memory(deferred);
+    }
+    index->last_deferred_entry = NULL;
+  } else {
+    sprintf(entry, ", %lu:%ld|%.1e", (unsigned long) logger->instance_id, logger->number_of_evaluations,
+        logger->best_fvalue - logger->optimal_fvalue);
+    if (index->unfinished_entry_owner == NULL)
+      logger_bbob_write_index_entry(index, logger->index_file_path, logger->data_file, logger->function_id,
+          logger->number_of_variables, entry);
+    else
+      observer_bbob_index_defer(index, logger->index_file_path, logger->data_file, logger->function_id,
+          logger->number_of_variables, entry);
+  }
+  observer_bbob_index_unlock(index);
 }
 
 /**
@@ -341,25 +488,25 @@ static void logger_bbob_initialize(logger_bbob_t *logger, coco_problem_t *inner_
   strncat(dataFile_path, "_DIM", COCO_PATH_MAX - strlen(dataFile_path) - 1);
   strncat(dataFile_path, tmpc_dim, COCO_PATH_MAX - strlen(dataFile_path) - 1);
 
-  /* index/info file */
-  logger_bbob_openIndexFile(logger, logger->observer->output_folder, indexFile_prefix, tmpc_funId,
-      dataFile_path);
-  fprintf(logger->index_file, ", %ld", coco_problem_get_suite_dep_instance(inner_problem));
-  /* data files */
-  /* TODO: definitely improvable but works for now */
-  strncat(dataFile_path, "_i", COCO_PATH_MAX - strlen(dataFile_path) - 1);
-  strncat(dataFile_path, bbob_infoFile_firstInstance_char,
-  COCO_PATH_MAX - strlen(dataFile_path) - 1);
-  logger_bbob_open_dataFile(&(logger->fdata_file), logger->observer->output_folder, dataFile_path, ".dat");
-  fprintf(logger->fdata_file, bbob_file_header_str, logger->optimal_fvalue);
-
-  logger_bbob_open_dataFile(&(logger->tdata_file), logger->observer->output_folder, dataFile_path, ".tdat");
-  fprintf(logger->tdata_file, bbob_file_header_str, logger->optimal_fvalue);
-
-  logger_bbob_open_dataFile(&(logger->rdata_file), logger->observer->output_folder, dataFile_path, ".rdat");
-  fprintf(logger->rdata_file, bbob_file_header_str, logger->optimal_fvalue);
+  /* index/info file and data files */
+  observer_bbob_index_lock(logger->index);
+  logger_bbob_choose_files(logger, logger->observer->output_folder, indexFile_prefix, dataFile_path);
+  observer_bbob_index_unlock(logger->index);
+  logger_bbob_start_index_entry(logger);
+  logger_bbob_open_dataFile(&(logger->fdata_file), logger->observer->output_folder, logger->data_file, ".dat",
+      logger->format);
+  logger_bbob_write_header(logger, logger->fdata_file, inner_problem);
+
+  logger_bbob_open_dataFile(&(logger->tdata_file), logger->observer->output_folder, logger->data_file, ".tdat",
+      logger->format);
+  logger_bbob_write_header(logger, logger->tdata_file, inner_problem);
+
+  logger_bbob_open_dataFile(&(logger->rdata_file), logger->observer->output_folder, logger->data_file, ".rdat",
+      logger->format);
+  logger_bbob_write_header(logger, logger->rdata_file, inner_problem);
   /* TODO: manage duplicate filenames by either using numbers or raising an error */
   /* The coco_create_unique_path() function is available now! */
+  coco_flush_state_reset(&logger->flush_state);
   logger->is_initialized = 1;
 }
 
@@ -390,16 +537,16 @@ static void logger_bbob_evaluate(coco_problem_t *self, const double *x, double *
 
   /* Add sanity check for optimal f value */
   /* assert(y[0] >= logger->optimal_fvalue); */
-  if (!bbob_raisedOptValWarning && y[0] < logger->optimal_fvalue) {
+  if (!logger->raised_optimal_value_warning && y[0] < logger->optimal_fvalue) {
     coco_warning("Observed fitness is smaller than supposed optimal fitness.");
-    bbob_raisedOptValWarning = 1;
+    logger->raised_optimal_value_warning = 1;
   }
 
   /* Add a line in the .dat file for each logging target reached. */
   if (y[0] - logger->optimal_fvalue <= logger->f_trigger) {
 
     logger_bbob_write_data(logger->fdata_file, logger->number_of_evaluations, y[0], logger->best_fvalue,
-        logger->optimal_fvalue, x, self->number_of_variables);
+        logger->optimal_fvalue, x, self->number_of_variables, logger->format);
     logger_bbob_update_f_trigger(logger, y[0]);
   }
 
@@ -407,17 +554,22 @@ static void logger_bbob_evaluate(coco_problem_t *self, const double *x, double *
   if (logger->number_of_evaluations >= logger->t_trigger) {
     logger->written_last_eval = 1;
     logger_bbob_write_data(logger->tdata_file, logger->number_of_evaluations, y[0], logger->best_fvalue,
-        logger->optimal_fvalue, x, self->number_of_variables);
-    logger_bbob_update_t_trigger(logger, self->number_of_variables);
+        logger->optimal_fvalue, x, self->number_of_variables, logger->format);
+    logger_bbob_update_t_trigger(logger);
   }
 
-  /* Flush output so that impatient users can see progress. */
-  fflush(logger->fdata_file);
+  /* Flush output (according to the flush policy) so that impatient users can see progress. */
+  if (coco_flush_after_evaluation(&((observer_bbob_t *) logger->observer->data)->flush_policy,
+      &logger->flush_state)) {
+    fflush(logger->fdata_file);
+    fflush(logger->tdata_file);
+  }
 }
 
 /**
  * Also serves as a finalize run method so. Must be called at the end
- * of Each run to correctly fill the index file
+ * of Each run to correctly fill the index file. Closing the files flushes
+ * everything that is still buffered, whatever the flush policy.
  *
  * TODO: make sure it is called at the end of each run or move the
  * writing into files to another function
@@ -442,11 +594,11 @@ static void logger_bbob_free(void *stuff) {
    logger->path = NULL;
    }*/
 
-  if (logger->index_file != NULL) {
-    fprintf(logger->index_file, ":%ld|%.1e", logger->number_of_evaluations,
-        logger->best_fvalue - logger->optimal_fvalue);
-    fclose(logger->index_file);
-    logger->index_file = NULL;
+  if (logger->is_initialized) {
+    logger_bbob_finish_index_entry(logger);
+    observer_bbob_index_lock(logger->index);
+    observer_bbob_index_close(logger->index, logger->data_file);
+    observer_bbob_index_unlock(logger->index);
   }
   if (logger->fdata_file != NULL) {
     fclose(logger->fdata_file);
@@ -460,7 +612,8 @@ static void logger_bbob_free(void *stuff) {
      */
     if (!logger->written_last_eval) {
       logger_bbob_write_data(logger->tdata_file, logger->number_of_evaluations, logger->last_fvalue,
-          logger->best_fvalue, logger->optimal_fvalue, logger->best_solution, logger->number_of_variables);
+          logger->best_fvalue, logger->optimal_fvalue, logger->best_solution, logger->number_of_variables,
+          logger->format);
     }
     fclose(logger->tdata_file);
     logger->tdata_file = NULL;
@@ -475,7 +628,19 @@ static void logger_bbob_free(void *stuff) {
     coco_free_memory(logger->best_solution);
     logger->best_solution = NULL;
   }
-  bbob_logger_is_open = 0;
+  if (logger->t_ladder != NULL) {
+    coco_free_memory(logger->t_ladder);
+    logger->t_ladder = NULL;
+  }
+  if (logger->index_file_path != NULL) {
+    coco_free_memory(logger->index_file_path);
+    logger->index_file_path = NULL;
+  }
+  if (logger->data_file != NULL) {
+    coco_free_memory(logger->data_file);
+    logger->data_file = NULL;
+  }
+  observer_bbob_index_release(logger->index);
 }
 
 static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *problem) {
@@ -490,11 +655,14 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *pr
         problem->number_of_objectives);
   }
 
-  if (bbob_logger_is_open)
-    coco_error("The current bbob_logger (observer) must be closed before a new one is opened");
   /* This is the name of the folder which happens to be the algName */
   /*logger->path = coco_strdup(observer->output_folder);*/
-  logger->index_file = NULL;
+  logger->index = ((observer_bbob_t *) observer->data)->index;
+  observer_bbob_index_lock(logger->index);
+  logger->index->number_of_references++;
+  observer_bbob_index_unlock(logger->index);
+  logger->index_file_path = NULL;
+  logger->data_file = NULL;
   logger->fdata_file = NULL;
   logger->tdata_file = NULL;
   logger->rdata_file = NULL;
@@ -507,11 +675,12 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *pr
   } else {
     logger->optimal_fvalue = *(problem->best_value);
   }
-  bbob_raisedOptValWarning = 0;
+  logger->raised_optimal_value_warning = 0;
 
   logger->idx_f_trigger = INT_MAX;
   logger->idx_t_trigger = 0;
-  logger->idx_tdim_trigger = 0;
+  logger_bbob_compute_t_ladder(logger, ((observer_bbob_t *) observer->data)->bbob_nbpts_nbevals,
+      problem->number_of_variables);
   logger->f_trigger = DBL_MAX;
   logger->t_trigger = 0;
   logger->number_of_evaluations = 0;
@@ -525,11 +694,11 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *pr
   logger->written_last_eval = 1;
   logger->last_fvalue = DBL_MAX;
   logger->is_initialized = 0;
+  logger->format = ((observer_bbob_t *) observer->data)->format;
 
   self = coco_transformed_allocate(problem, logger, logger_bbob_free);
 
   self->evaluate_function = logger_bbob_evaluate;
-  bbob_logger_is_open = 1;
   return self;
 }
 
@@ -1,5 +1,7 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <assert.h>
 
 #include "coco.h"
@@ -8,9 +10,12 @@
 #include "coco_utilities.c"
 #include "coco_problem.c"
 #include "coco_string.c"
+#include "coco_format.c"
+#include "coco_log_format.c"
 #include "observer_biobj.c"
 
-#include "logger_biobj_avl_tree.c"
+#include "logger_biobj_archive.c"
+#include "logger_biobj_pool.c"
 #include "mo_generics.c"
 #include "mo_targets.c"
 
@@ -20,9 +25,11 @@
  */
 
 /* Data for each indicator */
-typedef struct {
-  /* Name of the indicator to be used for identification and in the output */
-  char *name;
+struct logger_biobj_indicator_s {
+  /* Type of the indicator (its name is used for identification and in the output) */
+  const observer_biobj_indicator_type_t *type;
+  /* The index of the indicator in the logger and of its contributions in the solutions of the archive */
+  size_t number;
 
   /* File for logging indicator values at target hits */
   FILE *log_file;
@@ -43,16 +50,40 @@ typedef struct {
 
   size_t next_output_evaluation_num;
 
-} logger_biobj_indicator_t;
+  /* Data specific to the type of the indicator */
+  void *data;
 
-/* Data for the biobjective logger */
+};
+
+/* Data on a solution in the archive (x, y and the indicator contributions are stored in the same block of the
+ * item pool, right after the item; x is NULL if the decision variables are not stored) */
 typedef struct {
+  const double *x;
+  double *y;
+  size_t time_stamp;
+
+  /* The contribution of this solution to the overall indicator values (for indicators that need it) */
+  double *indicator_contribution;
+  /* Whether the solution is within the region of interest (ROI) */
+  int within_ROI;
+  /* The distance of the solution to the ROI (0 for solutions strictly within the ROI, negative if it has not
+   * been computed) */
+  double distance_to_ROI;
+  /* The position of the solution in the heap of a bounded archive */
+  size_t heap_index;
+
+} logger_biobj_item_t;
+
+/* Data for the biobjective logger */
+struct logger_biobj_s {
   /* To access options read by the general observer */
   coco_observer_t *observer;
 
   observer_biobj_log_nondom_e log_nondom_mode;
   /* File for logging nondominated solutions (either all or final) */
   FILE *nondom_file;
+  /* Format of the indicator and nondominated solutions files */
+  coco_log_format_t format;
 
   /* Whether to log the decision variables */
   int log_vars;
@@ -63,79 +94,160 @@ typedef struct {
   size_t number_of_variables;
   size_t number_of_objectives;
   size_t suite_dep_instance;
-
-  /* The tree keeping currently non-dominated solutions */
-  avl_tree_t *archive_tree;
-  /* The tree with pointers to nondominated solutions that haven't been logged yet */
-  avl_tree_t *buffer_tree;
-
-  /* Indicators (TODO: Implement others!) */
+  /* The next evaluation that is always logged (see coco_observer_next_evaluation_to_log()) */
+  size_t next_evaluation_to_log;
+
+  /* The archive keeping currently non-dominated solutions (sorted by the last objective) */
+  logger_biobj_archive_t *archive;
+  /* The pool for the solutions (with their x and y) */
+  logger_biobj_pool_t *item_pool;
+  /* Whether the decision variables are stored in the archive (only needed for the output of the final
+   * nondominated solutions) */
+  int store_x;
+
+  /* Maximal number of solutions in the archive (0 if unbounded) and, for a bounded archive, a binary heap of
+   * its solutions ordered by their hypervolume contributions (which are maintained by the hyp indicator with
+   * the given number) */
+  size_t archive_max_size;
+  logger_biobj_item_t **heap;
+  size_t heap_size;
+  size_t hyp_number;
+
+  /* Indicators */
   int compute_indicators;
   logger_biobj_indicator_t *indicators[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS];
+  size_t number_of_indicators;
 
-} logger_biobj_t;
+  /* The minimal distance from the archive to the ROI, maintained with the archive when the indicators are
+   * computed (until it reaches 0). If the solution attaining it was removed, ROI_distance is only a lower
+   * bound and ROI_distance_is_exact is 0 (until a solution at least as close is inserted or the distance is
+   * recomputed). */
+  double ROI_distance;
+  int ROI_distance_is_exact;
 
-/* Data contained in the node's item in the AVL tree */
-typedef struct {
-  double *x;
-  double *y;
-  size_t time_stamp;
-
-  /* The contribution of this solution to the overall indicator values */
-  double indicator_contribution[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS];
-  /* Whether the solution is within the region of interest (ROI) */
-  int within_ROI;
-
-} logger_biobj_avl_item_t;
+};
 
 /**
- * Creates and returns the information on the solution in the form of a node's item in the AVL tree.
+ * Creates and returns the information on the solution in the form of an item of the archive. The item is
+ * taken from the item pool of the logger.
  */
-static logger_biobj_avl_item_t* logger_biobj_node_create(const double *x,
+static logger_biobj_item_t* logger_biobj_node_create(logger_biobj_t *logger,
+                                                         const double *x,
                                                          const double *y,
-                                                         const size_t time_stamp,
-                                                         const size_t dim,
-                                                         const size_t num_obj) {
+                                                         const size_t time_stamp) {
 
   size_t i;
 
-  /* Allocate memory to hold the data structure logger_biobj_node_t */
-  logger_biobj_avl_item_t *item = (logger_biobj_avl_item_t*) coco_allocate_memory(sizeof(*item));
-
-  /* Allocate memory to store the (copied) data of the new node */
-  item->x = coco_allocate_vector(dim);
-  item->y = coco_allocate_vector(num_obj);
+  /* Take a block of the item pool, which holds the item followed by the (copied) data of the new node */
+  logger_biobj_item_t *item = (logger_biobj_item_t*) logger_biobj_pool_allocate(logger->item_pool);
+  double *stored_x = (double *) (item + 1);
+  item->x = NULL;
+  item->y = stored_x;
+  if (logger->store_x) {
+    item->x = stored_x;
+    item->y = stored_x + logger->number_of_variables;
+  }
+  item->indicator_contribution = item->y + logger->number_of_objectives;
 
   /* Copy the data */
-  for (i = 0; i < dim; i++)
-    item->x[i] = x[i];
-  for (i = 0; i < num_obj; i++)
+  if (logger->store_x) {
+    for (i = 0; i < logger->number_of_variables; i++)
+      stored_x[i] = x[i];
+  }
+  for (i = 0; i < logger->number_of_objectives; i++)
     item->y[i] = y[i];
   item->time_stamp = time_stamp;
-  for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++)
+  for (i = 0; i < logger->number_of_indicators; i++)
     item->indicator_contribution[i] = 0;
   item->within_ROI = 0;
+  item->distance_to_ROI = -1;
   return item;
 }
 
 /**
- * Frees the data of the given logger_biobj_avl_item_t.
+ * Gives the given logger_biobj_item_t back to the item pool of the logger.
+ */
+static void logger_biobj_node_free(logger_biobj_t *logger, logger_biobj_item_t *item) {
+
+  logger_biobj_pool_deallocate(logger->item_pool, item);
+}
+
+/**
+ * Returns whether the item ${a} is to be removed from a bounded archive before the item ${b}, i.e., whether
+ * its hypervolume contribution is smaller (among solutions outside the ROI, which do not contribute, the ones
+ * further from the ROI are removed first).
+ */
+static int logger_biobj_heap_is_before(const logger_biobj_t *logger,
+                                       const logger_biobj_item_t *a,
+                                       const logger_biobj_item_t *b) {
+
+  const size_t k = logger->hyp_number;
+
+  if (a->indicator_contribution[k] != b->indicator_contribution[k])
+    return a->indicator_contribution[k] < b->indicator_contribution[k];
+  return a->distance_to_ROI > b->distance_to_ROI;
+}
+
+/**
+ * Moves the item at position ${index} of the heap up or down to its place after its key has changed.
+ */
+static void logger_biobj_heap_sift(logger_biobj_t *logger, size_t index) {
+
+  logger_biobj_item_t **heap = logger->heap;
+  logger_biobj_item_t *item = heap[index];
+  size_t child;
+
+  while ((index > 0) && logger_biobj_heap_is_before(logger, item, heap[(index - 1) / 2])) {
+    heap[index] = heap[(index - 1) / 2];
+    heap[index]->heap_index = index;
+    index = (index - 1) / 2;
+  }
+  while ((child = 2 * index + 1) < logger->heap_size) {
+    if ((child + 1 < logger->heap_size) && logger_biobj_heap_is_before(logger, heap[child + 1], heap[child]))
+      child++;
+    if (!logger_biobj_heap_is_before(logger, heap[child], item))
+      break;
+    heap[index] = heap[child];
+    heap[index]->heap_index = index;
+    index = child;
+  }
+  heap[index] = item;
+  item->heap_index = index;
+}
+
+/**
+ * Adds the item to the heap.
  */
-static void logger_biobj_node_free(logger_biobj_avl_item_t *item, void *userdata) {
+static void logger_biobj_heap_push(logger_biobj_t *logger, logger_biobj_item_t *item) {
 
-  coco_free_memory(item->x);
-  coco_free_memory(item->y);
-  coco_free_memory(item);
-  (void) userdata; /* To silence the compiler */
+  assert(logger->heap_size <= logger->archive_max_size);
+  logger->heap[logger->heap_size] = item;
+  item->heap_index = logger->heap_size++;
+  logger_biobj_heap_sift(logger, item->heap_index);
 }
 
 /**
- * Checks if the given node is smaller than the reference point, and stores this information in the node's
+ * Removes the item from the heap.
+ */
+static void logger_biobj_heap_remove(logger_biobj_t *logger, logger_biobj_item_t *item) {
+
+  const size_t index = item->heap_index;
+
+  assert(logger->heap[index] == item);
+  logger->heap_size--;
+  if (index < logger->heap_size) {
+    logger->heap[index] = logger->heap[logger->heap_size];
+    logger->heap[index]->heap_index = index;
+    logger_biobj_heap_sift(logger, index);
+  }
+}
+
+/**
+ * Checks if the given item is smaller than the reference point, and stores this information in the
  * item->within_ROI field.
  */
-static void logger_biobj_check_if_within_ROI(coco_problem_t *problem, avl_node_t *node) {
+static void logger_biobj_check_if_within_ROI(coco_problem_t *problem, logger_biobj_item_t *node_item) {
 
-  logger_biobj_avl_item_t *node_item = (logger_biobj_avl_item_t *) node->item;
   size_t i;
 
   node_item->within_ROI = 1;
@@ -145,38 +257,27 @@ static void logger_biobj_check_if_within_ROI(coco_problem_t *problem, avl_node_t
       break;
     }
 
-  if (!node_item->within_ROI)
-    for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++)
-      node_item->indicator_contribution[i] = 0;
-
   return;
 }
 
 /**
- * Defines the ordering of AVL tree nodes based on the value of the last objective.
+ * Returns the distance of the given solution to the ROI (see mo_get_distance_to_ROI()), which is 0 if the
+ * solution is strictly within the ROI.
  */
-static int avl_tree_compare_by_last_objective(const logger_biobj_avl_item_t *item1,
-                                              const logger_biobj_avl_item_t *item2,
-                                              void *userdata) {
-  /* This ordering is used by the archive_tree. */
+static double logger_biobj_get_distance_to_ROI(coco_problem_t *problem, const double *y) {
 
-  if (item1->y[1] < item2->y[1])
-    return -1;
-  else if (item1->y[1] > item2->y[1])
-    return 1;
-  else
+  if ((y[0] < problem->nadir_value[0]) && (y[1] < problem->nadir_value[1]))
     return 0;
-
-  (void) userdata; /* To silence the compiler */
+  return mo_get_distance_to_ROI(y, problem->best_value, problem->nadir_value, problem->number_of_objectives);
 }
 
 /**
- * Defines the ordering of AVL tree nodes based on the time stamp.
+ * Defines the ordering of items based on the time stamp (for qsort()).
  */
-static int avl_tree_compare_by_time_stamp(const logger_biobj_avl_item_t *item1,
-                                          const logger_biobj_avl_item_t *item2,
-                                          void *userdata) {
-  /* This ordering is used by the buffer_tree. */
+static int logger_biobj_compare_by_time_stamp(const void *a, const void *b) {
+
+  const logger_biobj_item_t *item1 = *(const logger_biobj_item_t * const *) a;
+  const logger_biobj_item_t *item2 = *(const logger_biobj_item_t * const *) b;
 
   if (item1->time_stamp < item2->time_stamp)
     return -1;
@@ -184,204 +285,578 @@ static int avl_tree_compare_by_time_stamp(const logger_biobj_avl_item_t *item1,
     return 1;
   else
     return 0;
-
-  (void) userdata; /* To silence the compiler */
 }
 
 /**
- * Outputs the AVL tree to the given file. Returns the number of nodes in the tree.
+ * Outputs the given items to the given file.
+ *
+ * Each line is formatted with coco_format_exponential() into a buffer (the output is the same as with
+ * fprintf(file, "%.*e\t", ...)) and written at once. In the binary format, the same numbers are written
+ * as a record of doubles.
  */
-static size_t logger_biobj_tree_output(FILE *file,
-                                       avl_tree_t *tree,
-                                       const size_t dim,
-                                       const size_t num_obj,
-                                       const int log_vars,
-                                       const int precision_x,
-                                       const int precision_f) {
-
-  avl_node_t *solution;
+static void logger_biobj_output(FILE *file,
+                                logger_biobj_item_t **items,
+                                const size_t number_of_items,
+                                const size_t dim,
+                                const size_t num_obj,
+                                const int log_vars,
+                                const int precision_x,
+                                const int precision_f,
+                                const coco_log_format_t format) {
+
+  logger_biobj_item_t *item;
   size_t i;
   size_t j;
-  size_t number_of_nodes = 0;
-
-  if (tree->tail) {
-    /* There is at least a solution in the tree to output */
-    solution = tree->head;
-    while (solution != NULL) {
-      fprintf(file, "%lu\t", ((logger_biobj_avl_item_t*) solution->item)->time_stamp);
-      for (j = 0; j < num_obj; j++)
-        fprintf(file, "%.*e\t", precision_f, ((logger_biobj_avl_item_t*) solution->item)->y[j]);
+  size_t k;
+  char *line;
+  double *record;
+  size_t length;
+
+  if (number_of_items > 0) {
+    record = coco_allocate_vector(num_obj + dim + 1);
+    line = (char *) coco_allocate_memory((num_obj + dim + 1) * (COCO_FORMAT_BUFFER_SIZE + 1) + 1);
+    for (k = 0; k < number_of_items; k++) {
+      item = items[k];
+      if (format == COCO_LOG_FORMAT_BINARY) {
+        record[0] = (double) item->time_stamp;
+        memcpy(record + 1, item->y, num_obj * sizeof(double));
+        if (log_vars)
+          memcpy(record + 1 + num_obj, item->x, dim * sizeof(double));
+        coco_log_format_write_record(file, record, 1 + num_obj + (log_vars ? dim : 0));
+        continue;
+      }
+      length = coco_format_unsigned_long(line, item->time_stamp);
+      line[length++] = '\t';
+      for (j = 0; j < num_obj; j++) {
+        length += coco_format_exponential(line + length, item->y[j], 0, precision_f, 0);
+        line[length++] = '\t';
+      }
       if (log_vars) {
-        for (i = 0; i < dim; i++)
-          fprintf(file, "%.*e\t", precision_x, ((logger_biobj_avl_item_t*) solution->item)->x[i]);
+        for (i = 0; i < dim; i++) {
+          length += coco_format_exponential(line + length, item->x[i], 0, precision_x, 0);
+          line[length++] = '\t';
+        }
       }
-      fprintf(file, "\n");
-      solution = solution->next;
-      number_of_nodes++;
+      line[length++] = '\n';
+      fwrite(line, 1, length, file);
     }
+    coco_free_memory(line);
+    coco_free_memory(record);
   }
-
-  return number_of_nodes;
 }
 
 /**
- * Checks for domination and updates the archive tree and the values of the indicators if the given node is
- * not weakly dominated by existing nodes in the archive tree.
- * Returns 1 if the update was performed and 0 otherwise.
+ * Checks for domination and updates the archive and the values of the indicators if the given solution is
+ * not weakly dominated by existing solutions in the archive. The item for the solution is only created if
+ * the update is performed, so that dominated solutions (the vast majority late in a run) cost no allocation
+ * and copying.
+ * Returns the new item if the update was performed and NULL otherwise.
  */
-static int logger_biobj_tree_update(logger_biobj_t *logger,
-                                    coco_problem_t *problem,
-                                    logger_biobj_avl_item_t *node_item) {
-
-  avl_node_t *node, *next_node, *new_node;
-  int trigger_update = 0;
+static logger_biobj_item_t *logger_biobj_update_archive(logger_biobj_t *logger,
+                                                     coco_problem_t *problem,
+                                                     const double *x,
+                                                     const double *y) {
+
+  logger_biobj_archive_t *archive = logger->archive;
+  logger_biobj_archive_entry_t *entry;
+  logger_biobj_item_t *node_item;
+  size_t position, first, last, size;
   int dominance;
   size_t i;
-  int previous_unavailable = 0;
 
-  /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
-  node = avl_item_search_right(logger->archive_tree, node_item, NULL);
+  /* Find the first point that is worse in the last objective than the new point. Only the point before it
+   * (the last one that is not worse) can dominate the new point. */
+  size = logger_biobj_archive_size(archive);
+  position = logger_biobj_archive_locate(archive, y[1]);
+  first = position;
+  if (position > 0) {
+    entry = logger_biobj_archive_get(archive, position - 1);
+    dominance = mo_get_dominance(y, entry->y, logger->number_of_objectives);
+    if (dominance <= -1) {
+      /* The new point is dominated, nothing more to do */
+      return NULL;
+    }
+    if (dominance == 1) {
+      /* The new point dominates the previous point (with the same last objective), remove it as well */
+      first = position - 1;
+    }
+  }
 
-  if (node == NULL) {
-    /* The new point is an extremal point */
-    trigger_update = 1;
-    next_node = logger->archive_tree->head;
-  } else {
-    dominance = mo_get_dominance(node_item->y, ((logger_biobj_avl_item_t*) node->item)->y,
-        logger->number_of_objectives);
-    if (dominance > -1) {
-      trigger_update = 1;
-      next_node = node->next;
-      if (dominance == 1) {
-        /* The new point dominates the next point, remove the next point */
-        if (logger->compute_indicators) {
-          for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            logger->indicators[i]->current_value -= ((logger_biobj_avl_item_t*) node->item)->indicator_contribution[i];
-          }
-        }
-        avl_item_delete(logger->buffer_tree, node->item);
-        avl_node_delete(logger->archive_tree, node);
+  /* The points dominated by the new point form a contiguous range starting at first. There are only two
+   * possibilities for the points after the position:
+   * dominance = 0: the new point and the point are nondominated (and so are all further points)
+   * dominance = 1: the new point dominates the point */
+  last = position;
+  while ((last < size) && (mo_get_dominance(y, logger_biobj_archive_get(archive, last)->y,
+      logger->number_of_objectives) == 1))
+    last++;
+
+  /* Perform the archive update */
+  for (i = first; i < last; i++) {
+    logger_biobj_item_t *removed_item = (logger_biobj_item_t *) logger_biobj_archive_get(archive, i)->item;
+    if (logger->compute_indicators) {
+      size_t j;
+      for (j = 0; j < logger->number_of_indicators; j++) {
+        logger->indicators[j]->type->on_remove(logger->indicators[j], logger, problem, i, 1);
       }
-    } else {
-      /* The new point is dominated, nothing more to do */
-      trigger_update = 0;
+      if (removed_item->distance_to_ROI <= logger->ROI_distance)
+        logger->ROI_distance_is_exact = 0;
+      if (logger->archive_max_size > 0)
+        logger_biobj_heap_remove(logger, removed_item);
     }
+    logger_biobj_node_free(logger, removed_item);
   }
+  node_item = logger_biobj_node_create(logger, x, y, logger->number_of_evaluations);
+  logger_biobj_archive_replace(archive, first, last - first, y, node_item);
+
+  if (logger->compute_indicators) {
+    /* Update the distance to the ROI (the remaining solutions are at least ROI_distance away). Once it is 0,
+     * the distance is not needed any more (unless solutions within the ROI are removed without replacement,
+     * in which case it is recomputed). In a bounded archive, the distance of each solution is also used to
+     * order the heap. */
+    if ((logger->ROI_distance > 0) || (logger->archive_max_size > 0)) {
+      node_item->distance_to_ROI = logger_biobj_get_distance_to_ROI(problem, y);
+      if (node_item->distance_to_ROI <= logger->ROI_distance) {
+        logger->ROI_distance = node_item->distance_to_ROI;
+        logger->ROI_distance_is_exact = 1;
+      }
+    }
 
-  if (!trigger_update) {
-    logger_biobj_node_free(node_item, NULL);
+    logger_biobj_check_if_within_ROI(problem, node_item);
+    for (i = 0; i < logger->number_of_indicators; i++) {
+      logger->indicators[i]->type->on_insert(logger->indicators[i], logger, problem, first);
+    }
+
+    if (logger->archive_max_size > 0) {
+      /* Update the place of the next solution, whose contribution changed, and add the new solution to the
+       * heap (in this order, as the heap can only be repaired one changed solution at a time) */
+      if (first + 1 < logger_biobj_archive_size(archive))
+        logger_biobj_heap_sift(logger,
+            ((logger_biobj_item_t *) logger_biobj_archive_get(archive, first + 1)->item)->heap_index);
+      logger_biobj_heap_push(logger, node_item);
+    }
+  }
+
+  return node_item;
+}
+
+/**
+ * Returns the minimal distance from the archive to the ROI, which only needs to be recomputed if the solution
+ * attaining it was removed.
+ */
+static double logger_biobj_get_ROI_distance(logger_biobj_t *logger, coco_problem_t *problem) {
+
+  logger_biobj_item_t *item;
+  size_t i;
+
+  if (!logger->ROI_distance_is_exact) {
+    logger->ROI_distance = DBL_MAX;
+    for (i = 0; i < logger_biobj_archive_size(logger->archive); i++) {
+      item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, i)->item;
+      if (item->distance_to_ROI < 0)
+        item->distance_to_ROI = logger_biobj_get_distance_to_ROI(problem, item->y);
+      logger->ROI_distance = coco_min_double(logger->ROI_distance, item->distance_to_ROI);
+    }
+    logger->ROI_distance_is_exact = 1;
+  }
+  return logger->ROI_distance;
+}
+
+/**
+ * Sets the best known value of the hypervolume indicator for the problem.
+ */
+static void logger_biobj_hyp_initialize(logger_biobj_indicator_t *indicator,
+                                        logger_biobj_t *logger,
+                                        coco_problem_t *problem) {
+
+  indicator->best_value = suite_biobj_get_best_value(indicator->type->name, problem->problem_id);
+  (void) logger; /* unused */
+}
+
+/**
+ * Computes the hypervolume contribution of the solution at the given position of the archive (the normalized
+ * box between the solution, the previous solution and the reference point) and updates the contribution of
+ * the next solution, whose box is now bounded by the new solution. Only solutions within the ROI contribute.
+ */
+static void logger_biobj_hyp_on_insert(logger_biobj_indicator_t *indicator,
+                                       logger_biobj_t *logger,
+                                       coco_problem_t *problem,
+                                       const size_t position) {
+
+  logger_biobj_item_t *node_item, *next_item, *previous_item;
+  const size_t k = indicator->number;
+  double bound;
+
+  node_item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position)->item;
+  if (!node_item->within_ROI)
+    return;
+
+  if (position + 1 < logger_biobj_archive_size(logger->archive)) {
+    next_item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position + 1)->item;
+    if (next_item->within_ROI) {
+      indicator->current_value -= next_item->indicator_contribution[k];
+      next_item->indicator_contribution[k] = (node_item->y[0] - next_item->y[0])
+          / (problem->nadir_value[0] - problem->best_value[0])
+          * (problem->nadir_value[1] - next_item->y[1])
+          / (problem->nadir_value[1] - problem->best_value[1]);
+      indicator->current_value += next_item->indicator_contribution[k];
+    }
+  }
+
+  /* If the previous item does not exist or is out of ROI, use the reference point instead */
+  bound = problem->nadir_value[0];
+  if (position > 0) {
+    previous_item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position - 1)->item;
+    if (previous_item->within_ROI)
+      bound = previous_item->y[0];
+  }
+  node_item->indicator_contribution[k] = (bound - node_item->y[0])
+      / (problem->nadir_value[0] - problem->best_value[0])
+      * (problem->nadir_value[1] - node_item->y[1])
+      / (problem->nadir_value[1] - problem->best_value[1]);
+  indicator->current_value += node_item->indicator_contribution[k];
+}
+
+/**
+ * Subtracts the contribution of the removed solution from the hypervolume. If the solution was not dominated,
+ * the box of the next solution grows up to the previous solution (or the reference point), otherwise the
+ * contribution of the next solution is updated when the dominating solution is inserted.
+ */
+static void logger_biobj_hyp_on_remove(logger_biobj_indicator_t *indicator,
+                                       logger_biobj_t *logger,
+                                       coco_problem_t *problem,
+                                       const size_t position,
+                                       const int is_dominated) {
+
+  logger_biobj_item_t *item, *next_item, *previous_item;
+  const size_t k = indicator->number;
+  double bound;
+
+  item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position)->item;
+  indicator->current_value -= item->indicator_contribution[k];
+  if (is_dominated || !item->within_ROI || (position + 1 >= logger_biobj_archive_size(logger->archive)))
+    return;
+
+  next_item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position + 1)->item;
+  if (!next_item->within_ROI)
+    return;
+  bound = problem->nadir_value[0];
+  if (position > 0) {
+    previous_item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position - 1)->item;
+    if (previous_item->within_ROI)
+      bound = previous_item->y[0];
+  }
+  indicator->current_value -= next_item->indicator_contribution[k];
+  next_item->indicator_contribution[k] = (bound - next_item->y[0])
+      / (problem->nadir_value[0] - problem->best_value[0])
+      * (problem->nadir_value[1] - next_item->y[1])
+      / (problem->nadir_value[1] - problem->best_value[1]);
+  indicator->current_value += next_item->indicator_contribution[k];
+}
+
+/**
+ * Returns the difference between the best known and the current hypervolume. If no solution is within the
+ * ROI, the minimal distance from the archive to the ROI is added as a penalty.
+ */
+static double logger_biobj_hyp_value(logger_biobj_indicator_t *indicator,
+                                     logger_biobj_t *logger,
+                                     coco_problem_t *problem) {
+
+  if (indicator->current_value == 0) {
+    indicator->additional_penalty = logger_biobj_get_ROI_distance(logger, problem);
+    assert(indicator->additional_penalty >= 0);
   } else {
-    /* Perform tree update */
-    while (next_node != NULL) {
-      /* Check the dominance relation between the new node and the next node. There are only two possibilities:
-       * dominance = 0: the new node and the next node are nondominated
-       * dominance = 1: the new node dominates the next node */
-      node = next_node;
-      dominance = mo_get_dominance(node_item->y, ((logger_biobj_avl_item_t*) node->item)->y,
-          logger->number_of_objectives);
-      if (dominance == 1) {
-        /* The new point dominates the next point, remove the next point */
-        if (logger->compute_indicators) {
-          for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            logger->indicators[i]->current_value -= ((logger_biobj_avl_item_t*) node->item)->indicator_contribution[i];
-          }
-        }
-        next_node = node->next;
-        avl_item_delete(logger->buffer_tree, node->item);
-        avl_node_delete(logger->archive_tree, node);
-      } else {
+    indicator->additional_penalty = 0;
+  }
+  return indicator->best_value - indicator->current_value + indicator->additional_penalty;
+}
+
+/* Data of the indicators computed with respect to a reference set (igdp and eps) */
+typedef struct {
+  size_t number_of_points;
+  /* The normalized objective vectors of the reference points (one after the other) */
+  double *points;
+  /* For each reference point, the smallest distance (as defined by the indicator) to the archive */
+  double *distances;
+  /* Whether the distances are exact (they need to be recomputed after removals of nondominated solutions) */
+  int distances_are_exact;
+} logger_biobj_reference_set_t;
+
+/**
+ * Reads the reference set of the problem from the file <problem_id>.txt in the given folder into the given
+ * vector (allocated here) and returns the number of points, or 0 if the file does not exist.
+ */
+static size_t logger_biobj_reference_set_read(const char *folder, const char *problem_id, double **points) {
+
+  FILE *file;
+  char *path_name, *file_name;
+  char line[COCO_PATH_MAX];
+  double y[2];
+  size_t number_of_points = 0;
+  int pass;
+
+  path_name = (char *) coco_allocate_memory(COCO_PATH_MAX);
+  memcpy(path_name, folder, strlen(folder) + 1);
+  file_name = coco_strdupf("%s.txt", problem_id);
+  coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
+  coco_free_memory(file_name);
+  file = fopen(path_name, "r");
+  if (file == NULL) {
+    coco_warning("logger_biobj_reference_set_read(): could not open file '%s'", path_name);
+    coco_free_memory(path_name);
+    return 0;
+  }
+
+  /* Count the points in the first pass and store them in the second one */
+  for (pass = 0; pass < 2; pass++) {
+    if (pass == 1) {
+      if (number_of_points == 0)
         break;
+      *points = coco_allocate_vector(2 * number_of_points);
+      number_of_points = 0;
+      rewind(file);
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {
+      if ((line[0] == '%') || (sscanf(line, "%lf %lf", &y[0], &y[1]) != 2))
+        continue;
+      if (pass == 1) {
+        (*points)[2 * number_of_points] = y[0];
+        (*points)[2 * number_of_points + 1] = y[1];
       }
+      number_of_points++;
     }
+  }
+  if (number_of_points == 0)
+    coco_warning("logger_biobj_reference_set_read(): no points found in file '%s'", path_name);
 
-    new_node = avl_item_insert(logger->archive_tree, node_item);
-    avl_item_insert(logger->buffer_tree, node_item);
+  fclose(file);
+  coco_free_memory(path_name);
+  return number_of_points;
+}
 
-    if (logger->compute_indicators) {
-      logger_biobj_check_if_within_ROI(problem, new_node);
-      if (node_item->within_ROI) {
-        /* Compute indicator value for new node and update the indicator value of the affected nodes */
-        logger_biobj_avl_item_t *next_item, *previous_item;
-
-        if (new_node->next != NULL) {
-          next_item = (logger_biobj_avl_item_t*) new_node->next->item;
-          if (next_item->within_ROI) {
-            for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-              logger->indicators[i]->current_value -= next_item->indicator_contribution[i];
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-                next_item->indicator_contribution[i] = (node_item->y[0] - next_item->y[0])
-                    / (problem->nadir_value[0] - problem->best_value[0])
-                    * (problem->nadir_value[1] - next_item->y[1])
-                    / (problem->nadir_value[1] - problem->best_value[1]);
-              } else {
-                coco_error(
-                    "logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                    logger->indicators[i]->name);
-              }
-              logger->indicators[i]->current_value += next_item->indicator_contribution[i];
-            }
-          }
-        }
+/**
+ * Initializes the reference set of the indicator (see observer_biobj()) and normalizes it in the same way as
+ * the solutions. The best value of these indicators is 0 (attained when the reference set is weakly
+ * dominated by the archive).
+ */
+static void logger_biobj_reference_set_initialize(logger_biobj_indicator_t *indicator,
+                                                  logger_biobj_t *logger,
+                                                  coco_problem_t *problem) {
+
+  observer_biobj_t *observer_biobj = (observer_biobj_t *) logger->observer->data;
+  logger_biobj_reference_set_t *set;
+  size_t i, j;
+
+  set = (logger_biobj_reference_set_t *) coco_allocate_memory(sizeof(*set));
+  set->number_of_points = 0;
+  if (observer_biobj->reference_sets_folder != NULL) {
+    set->number_of_points = logger_biobj_reference_set_read(observer_biobj->reference_sets_folder,
+        problem->problem_id, &set->points);
+    if (set->number_of_points == 0)
+      coco_warning("logger_biobj_reference_set_initialize(): no reference set for problem %s, the %s indicator "
+          "uses the extreme points of the Pareto front", problem->problem_id, indicator->type->name);
+  }
+  if (set->number_of_points == 0) {
+    /* Use the extreme points of the Pareto front (see observer_biobj()) */
+    set->number_of_points = 2;
+    set->points = coco_allocate_vector(4);
+    set->points[0] = problem->best_value[0];
+    set->points[1] = problem->nadir_value[1];
+    set->points[2] = problem->nadir_value[0];
+    set->points[3] = problem->best_value[1];
+  }
 
-        previous_unavailable = 0;
-        if (new_node->prev != NULL) {
-          previous_item = (logger_biobj_avl_item_t*) new_node->prev->item;
-          if (previous_item->within_ROI) {
-            for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-                node_item->indicator_contribution[i] = (previous_item->y[0] - node_item->y[0])
-                    / (problem->nadir_value[0] - problem->best_value[0])
-                    * (problem->nadir_value[1] - node_item->y[1])
-                    / (problem->nadir_value[1] - problem->best_value[1]);
-              } else {
-                coco_error(
-                    "logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                    logger->indicators[i]->name);
-              }
-            }
-          } else {
-            previous_unavailable = 1;
-          }
-        } else {
-          previous_unavailable = 1;
-        }
+  set->distances = coco_allocate_vector(set->number_of_points);
+  for (i = 0; i < set->number_of_points; i++) {
+    for (j = 0; j < 2; j++)
+      set->points[2 * i + j] = (set->points[2 * i + j] - problem->best_value[j])
+          / (problem->nadir_value[j] - problem->best_value[j]);
+    set->distances[i] = DBL_MAX;
+  }
+  set->distances_are_exact = 1;
 
-        if (previous_unavailable) {
-          /* Previous item does not exist or is out of ROI, use reference point instead */
-          for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-              node_item->indicator_contribution[i] = (problem->nadir_value[0] - node_item->y[0])
-                  / (problem->nadir_value[0] - problem->best_value[0])
-                  * (problem->nadir_value[1] - node_item->y[1])
-                  / (problem->nadir_value[1] - problem->best_value[1]);
-            } else {
-              coco_error(
-                  "logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                  logger->indicators[i]->name);
-            }
-          }
-        }
+  indicator->best_value = 0;
+  indicator->current_value = DBL_MAX;
+  indicator->data = set;
+}
 
-        for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-          logger->indicators[i]->current_value += node_item->indicator_contribution[i];
-        }
-      }
+/**
+ * Updates the IGD+ value, the average over the reference points of the distance to the archive, where the
+ * distance of a point r to a solution a is the norm of max(a - r, 0). Only the distances to the new solution
+ * need to be computed.
+ */
+static void logger_biobj_igdp_on_insert(logger_biobj_indicator_t *indicator,
+                                        logger_biobj_t *logger,
+                                        coco_problem_t *problem,
+                                        const size_t position) {
+
+  logger_biobj_reference_set_t *set = (logger_biobj_reference_set_t *) indicator->data;
+  logger_biobj_item_t *item;
+  double z[2], d[2], distance, sum = 0;
+  size_t i, j;
+
+  item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position)->item;
+  for (j = 0; j < 2; j++)
+    z[j] = (item->y[j] - problem->best_value[j]) / (problem->nadir_value[j] - problem->best_value[j]);
+
+  for (i = 0; i < set->number_of_points; i++) {
+    for (j = 0; j < 2; j++)
+      d[j] = coco_max_double(z[j] - set->points[2 * i + j], 0);
+    distance = sqrt(d[0] * d[0] + d[1] * d[1]);
+    if (distance < set->distances[i])
+      set->distances[i] = distance;
+    sum += set->distances[i];
+  }
+  indicator->current_value = sum / (double) set->number_of_points;
+}
+
+/**
+ * Updates the additive epsilon indicator, the smallest value by which the archive needs to be translated to
+ * weakly dominate the reference set. The distance of a point r to a solution a is max(a - r) here and the
+ * indicator is the maximum over the reference points of their distance to the archive.
+ */
+static void logger_biobj_eps_on_insert(logger_biobj_indicator_t *indicator,
+                                       logger_biobj_t *logger,
+                                       coco_problem_t *problem,
+                                       const size_t position) {
+
+  logger_biobj_reference_set_t *set = (logger_biobj_reference_set_t *) indicator->data;
+  logger_biobj_item_t *item;
+  double z[2], distance, maximum = -DBL_MAX;
+  size_t i, j;
+
+  item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position)->item;
+  for (j = 0; j < 2; j++)
+    z[j] = (item->y[j] - problem->best_value[j]) / (problem->nadir_value[j] - problem->best_value[j]);
+
+  for (i = 0; i < set->number_of_points; i++) {
+    distance = coco_max_double(z[0] - set->points[2 * i], z[1] - set->points[2 * i + 1]);
+    if (distance < set->distances[i])
+      set->distances[i] = distance;
+    maximum = coco_max_double(maximum, set->distances[i]);
+  }
+  indicator->current_value = maximum;
+}
+
+/**
+ * Dominated solutions are removed from the archive together with the insertion of a solution dominating
+ * them, which is at least as close to every reference point (both distances are monotone with respect to
+ * dominance), so these removals do not change the igdp and eps values. Only the removal of a nondominated
+ * solution from a bounded archive requires the distances to be recomputed.
+ */
+static void logger_biobj_reference_set_on_remove(logger_biobj_indicator_t *indicator,
+                                                 logger_biobj_t *logger,
+                                                 coco_problem_t *problem,
+                                                 const size_t position,
+                                                 const int is_dominated) {
+
+  logger_biobj_reference_set_t *set = (logger_biobj_reference_set_t *) indicator->data;
+
+  if (!is_dominated)
+    set->distances_are_exact = 0;
+  (void) logger; /* unused */
+  (void) problem; /* unused */
+  (void) position; /* unused */
+}
+
+/**
+ * Returns the value of the igdp or eps indicator, which is maintained by the on_insert functions (and
+ * recomputed from the whole archive if nondominated solutions were removed).
+ */
+static double logger_biobj_reference_set_value(logger_biobj_indicator_t *indicator,
+                                               logger_biobj_t *logger,
+                                               coco_problem_t *problem) {
+
+  logger_biobj_reference_set_t *set = (logger_biobj_reference_set_t *) indicator->data;
+  size_t i;
+
+  if (!set->distances_are_exact) {
+    for (i = 0; i < set->number_of_points; i++)
+      set->distances[i] = DBL_MAX;
+    for (i = 0; i < logger_biobj_archive_size(logger->archive); i++)
+      indicator->type->on_insert(indicator, logger, problem, i);
+    set->distances_are_exact = 1;
+  }
+  return indicator->current_value;
+}
+
+/**
+ * Frees the reference set of the indicator.
+ */
+static void logger_biobj_reference_set_free(logger_biobj_indicator_t *indicator) {
+
+  logger_biobj_reference_set_t *set = (logger_biobj_reference_set_t *) indicator->data;
+
+  coco_free_memory(set->points);
+  coco_free_memory(set->distances);
+  coco_free_memory(set);
+  indicator->data = NULL;
+}
+
+/**
+ * Removes the solutions with the smallest hypervolume contributions from a bounded archive until it is within
+ * its bound again. The indicators are updated for each removed solution.
+ */
+static void logger_biobj_prune_archive(logger_biobj_t *logger, coco_problem_t *problem) {
+
+  logger_biobj_item_t *item;
+  size_t position, i;
+
+  while (logger_biobj_archive_size(logger->archive) > logger->archive_max_size) {
+    item = logger->heap[0];
+    position = logger_biobj_archive_locate(logger->archive, item->y[1]) - 1;
+    assert(logger_biobj_archive_get(logger->archive, position)->item == item);
+
+    /* Take the solution out of the heap before the contribution of the next solution changes */
+    logger_biobj_heap_remove(logger, item);
+    for (i = 0; i < logger->number_of_indicators; i++) {
+      logger->indicators[i]->type->on_remove(logger->indicators[i], logger, problem, position, 0);
+    }
+    if (item->distance_to_ROI <= logger->ROI_distance)
+      logger->ROI_distance_is_exact = 0;
+    logger_biobj_archive_replace(logger->archive, position, 1, NULL, NULL);
+    logger_biobj_node_free(logger, item);
+
+    /* The contribution of the next solution has changed */
+    if (position < logger_biobj_archive_size(logger->archive)) {
+      item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, position)->item;
+      logger_biobj_heap_sift(logger, item->heap_index);
     }
   }
+}
 
-  return trigger_update;
+/**
+ * Adds a line (or a record in the binary format) with the current number of evaluations, the indicator value
+ * and the given target to the indicator log file.
+ */
+static void logger_biobj_indicator_write(logger_biobj_indicator_t *indicator,
+                                         logger_biobj_t *logger,
+                                         const double target) {
+  double record[3];
+
+  if (logger->format == COCO_LOG_FORMAT_BINARY) {
+    record[0] = (double) logger->number_of_evaluations;
+    record[1] = indicator->overall_value;
+    record[2] = target;
+    coco_log_format_write_record(indicator->log_file, record, 3);
+  } else {
+    fprintf(indicator->log_file, "%lu\t%.*e\t%.*e\n", logger->number_of_evaluations, logger->precision_f,
+        indicator->overall_value, logger->precision_f, target);
+  }
 }
 
 /**
- * Initializes the indicator with name indicator_name.
+ * Initializes the indicator of the given type.
  */
 static logger_biobj_indicator_t *logger_biobj_indicator(logger_biobj_t *logger,
                                                         coco_problem_t *problem,
-                                                        const char *indicator_name) {
+                                                        const observer_biobj_indicator_type_t *type,
+                                                        const size_t number) {
 
   coco_observer_t *observer;
   observer_biobj_t *observer_biobj;
   logger_biobj_indicator_t *indicator;
+  const char *indicator_name;
   char *prefix, *file_name, *path_name;
   int info_file_exists = 0;
 
@@ -389,14 +864,17 @@ static logger_biobj_indicator_t *logger_biobj_indicator(logger_biobj_t *logger,
   observer = logger->observer;
   observer_biobj = (observer_biobj_t *) observer->data;
 
-  indicator->name = coco_strdup(indicator_name);
+  indicator->type = type;
+  indicator->number = number;
+  indicator_name = type->name;
 
-  indicator->best_value = suite_biobj_get_best_value(indicator->name, problem->problem_id);
   indicator->next_target_id = 0;
   indicator->target_hit = 0;
   indicator->current_value = 0;
   indicator->additional_penalty = 0;
   indicator->overall_value = 0;
+  indicator->data = NULL;
+  type->initialize(indicator, logger, problem);
 
   /* Prepare the info file */
   path_name = (char *) coco_allocate_memory(COCO_PATH_MAX);
@@ -421,7 +899,7 @@ static logger_biobj_indicator_t *logger_biobj_indicator(logger_biobj_t *logger,
   prefix = coco_remove_from_string(problem->problem_id, "_i", "_d");
   file_name = coco_strdupf("%s_%s.dat", prefix, indicator_name);
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
-  indicator->log_file = fopen(path_name, "a");
+  indicator->log_file = fopen(path_name, (logger->format == COCO_LOG_FORMAT_BINARY) ? "ab" : "a");
   if (indicator->log_file == NULL) {
     coco_error("logger_biobj_indicator() failed to open file '%s'.", path_name);
     return NULL; /* Never reached */
@@ -433,7 +911,10 @@ static logger_biobj_indicator_t *logger_biobj_indicator(logger_biobj_t *logger,
     fprintf(indicator->info_file, "algorithm = '%s', indicator = '%s', folder = '%s'\n%% %s", observer->algorithm_name,
         indicator_name, problem->problem_type, observer->algorithm_info);
   }
-  if (observer_biobj->previous_function != problem->suite_dep_function) {
+  /* A line of the info file holds the runs of a function in a dimension (which need not alternate, for
+   * example in a batch of a suite) */
+  if ((observer_biobj->previous_function != (long) problem->suite_dep_function)
+      || (observer_biobj->previous_dimension != (long) problem->number_of_variables)) {
     fprintf(indicator->info_file, "\nfunction = %2lu, ", problem->suite_dep_function);
     fprintf(indicator->info_file, "dim = %2lu, ", problem->number_of_variables);
     fprintf(indicator->info_file, "%s", file_name);
@@ -444,10 +925,15 @@ static logger_biobj_indicator_t *logger_biobj_indicator(logger_biobj_t *logger,
   coco_free_memory(path_name);
 
   /* Output header information to the log file */
-  fprintf(indicator->log_file, "%%\n%% index = %ld, name = %s\n", problem->suite_dep_index, problem->problem_name);
-  fprintf(indicator->log_file, "%% instance = %ld, reference value = %.*e\n", problem->suite_dep_instance,
-      logger->precision_f, indicator->best_value);
-  fprintf(indicator->log_file, "%% function evaluation | indicator value | target hit\n");
+  if (logger->format == COCO_LOG_FORMAT_BINARY) {
+    coco_log_format_write_header(indicator->log_file, 3, indicator->best_value, problem->suite_dep_index,
+        problem->suite_dep_instance, problem->problem_name);
+  } else {
+    fprintf(indicator->log_file, "%%\n%% index = %ld, name = %s\n", problem->suite_dep_index, problem->problem_name);
+    fprintf(indicator->log_file, "%% instance = %ld, reference value = %.*e\n", problem->suite_dep_instance,
+        logger->precision_f, indicator->best_value);
+    fprintf(indicator->log_file, "%% function evaluation | indicator value | target hit\n");
+  }
 
   return indicator;
 }
@@ -463,8 +949,7 @@ static void logger_biobj_indicator_finalize(logger_biobj_indicator_t *indicator,
 
   /* Log the last evaluation in the dat file if wasn't already logged */
   if (!indicator->target_hit) {
-    fprintf(indicator->log_file, "%lu\t%.*e\t%.*e\n", logger->number_of_evaluations, logger->precision_f,
-        indicator->overall_value, logger->precision_f, MO_RELATIVE_TARGET_VALUES[target_index]);
+    logger_biobj_indicator_write(indicator, logger, MO_RELATIVE_TARGET_VALUES[target_index]);
   }
 
   /* Log the information in the info file */
@@ -483,9 +968,8 @@ static void logger_biobj_indicator_free(void *stuff) {
   assert(stuff != NULL);
   indicator = stuff;
 
-  if (indicator->name != NULL) {
-    coco_free_memory(indicator->name);
-    indicator->name = NULL;
+  if (indicator->type->free != NULL) {
+    indicator->type->free(indicator);
   }
 
   if (indicator->log_file != NULL) {
@@ -510,9 +994,9 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
 
   logger_biobj_t *logger;
 
-  logger_biobj_avl_item_t *node_item;
   logger_biobj_indicator_t *indicator;
-  avl_node_t *solution;
+  logger_biobj_item_t *new_item;
+  const double *stored_x;
   int update_performed;
   size_t i;
 
@@ -523,58 +1007,43 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
   logger->number_of_evaluations++;
 
   /* Update the archive with the new solution, if it is not dominated by or equal to existing solutions in the archive */
-  node_item = logger_biobj_node_create(x, y, logger->number_of_evaluations, logger->number_of_variables,
-      logger->number_of_objectives);
-
-  update_performed = logger_biobj_tree_update(logger, coco_transformed_get_inner_problem(problem), node_item);
+  new_item = logger_biobj_update_archive(logger, coco_transformed_get_inner_problem(problem), x, y);
+  update_performed = (new_item != NULL);
 
   /* If the archive was updated and you need to log all nondominated solutions, output the new solution to nondom_file */
   if (update_performed && (logger->log_nondom_mode == ALL)) {
-    logger_biobj_tree_output(logger->nondom_file, logger->buffer_tree, logger->number_of_variables,
-        logger->number_of_objectives, logger->log_vars, logger->precision_x, logger->precision_f);
-    avl_tree_purge(logger->buffer_tree);
+    /* The decision variables are not necessarily stored in the item */
+    stored_x = new_item->x;
+    new_item->x = x;
+    logger_biobj_output(logger->nondom_file, &new_item, 1, logger->number_of_variables,
+        logger->number_of_objectives, logger->log_vars, logger->precision_x, logger->precision_f,
+        logger->format);
+    new_item->x = stored_x;
 
     /* Flush output so that impatient users can see progress. */
     fflush(logger->nondom_file);
   }
 
+  /* Keep a bounded archive within its bound (the new solution might be removed again) */
+  if (update_performed && (logger->archive_max_size > 0))
+    logger_biobj_prune_archive(logger, coco_transformed_get_inner_problem(problem));
+
   /* If the archive was updated and a new target was reached for an indicator or if this is the first evaluation,
-   * output indicator information. Note that a target is reached when the (best_value - current_value) <=
-   * relative_target_value (the relative_target_value is a target for indicator difference, not indicator value!)
+   * output indicator information. Note that a target is reached when the value returned by the indicator (for
+   * hyp, the difference best_value - current_value) <= relative_target_value (the relative_target_value is a
+   * target for indicator difference, not indicator value!)
    */
   /* Log the evaluation */
   if (logger->compute_indicators) {
-    for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+    for (i = 0; i < logger->number_of_indicators; i++) {
 
       indicator = logger->indicators[i];
       indicator->target_hit = 0;
 
       /* If the update was performed, update the overall indicator value */
       if (update_performed) {
-        /* Compute the overall_value of an indicator */
-        if (strcmp(indicator->name, "hyp") == 0) {
-          if (indicator->current_value == 0) {
-            /* The additional penalty for hypervolume is the minimal distance from the nondominated set to the ROI */
-            indicator->additional_penalty = DBL_MAX;
-            if (logger->archive_tree->tail) {
-              solution = logger->archive_tree->head;
-              while (solution != NULL) {
-                double distance = mo_get_distance_to_ROI(((logger_biobj_avl_item_t*) solution->item)->y,
-                    problem->best_value, problem->nadir_value, problem->number_of_objectives);
-                indicator->additional_penalty = coco_min_double(indicator->additional_penalty, distance);
-                solution = solution->next;
-              }
-            }
-            assert(indicator->additional_penalty >= 0);
-          } else {
-            indicator->additional_penalty = 0;
-          }
-          indicator->overall_value = indicator->best_value - indicator->current_value
-              + indicator->additional_penalty;
-        } else {
-          coco_error("logger_biobj_evaluate(): Indicator computation not implemented yet for indicator %s",
-              indicator->name);
-        }
+        indicator->overall_value = indicator->type->value(indicator, logger,
+            coco_transformed_get_inner_problem(problem));
 
         /* Check whether a target was hit */
         while ((indicator->next_target_id < MO_NUMBER_OF_TARGETS)
@@ -590,21 +1059,22 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
 
       /* Log the evaluation if a target was hit or the evaluation number matches a predefined value */
       if (indicator->target_hit) {
-        fprintf(indicator->log_file, "%lu\t%.*e\t%.*e\n", logger->number_of_evaluations, logger->precision_f,
-            indicator->overall_value, logger->precision_f,
-            MO_RELATIVE_TARGET_VALUES[indicator->next_target_id - 1]);
+        logger_biobj_indicator_write(indicator, logger, MO_RELATIVE_TARGET_VALUES[indicator->next_target_id - 1]);
       }
-      else if (coco_observer_evaluation_to_log(logger->number_of_evaluations, problem->number_of_variables)) {
+      else if (logger->number_of_evaluations == logger->next_evaluation_to_log) {
         size_t target_index = 0;
         if (indicator->next_target_id > 0)
           target_index = indicator->next_target_id - 1;
-        fprintf(indicator->log_file, "%lu\t%.*e\t%.*e\n", logger->number_of_evaluations, logger->precision_f,
-            indicator->overall_value, logger->precision_f, MO_RELATIVE_TARGET_VALUES[target_index]);
+        logger_biobj_indicator_write(indicator, logger, MO_RELATIVE_TARGET_VALUES[target_index]);
         indicator->target_hit = 1;
       }
 
     }
   }
+
+  if (logger->number_of_evaluations == logger->next_evaluation_to_log)
+    logger->next_evaluation_to_log = coco_observer_next_evaluation_to_log(logger->number_of_evaluations,
+        logger->number_of_variables);
 }
 
 /**
@@ -612,25 +1082,22 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
  */
 static void logger_biobj_finalize(logger_biobj_t *logger) {
 
-  avl_tree_t *resorted_tree;
-  avl_node_t *solution;
-
-  /* Resort archive_tree according to time stamp and then output it */
-  resorted_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_time_stamp, NULL);
+  logger_biobj_item_t **items;
+  size_t i, number_of_items;
 
-  if (logger->archive_tree->tail) {
-    /* There is at least a solution in the tree to output */
-    solution = logger->archive_tree->head;
-    while (solution != NULL) {
-      avl_item_insert(resorted_tree, solution->item);
-      solution = solution->next;
-    }
-  }
+  /* Resort the archive according to time stamp and then output it */
+  number_of_items = logger_biobj_archive_size(logger->archive);
+  if (number_of_items == 0)
+    return;
+  items = (logger_biobj_item_t **) coco_allocate_memory(number_of_items * sizeof(*items));
+  for (i = 0; i < number_of_items; i++)
+    items[i] = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, i)->item;
+  qsort(items, number_of_items, sizeof(*items), logger_biobj_compare_by_time_stamp);
 
-  logger_biobj_tree_output(logger->nondom_file, resorted_tree, logger->number_of_variables,
-      logger->number_of_objectives, logger->log_vars, logger->precision_x, logger->precision_f);
+  logger_biobj_output(logger->nondom_file, items, number_of_items, logger->number_of_variables,
+      logger->number_of_objectives, logger->log_vars, logger->precision_x, logger->precision_f, logger->format);
 
-  avl_tree_destruct(resorted_tree);
+  coco_free_memory(items);
 }
 
 /**
@@ -649,7 +1116,7 @@ static void logger_biobj_free(void *stuff) {
   }
 
   if (logger->compute_indicators) {
-    for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+    for (i = 0; i < logger->number_of_indicators; i++) {
       logger_biobj_indicator_finalize(logger->indicators[i], logger);
       logger_biobj_indicator_free(logger->indicators[i]);
     }
@@ -660,8 +1127,13 @@ static void logger_biobj_free(void *stuff) {
     logger->nondom_file = NULL;
   }
 
-  avl_tree_destruct(logger->archive_tree);
-  avl_tree_destruct(logger->buffer_tree);
+  /* The items are freed together with their pool */
+  logger_biobj_archive_free(logger->archive);
+  logger_biobj_pool_free(logger->item_pool);
+  if (logger->heap != NULL) {
+    coco_free_memory(logger->heap);
+    logger->heap = NULL;
+  }
 
 }
 
@@ -687,6 +1159,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *p
   logger->observer = observer;
 
   logger->number_of_evaluations = 0;
+  logger->next_evaluation_to_log = coco_observer_next_evaluation_to_log(0, problem->number_of_variables);
   logger->number_of_variables = problem->number_of_variables;
   logger->number_of_objectives = problem->number_of_objectives;
   logger->suite_dep_instance = problem->suite_dep_instance;
@@ -695,6 +1168,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *p
   /* Copy values from the observes that you might need even if they do not exist any more */
   logger->log_nondom_mode = observer_biobj->log_nondom_mode;
   logger->compute_indicators = observer_biobj->compute_indicators;
+  logger->format = observer_biobj->format;
   logger->precision_x = observer->precision_x;
   logger->precision_f = observer->precision_f;
 
@@ -725,7 +1199,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *p
     coco_free_memory(prefix);
 
     /* Open and initialize the file */
-    logger->nondom_file = fopen(path_name, "a");
+    logger->nondom_file = fopen(path_name, (logger->format == COCO_LOG_FORMAT_BINARY) ? "ab" : "a");
     if (logger->nondom_file == NULL) {
       coco_error("logger_biobj() failed to open file '%s'.", path_name);
       return NULL; /* Never reached */
@@ -733,30 +1207,54 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *p
     coco_free_memory(path_name);
 
     /* Output header information */
-    fprintf(logger->nondom_file, "%% instance = %ld, name = %s\n", problem->suite_dep_instance, problem->problem_name);
-    if (logger->log_vars) {
-      fprintf(logger->nondom_file, "%% function evaluation | %lu objectives | %lu variables\n",
-          problem->number_of_objectives, problem->number_of_variables);
+    if (logger->format == COCO_LOG_FORMAT_BINARY) {
+      coco_log_format_write_header(logger->nondom_file,
+          1 + problem->number_of_objectives + (logger->log_vars ? problem->number_of_variables : 0), 0.0,
+          problem->suite_dep_index, problem->suite_dep_instance, problem->problem_name);
     } else {
-      fprintf(logger->nondom_file, "%% function evaluation | %lu objectives \n",
-          problem->number_of_objectives);
+      fprintf(logger->nondom_file, "%% instance = %ld, name = %s\n", problem->suite_dep_instance,
+          problem->problem_name);
+      if (logger->log_vars) {
+        fprintf(logger->nondom_file, "%% function evaluation | %lu objectives | %lu variables\n",
+            problem->number_of_objectives, problem->number_of_variables);
+      } else {
+        fprintf(logger->nondom_file, "%% function evaluation | %lu objectives \n",
+            problem->number_of_objectives);
+      }
     }
   }
 
-  /* Initialize the AVL trees */
-  logger->archive_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_last_objective,
-      (avl_free_t) logger_biobj_node_free);
-  logger->buffer_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_time_stamp, NULL);
+  /* Initialize the pool and the archive */
+  logger->number_of_indicators = logger->compute_indicators ? observer_biobj->number_of_indicators : 0;
+  logger->store_x = (logger->log_nondom_mode == FINAL) && logger->log_vars;
+  logger->item_pool = logger_biobj_pool(sizeof(logger_biobj_item_t)
+      + ((logger->store_x ? problem->number_of_variables : 0) + problem->number_of_objectives
+          + logger->number_of_indicators) * sizeof(double));
+  logger->archive = logger_biobj_archive();
+  logger->archive_max_size = observer_biobj->archive_max_size;
+  logger->heap = NULL;
+  logger->heap_size = 0;
+  logger->hyp_number = 0;
+  if (logger->archive_max_size > 0) {
+    logger->heap = (logger_biobj_item_t **) coco_allocate_memory((logger->archive_max_size + 1)
+        * sizeof(logger_biobj_item_t *));
+    for (i = 0; strcmp(observer_biobj->indicators[i]->name, "hyp") != 0; i++)
+      ;
+    logger->hyp_number = i;
+  }
+  logger->ROI_distance = DBL_MAX;
+  logger->ROI_distance_is_exact = 1;
 
   self = coco_transformed_allocate(problem, logger, logger_biobj_free);
   self->evaluate_function = logger_biobj_evaluate;
 
   /* Initialize the indicators */
   if (logger->compute_indicators) {
-    for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++)
-      logger->indicators[i] = logger_biobj_indicator(logger, problem, OBSERVER_BIOBJ_INDICATORS[i]);
+    for (i = 0; i < logger->number_of_indicators; i++)
+      logger->indicators[i] = logger_biobj_indicator(logger, problem, observer_biobj->indicators[i], i);
 
     observer_biobj->previous_function = (long) problem->suite_dep_function;
+    observer_biobj->previous_dimension = (long) problem->number_of_variables;
   }
 
   return self;
@@ -0,0 +1,365 @@
+/*
+ * The archive of nondominated solutions of the biobjective logger.
+ *
+ * In two dimensions, the nondominated solutions are totally ordered: sorted by increasing values of the
+ * second objective, they are sorted by decreasing values of the first one. The archive is therefore a sorted
+ * sequence of entries holding both objective values and a pointer to the logged solution, so that locating a
+ * point and checking the dominance of its neighbors never leave the entries.
+ *
+ * The sequence is stored as a B+-tree with two levels: the entries are kept in chunks of at most
+ * LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE contiguous entries, and the archive holds the array of its chunks together
+ * with a Fenwick tree of the chunk sizes, from which the index of the first entry of a chunk and the chunk
+ * of an index are found in O(log(#chunks)). An update removes a contiguous range of dominated entries and
+ * inserts the new one at the same position, which only moves entries within a chunk and updates the sizes
+ * of a few chunks in the Fenwick tree (full chunks are split, chunks that become small are merged with a
+ * neighbor, which rebuilds the Fenwick tree in O(#chunks), but happens only once every
+ * O(LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE) updates). Locating a point is a binary search over the chunks followed
+ * by one within a chunk. The entries are addressed by their index in the sequence; accesses in the same or
+ * the next chunk as the previous one (iterations, neighbors) cost O(1).
+ */
+#include <assert.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+#define LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE 256
+
+typedef struct {
+  double y[2];
+  void *item; /* The solution, owned by the user of the archive */
+} logger_biobj_archive_entry_t;
+
+typedef struct {
+  size_t size;
+  logger_biobj_archive_entry_t entries[LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE];
+} logger_biobj_archive_chunk_t;
+
+typedef struct {
+  logger_biobj_archive_chunk_t **chunks;
+  size_t *chunk_sizes; /* The Fenwick tree of the chunk sizes (1-based, of length capacity + 1) */
+  size_t number_of_chunks;
+  size_t capacity; /* Of the arrays chunks and chunk_sizes */
+  size_t size; /* The number of entries */
+  size_t last_chunk; /* The chunk of the last access (number_of_chunks if none) */
+  size_t last_chunk_start; /* The index of the first entry of last_chunk */
+} logger_biobj_archive_t;
+
+/**
+ * Allocates an empty archive.
+ */
+static logger_biobj_archive_t *logger_biobj_archive(void) {
+  logger_biobj_archive_t *archive;
+
+  archive = (logger_biobj_archive_t *) coco_allocate_memory(sizeof(*archive));
+  archive->capacity = 16;
+  archive->chunks = (logger_biobj_archive_chunk_t **) coco_allocate_memory(archive->capacity
+      * sizeof(logger_biobj_archive_chunk_t *));
+  archive->chunk_sizes = (size_t *) coco_allocate_memory((archive->capacity + 1) * sizeof(size_t));
+  archive->number_of_chunks = 0;
+  archive->size = 0;
+  archive->last_chunk = 0;
+  archive->last_chunk_start = 0;
+  return archive;
+}
+
+/**
+ * Frees the archive (but not the solutions it points to).
+ */
+static void logger_biobj_archive_free(logger_biobj_archive_t *archive) {
+  size_t i;
+
+  assert(archive != NULL);
+  for (i = 0; i < archive->number_of_chunks; i++)
+    coco_free_memory(archive->chunks[i]);
+  coco_free_memory(archive->chunks);
+  coco_free_memory(archive->chunk_sizes);
+  coco_free_memory(archive);
+}
+
+/**
+ * Returns the number of entries in the archive.
+ */
+static size_t logger_biobj_archive_size(const logger_biobj_archive_t *archive) {
+  return archive->size;
+}
+
+/**
+ * Adds ${count} to the size of ${chunk} in the Fenwick tree of the chunk sizes.
+ */
+static void logger_biobj_archive_add_to_size(logger_biobj_archive_t *archive, const size_t chunk, const size_t count) {
+  size_t i;
+
+  for (i = chunk + 1; i <= archive->number_of_chunks; i += i & (~i + 1))
+    archive->chunk_sizes[i] += count;
+}
+
+/**
+ * Subtracts ${count} from the size of ${chunk} in the Fenwick tree of the chunk sizes.
+ */
+static void logger_biobj_archive_subtract_from_size(logger_biobj_archive_t *archive,
+                                                    const size_t chunk,
+                                                    const size_t count) {
+  size_t i;
+
+  for (i = chunk + 1; i <= archive->number_of_chunks; i += i & (~i + 1))
+    archive->chunk_sizes[i] -= count;
+}
+
+/**
+ * Rebuilds the Fenwick tree of the chunk sizes after chunks were inserted or removed.
+ */
+static void logger_biobj_archive_rebuild_sizes(logger_biobj_archive_t *archive) {
+  size_t i, parent;
+
+  for (i = 1; i <= archive->number_of_chunks; i++)
+    archive->chunk_sizes[i] = archive->chunks[i - 1]->size;
+  for (i = 1; i <= archive->number_of_chunks; i++) {
+    parent = i + (i & (~i + 1));
+    if (parent <= archive->number_of_chunks)
+      archive->chunk_sizes[parent] += archive->chunk_sizes[i];
+  }
+  archive->last_chunk = archive->number_of_chunks;
+}
+
+/**
+ * Returns the index of the first entry of the given ${chunk}.
+ */
+static size_t logger_biobj_archive_chunk_start(const logger_biobj_archive_t *archive, const size_t chunk) {
+  size_t i, start = 0;
+
+  if (chunk == archive->last_chunk)
+    return archive->last_chunk_start;
+  for (i = chunk; i > 0; i -= i & (~i + 1))
+    start += archive->chunk_sizes[i];
+  return start;
+}
+
+/**
+ * Returns the chunk that holds the entry with the given ${index}.
+ */
+static size_t logger_biobj_archive_find_chunk(logger_biobj_archive_t *archive, const size_t index) {
+  size_t chunk = archive->last_chunk, start, step, remaining;
+
+  assert(index < archive->size);
+  if ((chunk < archive->number_of_chunks) && (index >= archive->last_chunk_start)) {
+    start = archive->last_chunk_start;
+    if (index < start + archive->chunks[chunk]->size)
+      return chunk;
+    start += archive->chunks[chunk]->size;
+    chunk++;
+    if ((chunk < archive->number_of_chunks) && (index < start + archive->chunks[chunk]->size)) {
+      archive->last_chunk = chunk;
+      archive->last_chunk_start = start;
+      return chunk;
+    }
+  }
+
+  /* Descend the Fenwick tree to the last chunk that starts at or before the index */
+  for (step = 1; step * 2 <= archive->number_of_chunks; step *= 2)
+    ;
+  chunk = 0;
+  remaining = index;
+  for (; step > 0; step /= 2) {
+    if ((chunk + step <= archive->number_of_chunks) && (archive->chunk_sizes[chunk + step] <= remaining)) {
+      chunk += step;
+      remaining -= archive->chunk_sizes[chunk];
+    }
+  }
+  archive->last_chunk = chunk;
+  archive->last_chunk_start = index - remaining;
+  return chunk;
+}
+
+/**
+ * Returns the entry with the given ${index} in the order of increasing second objective.
+ */
+static logger_biobj_archive_entry_t *logger_biobj_archive_get(logger_biobj_archive_t *archive, const size_t index) {
+  const size_t chunk = logger_biobj_archive_find_chunk(archive, index);
+  return &archive->chunks[chunk]->entries[index - archive->last_chunk_start];
+}
+
+/**
+ * Returns the number of entries whose second objective is smaller than or equal to ${y1}, i.e., the index
+ * of the first entry with a larger second objective.
+ */
+static size_t logger_biobj_archive_locate(const logger_biobj_archive_t *archive, const double y1) {
+  const logger_biobj_archive_chunk_t *chunk;
+  size_t low = 0, high = archive->number_of_chunks, middle, first_chunk;
+
+  /* Find the first chunk whose last entry has a larger second objective */
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    chunk = archive->chunks[middle];
+    if (chunk->entries[chunk->size - 1].y[1] <= y1)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  if (low == archive->number_of_chunks)
+    return archive->size;
+
+  /* Find the first entry with a larger second objective in this chunk */
+  first_chunk = low;
+  chunk = archive->chunks[first_chunk];
+  low = 0;
+  high = chunk->size;
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    if (chunk->entries[middle].y[1] <= y1)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return logger_biobj_archive_chunk_start(archive, first_chunk) + low;
+}
+
+/**
+ * Inserts an empty chunk at position ${chunk} in the array of chunks and rebuilds the Fenwick tree.
+ */
+static void logger_biobj_archive_insert_chunk(logger_biobj_archive_t *archive, const size_t chunk) {
+  logger_biobj_archive_chunk_t **chunks;
+  size_t *chunk_sizes;
+
+  if (archive->number_of_chunks == archive->capacity) {
+    archive->capacity *= 2;
+    chunks = (logger_biobj_archive_chunk_t **) coco_allocate_memory(archive->capacity
+        * sizeof(logger_biobj_archive_chunk_t *));
+    chunk_sizes = (size_t *) coco_allocate_memory((archive->capacity + 1) * sizeof(size_t));
+    memcpy(chunks, archive->chunks, archive->number_of_chunks * sizeof(logger_biobj_archive_chunk_t *));
+    coco_free_memory(archive->chunks);
+    coco_free_memory(archive->chunk_sizes);
+    archive->chunks = chunks;
+    archive->chunk_sizes = chunk_sizes;
+  }
+  memmove(&archive->chunks[chunk + 1], &archive->chunks[chunk],
+      (archive->number_of_chunks - chunk) * sizeof(logger_biobj_archive_chunk_t *));
+  archive->chunks[chunk] = (logger_biobj_archive_chunk_t *) coco_allocate_memory(sizeof(logger_biobj_archive_chunk_t));
+  archive->chunks[chunk]->size = 0;
+  archive->number_of_chunks++;
+  logger_biobj_archive_rebuild_sizes(archive);
+}
+
+/**
+ * Removes the (empty) chunk at position ${chunk} from the array of chunks and rebuilds the Fenwick tree.
+ */
+static void logger_biobj_archive_remove_chunk(logger_biobj_archive_t *archive, const size_t chunk) {
+  assert(archive->chunks[chunk]->size == 0);
+  coco_free_memory(archive->chunks[chunk]);
+  memmove(&archive->chunks[chunk], &archive->chunks[chunk + 1],
+      (archive->number_of_chunks - chunk - 1) * sizeof(logger_biobj_archive_chunk_t *));
+  archive->number_of_chunks--;
+  logger_biobj_archive_rebuild_sizes(archive);
+}
+
+/**
+ * Merges the chunk at position ${chunk} + 1 into the one at position ${chunk} if together they fill at most
+ * half a chunk.
+ */
+static void logger_biobj_archive_merge_chunks(logger_biobj_archive_t *archive, const size_t chunk) {
+  logger_biobj_archive_chunk_t *first, *second;
+
+  if (chunk + 1 >= archive->number_of_chunks)
+    return;
+  first = archive->chunks[chunk];
+  second = archive->chunks[chunk + 1];
+  if (first->size + second->size > LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE / 2)
+    return;
+  memcpy(&first->entries[first->size], second->entries, second->size * sizeof(logger_biobj_archive_entry_t));
+  logger_biobj_archive_add_to_size(archive, chunk, second->size);
+  first->size += second->size;
+  second->size = 0;
+  logger_biobj_archive_remove_chunk(archive, chunk + 1);
+}
+
+/**
+ * Removes the ${number_of_removed} entries starting at ${index} (their solutions must have been taken care
+ * of by the caller) and inserts an entry with the objective values ${y} and the solution ${item} at
+ * ${index}, unless ${y} is NULL. The caller is responsible for keeping the archive sorted and nondominated.
+ */
+static void logger_biobj_archive_replace(logger_biobj_archive_t *archive,
+                                         const size_t index,
+                                         size_t number_of_removed,
+                                         const double *y,
+                                         void *item) {
+  logger_biobj_archive_chunk_t *chunk_data;
+  size_t chunk, offset, count;
+
+  assert(index + number_of_removed <= archive->size);
+
+  /* Remove the entries, chunk by chunk */
+  while (number_of_removed > 0) {
+    chunk = logger_biobj_archive_find_chunk(archive, index);
+    chunk_data = archive->chunks[chunk];
+    offset = index - archive->last_chunk_start;
+    count = chunk_data->size - offset;
+    if (count > number_of_removed)
+      count = number_of_removed;
+    memmove(&chunk_data->entries[offset], &chunk_data->entries[offset + count],
+        (chunk_data->size - offset - count) * sizeof(logger_biobj_archive_entry_t));
+    chunk_data->size -= count;
+    logger_biobj_archive_subtract_from_size(archive, chunk, count);
+    archive->size -= count;
+    number_of_removed -= count;
+    if (chunk_data->size == 0)
+      logger_biobj_archive_remove_chunk(archive, chunk);
+    archive->last_chunk = archive->number_of_chunks;
+  }
+
+  if (y == NULL) {
+    /* Nothing to insert, only merge small chunks around the removed entries */
+    if (archive->number_of_chunks > 0) {
+      chunk = (index < archive->size) ? logger_biobj_archive_find_chunk(archive, index)
+          : archive->number_of_chunks - 1;
+      logger_biobj_archive_merge_chunks(archive, chunk);
+      if (chunk > 0)
+        logger_biobj_archive_merge_chunks(archive, chunk - 1);
+    }
+    archive->last_chunk = archive->number_of_chunks;
+    return;
+  }
+
+  /* Find the chunk for the new entry (a new one if the archive is empty) */
+  if (archive->number_of_chunks == 0) {
+    logger_biobj_archive_insert_chunk(archive, 0);
+    chunk = 0;
+  } else if (index == archive->size) {
+    chunk = archive->number_of_chunks - 1;
+  } else {
+    chunk = logger_biobj_archive_find_chunk(archive, index);
+  }
+  offset = index - logger_biobj_archive_chunk_start(archive, chunk);
+
+  /* Split a full chunk */
+  if (archive->chunks[chunk]->size == LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE) {
+    logger_biobj_archive_insert_chunk(archive, chunk + 1);
+    count = LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE / 2;
+    memcpy(archive->chunks[chunk + 1]->entries, &archive->chunks[chunk]->entries[count],
+        (LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE - count) * sizeof(logger_biobj_archive_entry_t));
+    archive->chunks[chunk + 1]->size = LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE - count;
+    archive->chunks[chunk]->size = count;
+    logger_biobj_archive_subtract_from_size(archive, chunk, LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE - count);
+    logger_biobj_archive_add_to_size(archive, chunk + 1, LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE - count);
+    if (offset > count) {
+      chunk++;
+      offset -= count;
+    }
+  }
+
+  /* Insert the new entry */
+  chunk_data = archive->chunks[chunk];
+  memmove(&chunk_data->entries[offset + 1], &chunk_data->entries[offset],
+      (chunk_data->size - offset) * sizeof(logger_biobj_archive_entry_t));
+  chunk_data->entries[offset].y[0] = y[0];
+  chunk_data->entries[offset].y[1] = y[1];
+  chunk_data->entries[offset].item = item;
+  chunk_data->size++;
+  logger_biobj_archive_add_to_size(archive, chunk, 1);
+  archive->size++;
+
+  /* Merge small chunks around the update (only there, chunks can have become small) */
+  logger_biobj_archive_merge_chunks(archive, chunk);
+  if (chunk > 0)
+    logger_biobj_archive_merge_chunks(archive, chunk - 1);
+  archive->last_chunk = archive->number_of_chunks;
+}
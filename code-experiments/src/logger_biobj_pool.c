@@ -0,0 +1,100 @@
+/*
+ * A pool of memory blocks of fixed size used by the biobjective logger for the solutions in its archive.
+ *
+ * The blocks are carved out of slabs that are allocated when the pool runs out of blocks and are only
+ * released when the pool is freed. Blocks that are given back to the pool are kept in a free list and reused,
+ * so that a long run does not allocate and free memory for every nondominated solution.
+ */
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+#define LOGGER_BIOBJ_POOL_BLOCKS_PER_SLAB 256
+
+/* Blocks and slabs are aligned like the most restrictive of these types */
+typedef union {
+  double number;
+  void *pointer;
+  long integer;
+} logger_biobj_pool_align_t;
+
+typedef struct {
+  size_t block_size;
+  void *free_blocks; /* Each free block starts with a pointer to the next free block */
+  void *slabs; /* Each slab starts with a pointer to the previously allocated slab */
+  size_t number_of_slabs;
+} logger_biobj_pool_t;
+
+/**
+ * Returns ${size} rounded up to a multiple of the alignment of the blocks.
+ */
+static size_t logger_biobj_pool_round_size(const size_t size) {
+  const size_t alignment = sizeof(logger_biobj_pool_align_t);
+  return ((size + alignment - 1) / alignment) * alignment;
+}
+
+/**
+ * Returns a block from the pool, allocating a new slab if there are no free blocks.
+ */
+static void *logger_biobj_pool_allocate(logger_biobj_pool_t *pool) {
+  char *slab;
+  void *block;
+  size_t i;
+
+  if (pool->free_blocks == NULL) {
+    slab = (char *) coco_allocate_memory(sizeof(logger_biobj_pool_align_t)
+        + LOGGER_BIOBJ_POOL_BLOCKS_PER_SLAB * pool->block_size);
+    *(void **) slab = pool->slabs;
+    pool->slabs = slab;
+    pool->number_of_slabs++;
+    /* Chain the blocks of the new slab into the free list (in increasing order of addresses) */
+    for (i = LOGGER_BIOBJ_POOL_BLOCKS_PER_SLAB; i > 0; i--) {
+      block = slab + sizeof(logger_biobj_pool_align_t) + (i - 1) * pool->block_size;
+      *(void **) block = pool->free_blocks;
+      pool->free_blocks = block;
+    }
+  }
+  block = pool->free_blocks;
+  pool->free_blocks = *(void **) block;
+  return block;
+}
+
+/**
+ * Gives the ${block} back to the pool.
+ */
+static void logger_biobj_pool_deallocate(logger_biobj_pool_t *pool, void *block) {
+  *(void **) block = pool->free_blocks;
+  pool->free_blocks = block;
+}
+
+/**
+ * Allocates an empty pool of blocks of (at least) ${block_size} bytes.
+ */
+static logger_biobj_pool_t *logger_biobj_pool(const size_t block_size) {
+  logger_biobj_pool_t *pool;
+
+  pool = (logger_biobj_pool_t *) coco_allocate_memory(sizeof(*pool));
+  pool->block_size = logger_biobj_pool_round_size((block_size < sizeof(void *)) ? sizeof(void *) : block_size);
+  pool->free_blocks = NULL;
+  pool->slabs = NULL;
+  pool->number_of_slabs = 0;
+  return pool;
+}
+
+/**
+ * Frees the pool together with all its blocks (also those that were not given back).
+ */
+static void logger_biobj_pool_free(logger_biobj_pool_t *pool) {
+  void *slab;
+
+  assert(pool != NULL);
+  coco_debug("logger_biobj_pool_free(): %lu slabs of %lu blocks", (unsigned long) pool->number_of_slabs,
+      (unsigned long) LOGGER_BIOBJ_POOL_BLOCKS_PER_SLAB);
+  while (pool->slabs != NULL) {
+    slab = pool->slabs;
+    pool->slabs = *(void **) slab;
+    coco_free_memory(slab);
+  }
+  coco_free_memory(pool);
+}
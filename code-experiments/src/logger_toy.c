@@ -16,6 +16,7 @@ typedef struct {
   coco_observer_t *observer;
   size_t next_target;
   long number_of_evaluations;
+  coco_flush_state_t flush_state;
 } logger_toy_t;
 
 /**
@@ -41,8 +42,9 @@ static void logger_toy_evaluate(coco_problem_t *self, const double *x, double *y
         logger->number_of_evaluations, y[0]);
     logger->next_target++;
   }
-  /* Flush output so that impatient users can see the progress */
-  fflush(observer_toy->log_file);
+  /* Flush output (according to the flush policy) so that impatient users can see the progress */
+  if (coco_flush_after_evaluation(&observer_toy->flush_policy, &logger->flush_state))
+    fflush(observer_toy->log_file);
 }
 
 /**
@@ -51,6 +53,7 @@ static void logger_toy_evaluate(coco_problem_t *self, const double *x, double *y
 static coco_problem_t *logger_toy(coco_observer_t *observer, coco_problem_t *problem) {
 
   logger_toy_t *logger;
+  observer_toy_t *observer_toy;
   coco_problem_t *self;
   FILE *output_file;
 
@@ -62,8 +65,15 @@ static coco_problem_t *logger_toy(coco_observer_t *observer, coco_problem_t *pro
   logger->observer = observer;
   logger->next_target = 0;
   logger->number_of_evaluations = 0;
+  coco_flush_state_reset(&logger->flush_state);
 
-  output_file = ((observer_toy_t *) logger->observer->data)->log_file;
+  /* The output file is shared by all problems. Since a problem can outlive its observer, the output of the
+   * previous problem is flushed here rather than when that problem is freed (the rest is flushed when the
+   * observer closes the file). */
+  observer_toy = (observer_toy_t *) logger->observer->data;
+  output_file = observer_toy->log_file;
+  if (observer_toy->flush_policy.mode != COCO_FLUSH_NEVER)
+    fflush(output_file);
   fprintf(output_file, "\n%s, %s\n", coco_problem_get_id(problem), coco_problem_get_name(problem));
 
   self = coco_transformed_allocate(problem, logger, NULL);
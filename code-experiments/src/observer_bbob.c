@@ -1,21 +1,262 @@
+#include <assert.h>
+#include <string.h>
+
 #include "coco.h"
 #include "coco_utilities.c"
+#include "coco_string.c"
+#include "coco_flush_policy.c"
+#include "coco_log_format.c"
+#include "coco_thread.c"
 
 static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *problem);
 
+#define OBSERVER_BBOB_F_LADDER_DECADES 20 /* The f target ladder covers the targets 10**-20 to 10**20 */
+#define OBSERVER_BBOB_NUMBER_OF_DIMENSIONS 6 /* TODO should use dimensions from the suite */
+
+/**
+ * A data file (path without extension, relative to the output folder) that is open in a logger.
+ */
+typedef struct observer_bbob_open_file {
+  char *data_file;
+  struct observer_bbob_open_file *next;
+} observer_bbob_open_file_t;
+
+/**
+ * An index entry (", instance:evaluations|f") whose writing was deferred, together with what is needed to
+ * start a new line for it.
+ */
+typedef struct observer_bbob_deferred_entry {
+  char *index_file;
+  char *data_file;
+  size_t function_id;
+  size_t number_of_variables;
+  char *entry;
+  struct observer_bbob_deferred_entry *next;
+} observer_bbob_deferred_entry_t;
+
+/**
+ * The bookkeeping of the index (.info) and data files of a bbob observer.
+ *
+ * When a logger is initialized, it chooses the names of its files and writes the header (if needed) and
+ * the start of its entry (", instance") to the index file, so that the index file records the runs that
+ * were started. The rest of the entry (":evaluations|f") is appended when the logger is freed. If the last
+ * line that was written to the index file does not belong to the data file of the logger, a new line with
+ * a header is started first.
+ *
+ * Only one entry can be unfinished at a time. A logger that is initialized while another one has an
+ * unfinished entry (several problems observed at the same time) writes its complete entry when it is
+ * freed, and if an entry is still unfinished then, the complete entry is deferred until the unfinished
+ * one is finished. Concurrently observed problems never share data files either (a problem whose data
+ * files are open in another logger gets data files of its own).
+ *
+ * The bookkeeping is shared by the observer and its loggers and reference counted, because a logger can be
+ * freed after its observer. With threads, all of it is protected by a mutex.
+ */
+typedef struct {
+  size_t number_of_references;
+  char *algorithm_name;
+  /* The function and dimension of the last initialized logger, used to choose the file names */
+  size_t current_dim;
+  size_t current_funId;
+  /* The first instance of the current index file (part of its name and of the names of the data files) */
+  size_t infoFile_firstInstance;
+  /* The dimensions already in the current index file. If the dimension of a logger is != current_dim and
+   * already present, a new index file with the number of the first instance as suffix is created */
+  size_t dimensions_in_current_infoFile[OBSERVER_BBOB_NUMBER_OF_DIMENSIONS];
+  /* The index file and data file of the last line written to an index file */
+  char *last_index_file;
+  char *last_data_file;
+  observer_bbob_open_file_t *open_data_files;
+  /* The logger whose entry is unfinished (the end of the last line written) or NULL */
+  const void *unfinished_entry_owner;
+  observer_bbob_deferred_entry_t *first_deferred_entry;
+  observer_bbob_deferred_entry_t *last_deferred_entry;
+#if defined(HAVE_THREADS)
+  coco_mutex_t mutex;
+#endif
+} observer_bbob_index_t;
+
 typedef struct {
   size_t bbob_nbpts_nbevals;
   size_t bbob_nbpts_fval;
+  coco_flush_policy_t flush_policy;
+  coco_log_format_t format;
+  /* The f targets 10**(i/bbob_nbpts_fval) for f_ladder_first_index <= i < f_ladder_first_index + f_ladder_length,
+   * shared by all loggers (targets outside of the ladder are computed when needed) */
+  double *f_ladder;
+  int f_ladder_first_index;
+  size_t f_ladder_length;
+  observer_bbob_index_t *index;
 } observer_bbob_t;
 
+/**
+ * Allocates the bookkeeping of the index files, with one reference held by the caller.
+ */
+static observer_bbob_index_t *observer_bbob_index_allocate(const char *algorithm_name) {
+  observer_bbob_index_t *index;
+  size_t i;
+
+  index = (observer_bbob_index_t *) coco_allocate_memory(sizeof(*index));
+  index->number_of_references = 1;
+  index->algorithm_name = coco_strdup(algorithm_name);
+  index->current_dim = 0;
+  index->current_funId = 0;
+  index->infoFile_firstInstance = 0;
+  for (i = 0; i < OBSERVER_BBOB_NUMBER_OF_DIMENSIONS; i++)
+    index->dimensions_in_current_infoFile[i] = 0;
+  index->last_index_file = NULL;
+  index->last_data_file = NULL;
+  index->open_data_files = NULL;
+  index->unfinished_entry_owner = NULL;
+  index->first_deferred_entry = NULL;
+  index->last_deferred_entry = NULL;
+#if defined(HAVE_THREADS)
+  coco_mutex_initialize(&index->mutex);
+#endif
+  return index;
+}
+
+static void observer_bbob_index_lock(observer_bbob_index_t *index) {
+#if defined(HAVE_THREADS)
+  coco_mutex_lock(&index->mutex);
+#else
+  (void) index; /* unused */
+#endif
+}
+
+static void observer_bbob_index_unlock(observer_bbob_index_t *index) {
+#if defined(HAVE_THREADS)
+  coco_mutex_unlock(&index->mutex);
+#else
+  (void) index; /* unused */
+#endif
+}
+
+/**
+ * Releases a reference to the bookkeeping of the index files and frees it with the last reference.
+ */
+static void observer_bbob_index_release(observer_bbob_index_t *index) {
+  size_t number_of_references;
+
+  observer_bbob_index_lock(index);
+  assert(index->number_of_references > 0);
+  number_of_references = --index->number_of_references;
+  observer_bbob_index_unlock(index);
+  if (number_of_references > 0)
+    return;
+  assert(index->open_data_files == NULL);
+  assert(index->unfinished_entry_owner == NULL);
+  assert(index->first_deferred_entry == NULL);
+#if defined(HAVE_THREADS)
+  coco_mutex_finalize(&index->mutex);
+#endif
+  coco_free_memory(index->algorithm_name);
+  if (index->last_index_file != NULL)
+    coco_free_memory(index->last_index_file);
+  if (index->last_data_file != NULL)
+    coco_free_memory(index->last_data_file);
+  coco_free_memory(index);
+}
+
+/**
+ * Returns 1 if ${data_file} is open in a logger and 0 otherwise.
+ */
+static int observer_bbob_index_is_open(const observer_bbob_index_t *index, const char *data_file) {
+  const observer_bbob_open_file_t *open_file;
+
+  for (open_file = index->open_data_files; open_file != NULL; open_file = open_file->next) {
+    if (strcmp(open_file->data_file, data_file) == 0)
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * Marks ${data_file} as open.
+ */
+static void observer_bbob_index_open(observer_bbob_index_t *index, const char *data_file) {
+  observer_bbob_open_file_t *open_file;
+
+  open_file = (observer_bbob_open_file_t *) coco_allocate_memory(sizeof(*open_file));
+  open_file->data_file = coco_strdup(data_file);
+  open_file->next = index->open_data_files;
+  index->open_data_files = open_file;
+}
+
+/**
+ * Marks ${data_file} as closed.
+ */
+static void observer_bbob_index_close(observer_bbob_index_t *index, const char *data_file) {
+  observer_bbob_open_file_t **link, *open_file;
+
+  for (link = &index->open_data_files; *link != NULL; link = &(*link)->next) {
+    if (strcmp((*link)->data_file, data_file) == 0) {
+      open_file = *link;
+      *link = open_file->next;
+      coco_free_memory(open_file->data_file);
+      coco_free_memory(open_file);
+      return;
+    }
+  }
+}
+
+/**
+ * Appends a complete entry to the deferred entries.
+ */
+static void observer_bbob_index_defer(observer_bbob_index_t *index,
+                                      const char *index_file,
+                                      const char *data_file,
+                                      const size_t function_id,
+                                      const size_t number_of_variables,
+                                      const char *entry) {
+  observer_bbob_deferred_entry_t *deferred;
+
+  deferred = (observer_bbob_deferred_entry_t *) coco_allocate_memory(sizeof(*deferred));
+  deferred->index_file = coco_strdup(index_file);
+  deferred->data_file = coco_strdup(data_file);
+  deferred->function_id = function_id;
+  deferred->number_of_variables = number_of_variables;
+  deferred->entry = coco_strdup(entry);
+  deferred->next = NULL;
+  if (index->last_deferred_entry == NULL)
+    index->first_deferred_entry = deferred;
+  else
+    index->last_deferred_entry->next = deferred;
+  index->last_deferred_entry = deferred;
+}
+
+/**
+ * Frees the f target ladder of the bbob observer and releases its reference to the index bookkeeping.
+ */
+static void observer_bbob_free(void *stuff) {
+
+  observer_bbob_t *data;
+
+  assert(stuff != NULL);
+  data = stuff;
+
+  if (data->f_ladder != NULL) {
+    coco_free_memory(data->f_ladder);
+    data->f_ladder = NULL;
+  }
+  if (data->index != NULL) {
+    observer_bbob_index_release(data->index);
+    data->index = NULL;
+  }
+}
+
 /**
  * Initializes the bbob observer. Possible options:
  * - bbob_nbpts_nbevals: nb fun eval triggers are at 10**(i/bbob_nbpts_nbevals) (the default value in bbob is 20 )
  * - bbob_nbpts_fval: f value difference to the optimal triggers are at 10**(i/bbob_nbpts_fval)(the default value in bbob is 5 )
+ * - flush: never|problem_end|seconds:N|every:N (when the data files are flushed, see coco_flush_policy.c;
+ * the default value is seconds:1)
+ * - format: text|binary (format of the .dat, .tdat and .rdat files, see coco_log_format.c; the default value is text)
  */
 static void observer_bbob(coco_observer_t *self, const char *options) {
   
   observer_bbob_t *data;
+  size_t i;
   
   data = coco_allocate_memory(sizeof(*data));  
 
@@ -25,8 +266,21 @@ static void observer_bbob(coco_observer_t *self, const char *options) {
   if ((coco_options_read_size_t(options, "nbpts_fval", &(data->bbob_nbpts_fval)) == 0)) {
     data->bbob_nbpts_fval = 5;
   }
+  coco_flush_policy_read(options, &data->flush_policy);
+  data->format = coco_log_format_read(options);
+
+  /* Precompute the f targets (with the same expression as logger_bbob_update_f_trigger() for the others) */
+  data->f_ladder_first_index = -(int) (OBSERVER_BBOB_F_LADDER_DECADES * data->bbob_nbpts_fval);
+  data->f_ladder_length = 2 * OBSERVER_BBOB_F_LADDER_DECADES * data->bbob_nbpts_fval + 1;
+  data->f_ladder = coco_allocate_vector(data->f_ladder_length);
+  for (i = 0; i < data->f_ladder_length; i++) {
+    data->f_ladder[i] = pow(10, (data->f_ladder_first_index + (int) i) * 1.0
+        / (double) (long) data->bbob_nbpts_fval);
+  }
+
+  data->index = observer_bbob_index_allocate(self->algorithm_name);
 
   self->logger_initialize_function = logger_bbob;
-  self->data_free_function = NULL;
+  self->data_free_function = observer_bbob_free;
   self->data = data;
 }
@@ -1,12 +1,76 @@
+#include <assert.h>
+#include <string.h>
+
 #include "coco.h"
 #include "coco_internal.h"
 
 #include "coco_utilities.c"
+#include "coco_string.c"
 #include "mo_generics.c"
+#include "coco_log_format.c"
+
+/* Types of the biobjective logger (see logger_biobj.c) used by the indicators */
+typedef struct logger_biobj_s logger_biobj_t;
+typedef struct logger_biobj_indicator_s logger_biobj_indicator_t;
 
-/* List of implemented indicators */
-#define OBSERVER_BIOBJ_NUMBER_OF_INDICATORS 1
-const char *OBSERVER_BIOBJ_INDICATORS[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS] = { "hyp" };
+/**
+ * The interface of an indicator computed by the biobjective logger.
+ *
+ * Whenever the archive is updated, the logger first calls on_remove() for each of the solutions dominated by
+ * the new solution and then on_insert() with the position of the new solution in the archive, so that the
+ * indicators can maintain their values incrementally instead of rescanning the archive. If the size of the
+ * archive is bounded, on_remove() is also called for the nondominated solutions removed to keep the archive
+ * within its bound (with is_dominated set to 0). Solutions are passed by their position in the archive,
+ * where they still are during the call. The function value() is only called after updates and returns the
+ * value that is tested for target hits (the smaller, the better).
+ */
+typedef struct {
+  /* Name of the indicator to be used for identification and in the output */
+  const char *name;
+  /* Sets the best_value of the indicator and allocates its data for the given problem */
+  void (*initialize)(logger_biobj_indicator_t *indicator, logger_biobj_t *logger, coco_problem_t *problem);
+  void (*on_insert)(logger_biobj_indicator_t *indicator, logger_biobj_t *logger, coco_problem_t *problem,
+      const size_t position);
+  void (*on_remove)(logger_biobj_indicator_t *indicator, logger_biobj_t *logger, coco_problem_t *problem,
+      const size_t position, const int is_dominated);
+  double (*value)(logger_biobj_indicator_t *indicator, logger_biobj_t *logger, coco_problem_t *problem);
+  /* Frees the data of the indicator */
+  void (*free)(logger_biobj_indicator_t *indicator);
+} observer_biobj_indicator_type_t;
+
+static void logger_biobj_hyp_initialize(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem);
+static void logger_biobj_hyp_on_insert(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem, const size_t position);
+static void logger_biobj_hyp_on_remove(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem, const size_t position, const int is_dominated);
+static double logger_biobj_hyp_value(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem);
+static void logger_biobj_reference_set_initialize(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem);
+static void logger_biobj_igdp_on_insert(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem, const size_t position);
+static void logger_biobj_eps_on_insert(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem, const size_t position);
+static void logger_biobj_reference_set_on_remove(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem, const size_t position, const int is_dominated);
+static double logger_biobj_reference_set_value(logger_biobj_indicator_t *indicator, logger_biobj_t *logger,
+    coco_problem_t *problem);
+static void logger_biobj_reference_set_free(logger_biobj_indicator_t *indicator);
+
+/* List of implemented indicators:
+ * - hyp : hypervolume of the normalized archive within the ROI (difference to the best known value)
+ * - igdp : IGD+ (inverted generational distance plus) of the normalized archive to a reference set
+ * - eps : additive epsilon indicator of the normalized archive to a reference set */
+#define OBSERVER_BIOBJ_NUMBER_OF_INDICATORS 3
+static const observer_biobj_indicator_type_t OBSERVER_BIOBJ_INDICATORS[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS] = {
+    { "hyp", logger_biobj_hyp_initialize, logger_biobj_hyp_on_insert, logger_biobj_hyp_on_remove,
+        logger_biobj_hyp_value, NULL },
+    { "igdp", logger_biobj_reference_set_initialize, logger_biobj_igdp_on_insert,
+        logger_biobj_reference_set_on_remove, logger_biobj_reference_set_value, logger_biobj_reference_set_free },
+    { "eps", logger_biobj_reference_set_initialize, logger_biobj_eps_on_insert,
+        logger_biobj_reference_set_on_remove, logger_biobj_reference_set_value, logger_biobj_reference_set_free }
+};
 
 /* Logging nondominated solutions mode */
 typedef enum {
@@ -26,13 +90,71 @@ typedef struct {
   int compute_indicators;
   int produce_all_data;
 
+  /* The indicators to compute */
+  const observer_biobj_indicator_type_t *indicators[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS];
+  size_t number_of_indicators;
+  /* Folder with the reference sets for the igdp and eps indicators (NULL if not given) */
+  char *reference_sets_folder;
+
+  /* Maximal number of solutions in the archive (0 if unbounded) */
+  size_t archive_max_size;
+
+  /* Format of the indicator and nondominated solutions files */
+  coco_log_format_t format;
+
   /* Information on the previous logged problem */
   long previous_function;
+  long previous_dimension;
 
 } observer_biobj_t;
 
 static coco_problem_t *logger_biobj(coco_observer_t *self, coco_problem_t *problem);
 
+/**
+ * Frees the memory of the given biobjective observer.
+ */
+static void observer_biobj_free(void *stuff) {
+
+  observer_biobj_t *data;
+
+  assert(stuff != NULL);
+  data = stuff;
+
+  if (data->reference_sets_folder != NULL) {
+    coco_free_memory(data->reference_sets_folder);
+    data->reference_sets_folder = NULL;
+  }
+}
+
+/**
+ * Reads the comma-separated list of indicator names into the observer data (unknown and repeated names
+ * result in an error).
+ */
+static void observer_biobj_read_indicators(observer_biobj_t *data, const char *indicator_names) {
+
+  char **names;
+  size_t i, j, k;
+
+  data->number_of_indicators = 0;
+  names = coco_string_split(indicator_names, ',');
+  for (i = 0; names[i] != NULL; i++) {
+    for (k = 0; (k < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS)
+        && (strcmp(names[i], OBSERVER_BIOBJ_INDICATORS[k].name) != 0); k++)
+      ;
+    if (k == OBSERVER_BIOBJ_NUMBER_OF_INDICATORS)
+      coco_error("observer_biobj(): indicator '%s' not supported", names[i]);
+    for (j = 0; j < data->number_of_indicators; j++) {
+      if (data->indicators[j] == &OBSERVER_BIOBJ_INDICATORS[k])
+        coco_error("observer_biobj(): indicator '%s' given more than once", names[i]);
+    }
+    data->indicators[data->number_of_indicators++] = &OBSERVER_BIOBJ_INDICATORS[k];
+    coco_free_memory(names[i]);
+  }
+  coco_free_memory(names);
+  if (data->number_of_indicators == 0)
+    coco_error("observer_biobj(): no indicators given");
+}
+
 /**
  * Initializes the biobjective observer. Possible options:
  * - log_nondominated : none (don't log nondominated solutions)
@@ -45,11 +167,27 @@ static coco_problem_t *logger_biobj(coco_observer_t *self, coco_problem_t *probl
  * - produce_all_data: 0 / 1 (whether to produce all data; if set to 1, overwrites other options and is equivalent to
  * setting log_nondominated to all, log_decision_variables to log_dim and compute_indicators to 1; if set to 0, it
  * does not change the values of other options; default value is 0)
+ * - format : text / binary (format of the indicator and nondominated solutions files, see coco_log_format.c;
+ * default value is text)
+ * - log_indicators : comma-separated list of the indicators to compute out of hyp, igdp and eps (all of them are
+ * computed in the same run and logged into their own files; default value is hyp)
+ * - reference_sets : folder with the reference sets for the igdp and eps indicators, one file per problem named
+ * <problem_id>.txt with a pair of objective values on each line (lines starting with % are ignored); if not
+ * given or if the file of a problem does not exist, the reference set consists of the two extreme points of
+ * the Pareto front, (ideal_1, nadir_2) and (nadir_1, ideal_2), and a warning is issued (the igdp and eps
+ * values are then only rough measures of the convergence to the Pareto front)
+ * - archive_max_size : maximal number of solutions kept in the archive of the logger (0 means unbounded; default
+ * value is 0). When the archive is full, the solution with the smallest hypervolume contribution is removed, so
+ * that long runs on problems with continuous Pareto fronts use bounded memory. This requires compute_indicators
+ * to be 1 and the hyp indicator to be logged. All indicators are then computed exactly for the solutions in the
+ * bounded archive (and later solutions that would have been dominated by removed ones can enter the archive
+ * and be logged as nondominated).
  */
 static void observer_biobj(coco_observer_t *self, const char *options) {
 
   observer_biobj_t *data;
   char string_value[COCO_PATH_MAX];
+  size_t i;
 
   data = coco_allocate_memory(sizeof(*data));
 
@@ -75,6 +213,27 @@ static void observer_biobj(coco_observer_t *self, const char *options) {
   if (coco_options_read_int(options, "produce_all_data", &(data->produce_all_data)) == 0)
     data->produce_all_data = 0;
 
+  data->format = coco_log_format_read(options);
+
+  if (coco_options_read_string(options, "log_indicators", string_value) > 0)
+    observer_biobj_read_indicators(data, string_value);
+  else
+    observer_biobj_read_indicators(data, "hyp");
+
+  data->reference_sets_folder = NULL;
+  if (coco_options_read_string(options, "reference_sets", string_value) > 0)
+    data->reference_sets_folder = coco_strdup(string_value);
+  for (i = 0; i < data->number_of_indicators; i++) {
+    if ((data->reference_sets_folder == NULL)
+        && (data->indicators[i]->initialize == logger_biobj_reference_set_initialize)) {
+      coco_warning("observer_biobj(): no reference_sets given, the %s indicator uses the extreme points of the "
+          "Pareto front as the reference set", data->indicators[i]->name);
+    }
+  }
+
+  if (coco_options_read_size_t(options, "archive_max_size", &(data->archive_max_size)) == 0)
+    data->archive_max_size = 0;
+
   if (data->produce_all_data) {
     data->log_vars_mode = LOW_DIM;
     data->compute_indicators = 1;
@@ -83,10 +242,18 @@ static void observer_biobj(coco_observer_t *self, const char *options) {
 
   if (data->compute_indicators) {
     data->previous_function = -1;
+    data->previous_dimension = -1;
+  }
+
+  if (data->archive_max_size > 0) {
+    for (i = 0; (i < data->number_of_indicators) && (strcmp(data->indicators[i]->name, "hyp") != 0); i++)
+      ;
+    if (!data->compute_indicators || (i == data->number_of_indicators))
+      coco_error("observer_biobj(): archive_max_size requires the hyp indicator to be computed");
   }
 
   self->logger_initialize_function = logger_biobj;
-  self->data_free_function = NULL;
+  self->data_free_function = observer_biobj_free;
   self->data = data;
 
   if ((data->log_nondom_mode == NONE) && (!data->compute_indicators)) {
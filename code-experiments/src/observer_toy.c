@@ -1,5 +1,6 @@
 #include "coco.h"
 #include "coco_utilities.c"
+#include "coco_flush_policy.c"
 
 static coco_problem_t *logger_toy(coco_observer_t *observer, coco_problem_t *problem);
 
@@ -8,6 +9,7 @@ typedef struct {
   FILE *log_file;
   size_t number_of_targets;
   double *targets;
+  coco_flush_policy_t flush_policy;
 } observer_toy_t;
 
 /**
@@ -36,6 +38,8 @@ static void observer_toy_free(void *stuff) {
  * Initializes the toy observer. Possible options:
  * - file_name : name_of_the_output_file (name of the output file; default value is "first_hitting_times.txt")
  * - number_of_targets : 1-100 (number of targets; default value is 20)
+ * - flush : never|problem_end|seconds:N|every:N (when the output file is flushed, see coco_flush_policy.c;
+ * default value is seconds:1)
  */
 static void observer_toy(coco_observer_t *self, const char *options) {
 
@@ -55,6 +59,7 @@ static void observer_toy(coco_observer_t *self, const char *options) {
       || (data->number_of_targets < 1) || (data->number_of_targets > 100)) {
     data->number_of_targets = 20;
   }
+  coco_flush_policy_read(options, &data->flush_policy);
 
   /* Open log_file */
   file_name = (char *) coco_allocate_memory(COCO_PATH_MAX);
@@ -67,6 +72,7 @@ static void observer_toy(coco_observer_t *self, const char *options) {
     coco_error("observer_toy(): failed to open file %s.", file_name);
     return; /* Never reached */
   }
+  coco_flush_set_buffer(data->log_file);
 
   /* Compute targets */
   data->targets = coco_allocate_vector(data->number_of_targets);
@@ -1,4 +1,5 @@
 #include "coco.h"
+#include "coco_problem_cache.c"
 
 #include "f_attractive_sector.c"
 #include "f_bent_cigar.c"
@@ -27,6 +28,10 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name,
                                          const size_t *dimensions,
                                          const char *default_instances);
 
+/* The problem_id and problem_name of a BBOB problem are formatted from its function, instance and dimension */
+static const char suite_bbob_problem_id_template[] = "bbob_f%03lu_i%02lu_d%02lu";
+static const char suite_bbob_problem_name_template[] = "BBOB suite problem f%lu instance %lu in %luD";
+
 static coco_suite_t *suite_bbob_allocate(void) {
 
   coco_suite_t *suite;
@@ -57,8 +62,8 @@ static coco_problem_t *get_bbob_problem(const size_t function,
                                         const size_t instance) {
   coco_problem_t *problem = NULL;
 
-  const char *problem_id_template = "bbob_f%03lu_i%02lu_d%02lu";
-  const char *problem_name_template = "BBOB suite problem f%lu instance %lu in %luD";
+  const char *problem_id_template = suite_bbob_problem_id_template;
+  const char *problem_name_template = suite_bbob_problem_name_template;
 
   const long rseed = (long) (function + 10000 * instance);
   const long rseed_3 = (long) (3 + 10000 * instance);
@@ -144,6 +149,35 @@ static coco_problem_t *get_bbob_problem(const size_t function,
   return problem;
 }
 
+static coco_problem_t *suite_bbob_clone_problem(const coco_problem_t *problem);
+
+/**
+ * Creates a BBOB problem with folded linear transformations that is evaluated through a flat pipeline.
+ */
+static coco_problem_t *suite_bbob_construct_problem(const size_t function,
+                                                    const size_t dimension,
+                                                    const size_t instance) {
+  coco_problem_t *problem;
+
+  problem = get_bbob_problem(function, dimension, instance);
+  problem = transform_vars_affine_fold(problem);
+  problem = coco_transformed_flatten(problem);
+
+  problem->suite_dep_function = function;
+  problem->suite_dep_instance = instance;
+  problem->clone_problem = suite_bbob_clone_problem;
+
+  return problem;
+}
+
+/**
+ * Constructs a BBOB problem anew (without using the problem cache), see coco_problem_clone_for_thread().
+ */
+static coco_problem_t *suite_bbob_clone_problem(const coco_problem_t *problem) {
+  return suite_bbob_construct_problem(problem->suite_dep_function, problem->number_of_variables,
+      problem->suite_dep_instance);
+}
+
 static coco_problem_t *suite_bbob_get_problem(coco_suite_t *suite,
                                               const size_t function_idx,
                                               const size_t dimension_idx,
@@ -155,7 +189,8 @@ static coco_problem_t *suite_bbob_get_problem(coco_suite_t *suite,
   const size_t dimension = suite->dimensions[dimension_idx];
   const size_t instance = suite->instances[instance_idx];
 
-  problem = get_bbob_problem(function, dimension, instance);
+  problem = coco_problem_cache_get(suite->problem_cache, function, dimension, instance,
+      suite_bbob_construct_problem);
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
@@ -163,3 +198,23 @@ static coco_problem_t *suite_bbob_get_problem(coco_suite_t *suite,
 
   return problem;
 }
+
+/**
+ * Sets the problem_id, problem_name and number_of_objectives of a BBOB suite problem without constructing it.
+ */
+static void suite_bbob_get_problem_metadata(coco_suite_t *suite,
+                                            const size_t function_idx,
+                                            const size_t dimension_idx,
+                                            const size_t instance_idx,
+                                            char **problem_id,
+                                            char **problem_name,
+                                            size_t *number_of_objectives) {
+
+  const size_t function = suite->functions[function_idx];
+  const size_t dimension = suite->dimensions[dimension_idx];
+  const size_t instance = suite->instances[instance_idx];
+
+  *problem_id = coco_strdupf(suite_bbob_problem_id_template, function, instance, dimension);
+  *problem_name = coco_strdupf(suite_bbob_problem_name_template, function, instance, dimension);
+  *number_of_objectives = 1;
+}
@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include "coco.h"
+#include "coco_matrix.c"
 #define SUITE_BBOB2009_MAX_DIM 40
 
 static double bbob2009_fmin(double a, double b) {
@@ -25,33 +26,6 @@ static double bbob2009_round(double x) {
   return floor(x + 0.5);
 }
 
-/**
- * bbob2009_allocate_matrix(n, m):
- *
- * Allocate a ${n} by ${m} matrix structured as an array of pointers
- * to double arrays.
- */
-static double **bbob2009_allocate_matrix(const size_t n, const size_t m) {
-  double **matrix = NULL;
-  size_t i;
-  matrix = (double **) coco_allocate_memory(sizeof(double *) * n);
-  for (i = 0; i < n; ++i) {
-    matrix[i] = coco_allocate_vector(m);
-  }
-  return matrix;
-}
-
-static void bbob2009_free_matrix(double **matrix, const size_t n) {
-  size_t i;
-  for (i = 0; i < n; ++i) {
-    if (matrix[i] != NULL) {
-      coco_free_memory(matrix[i]);
-      matrix[i] = NULL;
-    }
-  }
-  coco_free_memory(matrix);
-}
-
 /**
  * bbob2009_unif(r, N, inseed):
  *
@@ -99,14 +73,17 @@ static void bbob2009_unif(double *r, size_t N, long inseed) {
 /**
  * bbob2009_reshape(B, vector, m, n):
  *
- * Convert from packed matrix storage to an array of array of double
- * representation.
+ * Convert from packed column-major storage to the row-major storage
+ * of the ${m} by ${n} matrix ${B}.
  */
-static double **bbob2009_reshape(double **B, double *vector, size_t m, size_t n) {
+static coco_matrix_t *bbob2009_reshape(coco_matrix_t *B, double *vector, size_t m, size_t n) {
   size_t i, j;
+  double *row;
+  assert(B->number_of_rows == m && B->number_of_columns == n);
   for (i = 0; i < m; i++) {
+    row = coco_matrix_row(B, i);
     for (j = 0; j < n; j++) {
-      B[i][j] = vector[j * m + i];
+      row[j] = vector[j * m + i];
     }
   }
   return B;
@@ -138,44 +115,45 @@ static void bbob2009_gauss(double *g, size_t N, long seed) {
  * Compute a ${DIM}x${DIM} rotation matrix based on ${seed} and store
  * it in ${B}.
  */
-static void bbob2009_compute_rotation(double **B, long seed, size_t DIM) {
+static void bbob2009_compute_rotation(coco_matrix_t *B, long seed, size_t DIM) {
   /* To ensure temporary data fits into gvec */
   double prod;
   double gvect[2000];
+  double *b = B->data;
   long i, j, k; /* Loop over pairs of column vectors. */
+  const long n = (long) DIM;
 
   assert(DIM * DIM < 2000);
 
   bbob2009_gauss(gvect, DIM * DIM, seed);
   bbob2009_reshape(B, gvect, DIM, DIM);
-  /*1st coordinate is row, 2nd is column.*/
+  /*1st coordinate is row, 2nd is column, B[k][i] is b[k * n + i].*/
 
-  for (i = 0; i < DIM; i++) {
+  for (i = 0; i < n; i++) {
     for (j = 0; j < i; j++) {
       prod = 0;
-      for (k = 0; k < DIM; k++)
-        prod += B[k][i] * B[k][j];
-      for (k = 0; k < DIM; k++)
-        B[k][i] -= prod * B[k][j];
+      for (k = 0; k < n; k++)
+        prod += b[k * n + i] * b[k * n + j];
+      for (k = 0; k < n; k++)
+        b[k * n + i] -= prod * b[k * n + j];
     }
     prod = 0;
-    for (k = 0; k < DIM; k++)
-      prod += B[k][i] * B[k][i];
-    for (k = 0; k < DIM; k++)
-      B[k][i] /= sqrt(prod);
+    for (k = 0; k < n; k++)
+      prod += b[k * n + i] * b[k * n + i];
+    for (k = 0; k < n; k++)
+      b[k * n + i] /= sqrt(prod);
   }
 }
 
-static void bbob2009_copy_rotation_matrix(double **rot, double *M, double *b, const size_t dimension) {
-  size_t row, column;
-  double *current_row;
+static void bbob2009_copy_rotation_matrix(const coco_matrix_t *rot, double *M, double *b, const size_t dimension) {
+  size_t i;
 
-  for (row = 0; row < dimension; ++row) {
-    current_row = M + row * dimension;
-    for (column = 0; column < dimension; ++column) {
-      current_row[column] = rot[row][column];
-    }
-    b[row] = 0.0;
+  assert(rot->number_of_rows == dimension && rot->number_of_columns == dimension);
+  for (i = 0; i < dimension * dimension; ++i) {
+    M[i] = rot->data[i];
+  }
+  for (i = 0; i < dimension; ++i) {
+    b[i] = 0.0;
   }
 }
 
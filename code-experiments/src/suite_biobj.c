@@ -13,6 +13,8 @@ static const size_t suite_biobj_instances[][3] = {
     { 5, 11, 12 }
 };
 
+static const char suite_biobj_problem_id_template[] = "bbob-biobj_f%02lu_i%02lu_d%02lu";
+
 /* Data for the biobjective suite */
 typedef struct {
 
@@ -58,21 +60,22 @@ static coco_suite_t *suite_biobj_allocate(void) {
   return suite;
 }
 
-static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
-                                               const size_t function_idx,
-                                               const size_t dimension_idx,
-                                               const size_t instance_idx) {
+/**
+ * Computes the BBOB functions and instances of the two objectives of the bi-objective problem with the given
+ * function_idx and instance. If the instance is not yet known, a new one is created and stored in the suite.
+ */
+static void suite_biobj_get_bbob_problems(coco_suite_t *suite,
+                                          const size_t function_idx,
+                                          const size_t instance,
+                                          size_t *function1,
+                                          size_t *function2,
+                                          size_t *instance1,
+                                          size_t *instance2) {
 
   const size_t num_bbob_functions = 10;
   const size_t bbob_functions[] = { 1, 2, 6, 8, 13, 14, 15, 17, 20, 21 };
 
-  coco_problem_t *problem1, *problem2, *problem = NULL;
   size_t function1_idx, function2_idx;
-  size_t instance1 = 0, instance2 = 0;
-
-  const size_t function = suite->functions[function_idx];
-  const size_t dimension = suite->dimensions[dimension_idx];
-  const size_t instance = suite->instances[instance_idx];
 
   suite_biobj_t *data = (suite_biobj_t *) suite->data;
   size_t i, j;
@@ -84,13 +87,15 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
       (size_t) (-0.5 + sqrt(0.25 + 2.0 * (double) (suite->number_of_functions - function_idx - 1))) - 1;
   function2_idx = function_idx - (function1_idx * num_bbob_functions) +
       (function1_idx * (function1_idx + 1)) / 2;
+  *function1 = bbob_functions[function1_idx];
+  *function2 = bbob_functions[function2_idx];
 
   /* First search for instance in suite_biobj_instances */
   for (i = 0; i < num_existing_instances; i++) {
     if (suite_biobj_instances[i][0] == instance) {
       /* The instance has been found in suite_biobj_instances */
-      instance1 = suite_biobj_instances[i][1];
-      instance2 = suite_biobj_instances[i][2];
+      *instance1 = suite_biobj_instances[i][1];
+      *instance2 = suite_biobj_instances[i][2];
       instance_found = 1;
       break;
     }
@@ -103,8 +108,8 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
         break;
       if (data->new_instances[i][0] == instance) {
         /* The instance has been found in new_instances */
-        instance1 = data->new_instances[i][1];
-        instance2 = data->new_instances[i][2];
+        *instance1 = data->new_instances[i][1];
+        *instance2 = data->new_instances[i][2];
         instance_found = 1;
         break;
       }
@@ -135,12 +140,41 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
     }
 
     /* A simple formula to set the first instance */
-    instance1 = 2 * instance + 1;
-    instance2 = suite_biobj_get_new_instance(suite, instance, instance1, num_bbob_functions, bbob_functions);
+    *instance1 = 2 * instance + 1;
+    *instance2 = suite_biobj_get_new_instance(suite, instance, *instance1, num_bbob_functions, bbob_functions);
   }
+}
+
+/**
+ * Stacks clones of the two single-objective problems of a bi-objective problem, see
+ * coco_problem_clone_for_thread(), which also copies the suite-specific problem_id, name and type.
+ */
+static coco_problem_t *suite_biobj_clone_problem(const coco_problem_t *problem) {
+  coco_stacked_problem_data_t *data = (coco_stacked_problem_data_t *) problem->data;
 
-  problem1 = get_bbob_problem(bbob_functions[function1_idx], dimension, instance1);
-  problem2 = get_bbob_problem(bbob_functions[function2_idx], dimension, instance2);
+  return coco_stacked_problem_allocate(coco_problem_clone_for_thread(data->problem1),
+      coco_problem_clone_for_thread(data->problem2));
+}
+
+static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
+                                               const size_t function_idx,
+                                               const size_t dimension_idx,
+                                               const size_t instance_idx) {
+
+  coco_problem_t *problem1, *problem2, *problem = NULL;
+  size_t function1 = 0, function2 = 0;
+  size_t instance1 = 0, instance2 = 0;
+
+  const size_t function = suite->functions[function_idx];
+  const size_t dimension = suite->dimensions[dimension_idx];
+  const size_t instance = suite->instances[instance_idx];
+
+  suite_biobj_get_bbob_problems(suite, function_idx, instance, &function1, &function2, &instance1, &instance2);
+
+  problem1 = coco_problem_cache_get(suite->problem_cache, function1, dimension, instance1,
+      suite_bbob_construct_problem);
+  problem2 = coco_problem_cache_get(suite->problem_cache, function2, dimension, instance2,
+      suite_bbob_construct_problem);
 
   problem = coco_stacked_problem_allocate(problem1, problem2);
 
@@ -150,14 +184,48 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
 
   /* Use the standard stacked problem_id as problem_name and construct a new suite-specific problem_id */
   coco_problem_set_name(problem, problem->problem_id);
-  coco_problem_set_id(problem, "bbob-biobj_f%02d_i%02ld_d%02d", function, instance, dimension);
+  coco_problem_set_id(problem, suite_biobj_problem_id_template, function, instance, dimension);
 
   /* Construct problem type */
   coco_problem_set_type(problem, "%s_%s", problem1->problem_type, problem2->problem_type);
 
+  problem->clone_problem = suite_biobj_clone_problem;
+
   return problem;
 }
 
+/**
+ * Sets the problem_id, problem_name and number_of_objectives of a bi-objective suite problem without
+ * constructing it. The problem_name is the problem_id of the stacked problem, see coco_stacked_problem_allocate().
+ */
+static void suite_biobj_get_problem_metadata(coco_suite_t *suite,
+                                             const size_t function_idx,
+                                             const size_t dimension_idx,
+                                             const size_t instance_idx,
+                                             char **problem_id,
+                                             char **problem_name,
+                                             size_t *number_of_objectives) {
+
+  size_t function1 = 0, function2 = 0;
+  size_t instance1 = 0, instance2 = 0;
+  char *problem1_id, *problem2_id;
+
+  const size_t function = suite->functions[function_idx];
+  const size_t dimension = suite->dimensions[dimension_idx];
+  const size_t instance = suite->instances[instance_idx];
+
+  suite_biobj_get_bbob_problems(suite, function_idx, instance, &function1, &function2, &instance1, &instance2);
+
+  problem1_id = coco_strdupf(suite_bbob_problem_id_template, function1, instance1, dimension);
+  problem2_id = coco_strdupf(suite_bbob_problem_id_template, function2, instance2, dimension);
+  *problem_name = coco_strdupf("%s__%s", problem1_id, problem2_id);
+  *problem_id = coco_strdupf(suite_biobj_problem_id_template, function, instance, dimension);
+  *number_of_objectives = 2;
+
+  coco_free_memory(problem1_id);
+  coco_free_memory(problem2_id);
+}
+
 static size_t suite_biobj_get_new_instance(coco_suite_t *suite,
                                            const size_t instance,
                                            const size_t instance1,
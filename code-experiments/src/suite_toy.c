@@ -22,18 +22,15 @@ static coco_suite_t *suite_toy_allocate(void) {
   return suite;
 }
 
-static coco_problem_t *suite_toy_get_problem(coco_suite_t *suite,
-                                             const size_t function_idx,
-                                             const size_t dimension_idx,
-                                             const size_t instance_idx) {
+static coco_problem_t *suite_toy_clone_problem(const coco_problem_t *problem);
 
+/**
+ * Constructs the toy suite problem of the given function and dimension.
+ */
+static coco_problem_t *suite_toy_construct_problem(const size_t function, const size_t dimension) {
 
   coco_problem_t *problem = NULL;
 
-  const size_t function = suite->functions[function_idx];
-  const size_t dimension = suite->dimensions[dimension_idx];
-  const size_t instance = suite->instances[instance_idx];
-
   if (function == 1) {
     problem = f_sphere_allocate(dimension);
   } else if (function == 2) {
@@ -48,11 +45,36 @@ static coco_problem_t *suite_toy_get_problem(coco_suite_t *suite,
   } else if (function == 6) {
     problem = f_rosenbrock_allocate(dimension);
   } else {
-    coco_error("suite_toy_get_problem(): function %lu does not exist in this suite", function);
+    coco_error("suite_toy_construct_problem(): function %lu does not exist in this suite", function);
     return NULL; /* Never reached */
   }
 
   problem->suite_dep_function = function;
+  problem->clone_problem = suite_toy_clone_problem;
+
+  return problem;
+}
+
+/**
+ * Constructs a toy suite problem anew, see coco_problem_clone_for_thread().
+ */
+static coco_problem_t *suite_toy_clone_problem(const coco_problem_t *problem) {
+  return suite_toy_construct_problem(problem->suite_dep_function, problem->number_of_variables);
+}
+
+static coco_problem_t *suite_toy_get_problem(coco_suite_t *suite,
+                                             const size_t function_idx,
+                                             const size_t dimension_idx,
+                                             const size_t instance_idx) {
+
+  coco_problem_t *problem = NULL;
+
+  const size_t function = suite->functions[function_idx];
+  const size_t dimension = suite->dimensions[dimension_idx];
+  const size_t instance = suite->instances[instance_idx];
+
+  problem = suite_toy_construct_problem(function, dimension);
+
   problem->suite_dep_instance = instance;
   problem->suite_dep_index = coco_suite_encode_problem_index(suite, function_idx, dimension_idx, instance_idx);
 
@@ -4,11 +4,13 @@
 #include "coco.h"
 #include "coco_problem.c"
 
-static void transform_obj_oscillate_evaluate(coco_problem_t *self, const double *x, double *y) {
+/**
+ * Oscillates the ${number_of_points} rows of objective values in ${y} in place.
+ */
+static void transform_obj_oscillate_apply(coco_problem_t *self, const size_t number_of_points, double *y) {
   static const double factor = 0.1;
   size_t i;
-  coco_evaluate_function(coco_transformed_get_inner_problem(self), x, y);
-  for (i = 0; i < self->number_of_objectives; i++) {
+  for (i = 0; i < number_of_points * self->number_of_objectives; i++) {
       if (y[i] != 0) {
           double log_y;
           log_y = log(fabs(y[i])) / factor;
@@ -21,6 +23,19 @@ static void transform_obj_oscillate_evaluate(coco_problem_t *self, const double
   }
 }
 
+static void transform_obj_oscillate_evaluate(coco_problem_t *self, const double *x, double *y) {
+  coco_evaluate_function(coco_transformed_get_inner_problem(self), x, y);
+  transform_obj_oscillate_apply(self, 1, y);
+}
+
+static void transform_obj_oscillate_evaluate_batch(coco_problem_t *self,
+                                                   const double *x,
+                                                   const size_t number_of_points,
+                                                   double *y) {
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), x, number_of_points, y);
+  transform_obj_oscillate_apply(self, number_of_points, y);
+}
+
 /**
  * Oscillate the objective value of the inner problem.
  *
@@ -30,6 +45,8 @@ static coco_problem_t *f_transform_obj_oscillate(coco_problem_t *inner_problem)
   coco_problem_t *self;
   self = coco_transformed_allocate(inner_problem, NULL, NULL);
   self->evaluate_function = transform_obj_oscillate_evaluate;
+  self->evaluate_function_batch = transform_obj_oscillate_evaluate_batch;
+  self->transform_objectives = transform_obj_oscillate_apply;
   /* Compute best value */
   /* Maybe not the most efficient solution */
   transform_obj_oscillate_evaluate(self, self->best_parameter, self->best_value);
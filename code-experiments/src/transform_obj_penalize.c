@@ -7,8 +7,10 @@ typedef struct {
   double factor;
 } transform_obj_penalize_data_t;
 
-static void transform_obj_penalize_evaluate(coco_problem_t *self, const double *x, double *y) {
-  transform_obj_penalize_data_t *data = coco_transformed_get_data(self);
+/**
+ * Returns the squared distance of ${x} to the region of interest of ${self}.
+ */
+static double transform_obj_penalize_penalty(coco_problem_t *self, const double *x) {
   const double *lower_bounds = self->smallest_values_of_interest;
   const double *upper_bounds = self->largest_values_of_interest;
   double penalty = 0.0;
@@ -23,6 +25,13 @@ static void transform_obj_penalize_evaluate(coco_problem_t *self, const double *
       penalty += c2 * c2;
     }
   }
+  return penalty;
+}
+
+static void transform_obj_penalize_evaluate(coco_problem_t *self, const double *x, double *y) {
+  transform_obj_penalize_data_t *data = coco_transformed_get_data(self);
+  const double penalty = transform_obj_penalize_penalty(self, x);
+  size_t i;
   assert(coco_transformed_get_inner_problem(self) != NULL);
   /*assert(problem->state != NULL);*/
   coco_evaluate_function(coco_transformed_get_inner_problem(self), x, y);
@@ -31,6 +40,23 @@ static void transform_obj_penalize_evaluate(coco_problem_t *self, const double *
   }
 }
 
+static void transform_obj_penalize_evaluate_batch(coco_problem_t *self,
+                                                  const double *x,
+                                                  const size_t number_of_points,
+                                                  double *y) {
+  transform_obj_penalize_data_t *data = coco_transformed_get_data(self);
+  double penalty;
+  size_t i, k;
+  assert(coco_transformed_get_inner_problem(self) != NULL);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), x, number_of_points, y);
+  for (k = 0; k < number_of_points; ++k) {
+    penalty = transform_obj_penalize_penalty(self, x + k * self->number_of_variables);
+    for (i = 0; i < self->number_of_objectives; ++i) {
+      y[k * self->number_of_objectives + i] += data->factor * penalty;
+    }
+  }
+}
+
 /**
  * Add a penalty to all evaluations outside of the region of interest
  * of ${inner_problem}.
@@ -45,6 +71,7 @@ static coco_problem_t *f_transform_obj_penalize(coco_problem_t *inner_problem, c
   data->factor = factor;
   self = coco_transformed_allocate(inner_problem, data, NULL);
   self->evaluate_function = transform_obj_penalize_evaluate;
+  self->evaluate_function_batch = transform_obj_penalize_evaluate_batch;
   /* No need to update the best value as the best parameter is feasible */
   return self;
 }
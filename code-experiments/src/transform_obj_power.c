@@ -8,16 +8,31 @@ typedef struct {
   double exponent;
 } transform_obj_power_data_t;
 
-static void transform_obj_power_evaluate(coco_problem_t *self, const double *x, double *y) {
+/**
+ * Raises the ${number_of_points} rows of objective values in ${y} to the power of the exponent.
+ */
+static void transform_obj_power_apply(coco_problem_t *self, const size_t number_of_points, double *y) {
   transform_obj_power_data_t *data;
   size_t i;
   data = coco_transformed_get_data(self);
-  coco_evaluate_function(coco_transformed_get_inner_problem(self), x, y);
-  for (i = 0; i < self->number_of_objectives; i++) {
+  for (i = 0; i < number_of_points * self->number_of_objectives; i++) {
       y[i] = pow(y[i], data->exponent);
   }
 }
 
+static void transform_obj_power_evaluate(coco_problem_t *self, const double *x, double *y) {
+  coco_evaluate_function(coco_transformed_get_inner_problem(self), x, y);
+  transform_obj_power_apply(self, 1, y);
+}
+
+static void transform_obj_power_evaluate_batch(coco_problem_t *self,
+                                               const double *x,
+                                               const size_t number_of_points,
+                                               double *y) {
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), x, number_of_points, y);
+  transform_obj_power_apply(self, number_of_points, y);
+}
+
 /**
  * Raise the objective value to the power of a given exponent.
  */
@@ -30,6 +45,8 @@ static coco_problem_t *f_transform_obj_power(coco_problem_t *inner_problem, cons
 
   self = coco_transformed_allocate(inner_problem, data, NULL);
   self->evaluate_function = transform_obj_power_evaluate;
+  self->evaluate_function_batch = transform_obj_power_evaluate_batch;
+  self->transform_objectives = transform_obj_power_apply;
   /* Compute best value */
   transform_obj_power_evaluate(self, self->best_parameter, self->best_value);
   return self;
@@ -7,16 +7,31 @@ typedef struct {
   double offset;
 } transform_obj_shift_data_t;
 
-static void transform_obj_shift_evaluate(coco_problem_t *self, const double *x, double *y) {
+/**
+ * Shifts the ${number_of_points} rows of objective values in ${y} in place.
+ */
+static void transform_obj_shift_apply(coco_problem_t *self, const size_t number_of_points, double *y) {
   transform_obj_shift_data_t *data;
   size_t i;
   data = coco_transformed_get_data(self);
-  coco_evaluate_function(coco_transformed_get_inner_problem(self), x, y);
-  for (i = 0; i < self->number_of_objectives; i++) {
+  for (i = 0; i < number_of_points * self->number_of_objectives; i++) {
       y[i] += data->offset;
   }
 }
 
+static void transform_obj_shift_evaluate(coco_problem_t *self, const double *x, double *y) {
+  coco_evaluate_function(coco_transformed_get_inner_problem(self), x, y);
+  transform_obj_shift_apply(self, 1, y);
+}
+
+static void transform_obj_shift_evaluate_batch(coco_problem_t *self,
+                                               const double *x,
+                                               const size_t number_of_points,
+                                               double *y) {
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), x, number_of_points, y);
+  transform_obj_shift_apply(self, number_of_points, y);
+}
+
 /**
  * Shift the objective value of the inner problem by offset.
  */
@@ -29,6 +44,8 @@ static coco_problem_t *f_transform_obj_shift(coco_problem_t *inner_problem, cons
 
   self = coco_transformed_allocate(inner_problem, data, NULL);
   self->evaluate_function = transform_obj_shift_evaluate;
+  self->evaluate_function_batch = transform_obj_shift_evaluate_batch;
+  self->transform_objectives = transform_obj_shift_apply;
   for (i = 0; i < self->number_of_objectives; i++) {
       self->best_value[0] += offset;
   }
@@ -1,40 +1,110 @@
 #include <assert.h>
+#include <math.h>
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_matrix.c"
+#include "transform_vars_conditioning.c"
+#include "transform_vars_scale.c"
+#include "transform_vars_shift.c"
 
 typedef struct {
-  double *M, *b, *x;
+  coco_matrix_t *M; /* inner_problem->number_of_variables rows, self->number_of_variables columns */
+  double *b, *x;
+  size_t x_capacity; /* the number of points x can hold (it only grows, see transform_vars_affine_evaluate_batch) */
+  int is_diagonal;  /* whether M is a square diagonal matrix */
 } transform_vars_affine_data_t;
 
+/**
+ * Computes Mx + b for the ${number_of_points} row-major points in ${x}, with the M and b of ${data}.
+ */
+static void transform_vars_affine_multiply(const transform_vars_affine_data_t *data,
+                                           const double *x,
+                                           const size_t number_of_points,
+                                           double *transformed_x) {
+  size_t i, k;
+  const size_t n = data->M->number_of_columns;
+
+  if (data->is_diagonal) {
+    /* Adding the zero products would not change the result */
+    for (k = 0; k < number_of_points; ++k) {
+      for (i = 0; i < n; ++i) {
+        transformed_x[k * n + i] = data->b[i] + x[k * n + i] * data->M->data[i * n + i];
+      }
+    }
+  } else if (number_of_points == 1) {
+    coco_matrix_multiply_vector(data->M, x, data->b, transformed_x);
+  } else {
+    coco_matrix_multiply_points(data->M, x, number_of_points, data->b, transformed_x);
+  }
+}
+
+/**
+ * Computes Mx + b for the ${number_of_points} row-major points in ${x}.
+ */
+static void transform_vars_affine_apply(coco_problem_t *self,
+                                        const double *x,
+                                        const size_t number_of_points,
+                                        double *transformed_x) {
+  transform_vars_affine_multiply(coco_transformed_get_data(self), x, number_of_points, transformed_x);
+}
+
 static void transform_vars_affine_evaluate(coco_problem_t *self, const double *x, double *y) {
-  size_t i, j;
   transform_vars_affine_data_t *data;
   coco_problem_t *inner_problem;
 
   data = coco_transformed_get_data(self);
   inner_problem = coco_transformed_get_inner_problem(self);
 
-  for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    /* data->M has self->number_of_variables columns and
-     * problem->inner_problem->number_of_variables rows.
-     */
-    const double *current_row = data->M + i * self->number_of_variables;
-    data->x[i] = data->b[i];
-    for (j = 0; j < self->number_of_variables; ++j) {
-      data->x[i] += x[j] * current_row[j];
-    }
-  }
+  transform_vars_affine_apply(self, x, 1, data->x);
   coco_evaluate_function(inner_problem, data->x, y);
 }
 
+static void transform_vars_affine_evaluate_batch(coco_problem_t *self,
+                                                 const double *x,
+                                                 const size_t number_of_points,
+                                                 double *y) {
+  transform_vars_affine_data_t *data;
+  coco_problem_t *inner_problem;
+
+  data = coco_transformed_get_data(self);
+  inner_problem = coco_transformed_get_inner_problem(self);
+
+  /* The scratch memory is kept for the next batches */
+  if (number_of_points > data->x_capacity) {
+    coco_free_memory(data->x);
+    data->x_capacity = number_of_points;
+    data->x = coco_allocate_vector(number_of_points * inner_problem->number_of_variables);
+  }
+  transform_vars_affine_apply(self, x, number_of_points, data->x);
+  coco_evaluate_function_batch(inner_problem, data->x, number_of_points, y);
+}
+
 static void transform_vars_affine_free(void *thing) {
   transform_vars_affine_data_t *data = thing;
-  coco_free_memory(data->M);
+  coco_matrix_free(data->M);
   coco_free_memory(data->b);
   coco_free_memory(data->x);
 }
 
+/**
+ * Returns 1 if the ${number_of_rows} x ${number_of_columns} matrix M is square and diagonal.
+ */
+static int transform_vars_affine_is_diagonal(const double *M,
+                                             const size_t number_of_rows,
+                                             const size_t number_of_columns) {
+  size_t i, j;
+  if (number_of_rows != number_of_columns)
+    return 0;
+  for (i = 0; i < number_of_rows; ++i) {
+    for (j = 0; j < number_of_columns; ++j) {
+      if (i != j && M[i * number_of_columns + j] != 0.0)
+        return 0;
+    }
+  }
+  return 1;
+}
+
 /*
  * FIXMEs:
  * - Calculate new smallest/largest values of interest?
@@ -54,15 +124,322 @@ static coco_problem_t *f_transform_vars_affine(coco_problem_t *inner_problem,
                                                const size_t number_of_variables) {
   coco_problem_t *self;
   transform_vars_affine_data_t *data;
-  size_t entries_in_M;
+  size_t entries_in_M, i;
 
   entries_in_M = inner_problem->number_of_variables * number_of_variables;
   data = coco_allocate_memory(sizeof(*data));
-  data->M = coco_duplicate_vector(M, entries_in_M);
+  data->M = coco_matrix_allocate(inner_problem->number_of_variables, number_of_variables);
+  for (i = 0; i < entries_in_M; ++i)
+    data->M->data[i] = M[i];
   data->b = coco_duplicate_vector(b, inner_problem->number_of_variables);
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->x_capacity = 1;
+  data->is_diagonal = transform_vars_affine_is_diagonal(M, inner_problem->number_of_variables,
+      number_of_variables);
 
   self = coco_transformed_allocate(inner_problem, data, transform_vars_affine_free);
   self->evaluate_function = transform_vars_affine_evaluate;
+  self->evaluate_function_batch = transform_vars_affine_evaluate_batch;
+  self->transform_variables = transform_vars_affine_apply;
   return self;
 }
+
+/**
+ * The kinds of stages of a folded layer (see transform_vars_affine_fold). Each stage computes exactly what
+ * the layer it replaces computes.
+ */
+typedef enum {
+  TRANSFORM_VARS_AFFINE_SHIFT,    /* x_i - offsets_i (shift) */
+  TRANSFORM_VARS_AFFINE_MULTIPLY, /* factors_i * x_i (scale, conditioning) */
+  TRANSFORM_VARS_AFFINE_DIAGONAL, /* offsets_i + x_i * factors_i (affine with a diagonal matrix) */
+  TRANSFORM_VARS_AFFINE_MATRIX    /* Mx + b (affine with any other square matrix) */
+} transform_vars_affine_stage_type_t;
+
+typedef struct {
+  transform_vars_affine_stage_type_t type;
+  double *factors, *offsets;            /* NULL if not used by the type */
+  transform_vars_affine_data_t *affine; /* only for TRANSFORM_VARS_AFFINE_MATRIX */
+} transform_vars_affine_stage_t;
+
+/**
+ * Data of a folded layer: the stages of the folded layers in the order in which they are applied to x,
+ * with at most one TRANSFORM_VARS_AFFINE_MATRIX stage.
+ */
+typedef struct {
+  transform_vars_affine_stage_t *stages;
+  size_t number_of_stages;
+  double *matrix_x, *transformed_x;
+  size_t capacity; /* the number of points matrix_x and transformed_x can hold (it only grows) */
+} transform_vars_affine_folded_data_t;
+
+static void transform_vars_affine_folded_free(void *thing) {
+  transform_vars_affine_folded_data_t *data = thing;
+  size_t s;
+  for (s = 0; s < data->number_of_stages; ++s) {
+    if (data->stages[s].factors != NULL)
+      coco_free_memory(data->stages[s].factors);
+    if (data->stages[s].offsets != NULL)
+      coco_free_memory(data->stages[s].offsets);
+    if (data->stages[s].affine != NULL) {
+      transform_vars_affine_free(data->stages[s].affine);
+      coco_free_memory(data->stages[s].affine);
+    }
+  }
+  coco_free_memory(data->stages);
+  coco_free_memory(data->matrix_x);
+  coco_free_memory(data->transformed_x);
+}
+
+/**
+ * Applies the coordinate-wise stages ${first} to ${last} - 1 in one pass to the ${number_of_points}
+ * row-major points of ${n} variables in ${x} and stores the results in ${transformed_x}, which can be ${x}.
+ */
+static void transform_vars_affine_apply_stages(const transform_vars_affine_stage_t *stages,
+                                               const size_t first,
+                                               const size_t last,
+                                               const size_t n,
+                                               const double *x,
+                                               const size_t number_of_points,
+                                               double *transformed_x) {
+  size_t i, k, s;
+  double t;
+
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      t = x[k * n + i];
+      for (s = first; s < last; ++s) {
+        if (stages[s].type == TRANSFORM_VARS_AFFINE_SHIFT)
+          t = t - stages[s].offsets[i];
+        else if (stages[s].type == TRANSFORM_VARS_AFFINE_MULTIPLY)
+          t = stages[s].factors[i] * t;
+        else
+          t = stages[s].offsets[i] + t * stages[s].factors[i];
+      }
+      transformed_x[k * n + i] = t;
+    }
+  }
+}
+
+/**
+ * Makes sure that the scratch memory of a folded layer with ${n} variables can hold ${number_of_points}
+ * points. It is kept for the next calls.
+ */
+static void transform_vars_affine_folded_reserve(transform_vars_affine_folded_data_t *data,
+                                                 const size_t number_of_points,
+                                                 const size_t n) {
+  if (number_of_points <= data->capacity)
+    return;
+  coco_free_memory(data->matrix_x);
+  coco_free_memory(data->transformed_x);
+  data->capacity = number_of_points;
+  data->matrix_x = coco_allocate_vector(number_of_points * n);
+  data->transformed_x = coco_allocate_vector(number_of_points * n);
+}
+
+/**
+ * Applies all stages of a folded layer to the ${number_of_points} row-major points in ${x}.
+ */
+static void transform_vars_affine_folded_apply(coco_problem_t *self,
+                                               const double *x,
+                                               const size_t number_of_points,
+                                               double *transformed_x) {
+  const size_t n = self->number_of_variables;
+  transform_vars_affine_folded_data_t *data;
+  size_t matrix_stage;
+
+  data = coco_transformed_get_data(self);
+  for (matrix_stage = 0; matrix_stage < data->number_of_stages; ++matrix_stage) {
+    if (data->stages[matrix_stage].type == TRANSFORM_VARS_AFFINE_MATRIX)
+      break;
+  }
+  if (matrix_stage == data->number_of_stages) {
+    transform_vars_affine_apply_stages(data->stages, 0, data->number_of_stages, n, x, number_of_points,
+        transformed_x);
+    return;
+  }
+
+  /* The stages before the matrix write to scratch memory, those after it work in place */
+  transform_vars_affine_folded_reserve(data, number_of_points, n);
+  transform_vars_affine_apply_stages(data->stages, 0, matrix_stage, n, x, number_of_points, data->matrix_x);
+  transform_vars_affine_multiply(data->stages[matrix_stage].affine, data->matrix_x, number_of_points,
+      transformed_x);
+  transform_vars_affine_apply_stages(data->stages, matrix_stage + 1, data->number_of_stages, n, transformed_x,
+      number_of_points, transformed_x);
+}
+
+static void transform_vars_affine_folded_evaluate(coco_problem_t *self, const double *x, double *y) {
+  transform_vars_affine_folded_data_t *data;
+
+  data = coco_transformed_get_data(self);
+  transform_vars_affine_folded_apply(self, x, 1, data->transformed_x);
+  coco_evaluate_function(coco_transformed_get_inner_problem(self), data->transformed_x, y);
+}
+
+static void transform_vars_affine_folded_evaluate_batch(coco_problem_t *self,
+                                                        const double *x,
+                                                        const size_t number_of_points,
+                                                        double *y) {
+  transform_vars_affine_folded_data_t *data;
+
+  data = coco_transformed_get_data(self);
+  transform_vars_affine_folded_reserve(data, number_of_points, self->number_of_variables);
+  transform_vars_affine_folded_apply(self, x, number_of_points, data->transformed_x);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), data->transformed_x, number_of_points, y);
+}
+
+/**
+ * Returns a vector of length ${n} with all elements equal to ${value}.
+ */
+static double *transform_vars_affine_constant_vector(const double value, const size_t n) {
+  double *vector = coco_allocate_vector(n);
+  size_t i;
+  for (i = 0; i < n; ++i)
+    vector[i] = value;
+  return vector;
+}
+
+/**
+ * Returns a copy of the affine transformation data ${affine} (of a square matrix).
+ */
+static transform_vars_affine_data_t *transform_vars_affine_duplicate_data(const transform_vars_affine_data_t *affine) {
+  transform_vars_affine_data_t *data;
+  const size_t n = affine->M->number_of_columns;
+  size_t i;
+
+  data = coco_allocate_memory(sizeof(*data));
+  data->M = coco_matrix_allocate(n, n);
+  for (i = 0; i < n * n; ++i)
+    data->M->data[i] = affine->M->data[i];
+  data->b = coco_duplicate_vector(affine->b, n);
+  data->x = coco_allocate_vector(n);
+  data->x_capacity = 1;
+  data->is_diagonal = affine->is_diagonal;
+  return data;
+}
+
+/**
+ * Returns the number of stages of a folded layer that can replace the layer ${problem} and, unless
+ * ${stages} is NULL, stores copies of them in ${stages}. Returns 0 if ${problem} is not a transformation of
+ * the variables that can be folded, that is, not a shift, scale, conditioning, square affine or folded
+ * layer. The number of TRANSFORM_VARS_AFFINE_MATRIX stages is added to ${number_of_matrices}.
+ */
+static size_t transform_vars_affine_get_stages(coco_problem_t *problem,
+                                               transform_vars_affine_stage_t *stages,
+                                               size_t *number_of_matrices) {
+  const size_t n = problem->number_of_variables;
+  transform_vars_affine_stage_t stage;
+  size_t s;
+
+  if (!coco_transformed_is_transformed(problem)
+      || coco_transformed_get_inner_problem(problem)->number_of_variables != n)
+    return 0;
+
+  if (problem->transform_variables == transform_vars_affine_folded_apply) {
+    transform_vars_affine_folded_data_t *data = coco_transformed_get_data(problem);
+    for (s = 0; s < data->number_of_stages; ++s) {
+      if (data->stages[s].type == TRANSFORM_VARS_AFFINE_MATRIX)
+        (*number_of_matrices)++;
+      if (stages == NULL)
+        continue;
+      stages[s].type = data->stages[s].type;
+      stages[s].factors = NULL;
+      stages[s].offsets = NULL;
+      stages[s].affine = NULL;
+      if (data->stages[s].factors != NULL)
+        stages[s].factors = coco_duplicate_vector(data->stages[s].factors, n);
+      if (data->stages[s].offsets != NULL)
+        stages[s].offsets = coco_duplicate_vector(data->stages[s].offsets, n);
+      if (data->stages[s].affine != NULL)
+        stages[s].affine = transform_vars_affine_duplicate_data(data->stages[s].affine);
+    }
+    return data->number_of_stages;
+  }
+
+  stage.factors = NULL;
+  stage.offsets = NULL;
+  stage.affine = NULL;
+  if (problem->transform_variables == transform_vars_shift_apply) {
+    stage.type = TRANSFORM_VARS_AFFINE_SHIFT;
+    if (stages != NULL)
+      stage.offsets = coco_duplicate_vector(((transform_vars_shift_data_t *) coco_transformed_get_data(problem))->offset, n);
+  } else if (problem->transform_variables == transform_vars_scale_apply) {
+    stage.type = TRANSFORM_VARS_AFFINE_MULTIPLY;
+    if (stages != NULL)
+      stage.factors = transform_vars_affine_constant_vector(
+          ((transform_vars_scale_data_t *) coco_transformed_get_data(problem))->factor, n);
+  } else if (problem->transform_variables == transform_vars_conditioning_apply) {
+    stage.type = TRANSFORM_VARS_AFFINE_MULTIPLY;
+    if (stages != NULL)
+      stage.factors = coco_duplicate_vector(
+          ((transform_vars_conditioning_data_t *) coco_transformed_get_data(problem))->coefficients, n);
+  } else if (problem->transform_variables == transform_vars_affine_apply) {
+    transform_vars_affine_data_t *data = coco_transformed_get_data(problem);
+    if (data->is_diagonal) {
+      stage.type = TRANSFORM_VARS_AFFINE_DIAGONAL;
+      if (stages != NULL) {
+        stage.factors = coco_allocate_vector(n);
+        for (s = 0; s < n; ++s)
+          stage.factors[s] = data->M->data[s * n + s];
+        stage.offsets = coco_duplicate_vector(data->b, n);
+      }
+    } else {
+      stage.type = TRANSFORM_VARS_AFFINE_MATRIX;
+      (*number_of_matrices)++;
+      if (stages != NULL)
+        stage.affine = transform_vars_affine_duplicate_data(data);
+    }
+  } else {
+    return 0;
+  }
+  if (stages != NULL)
+    stages[0] = stage;
+  return 1;
+}
+
+/**
+ * Folds adjacent shift, scale, conditioning and square affine transformations of the variables in the
+ * onion of ${problem} into single layers. Each folded layer saves a pass over x, a scratch vector and a
+ * level of indirection at every evaluation.
+ *
+ * The folded layer applies the operations of the layers it replaces in their original order (one pass over
+ * the coordinates for those that work coordinate-wise), so that the folded problem computes bit-identical
+ * values. Layers with a full matrix are therefore not multiplied with each other: at most one of them is
+ * part of a folded layer. All metadata such as best_parameter and best_value are kept from the original
+ * construction. Returns ${problem}, which is modified in place.
+ */
+static coco_problem_t *transform_vars_affine_fold(coco_problem_t *problem) {
+  coco_problem_t *outer, *inner;
+  transform_vars_affine_folded_data_t *data;
+  size_t number_of_outer_stages, number_of_inner_stages, number_of_matrices = 0;
+
+  outer = problem;
+  while (coco_transformed_is_transformed(outer)) {
+    inner = coco_transformed_get_inner_problem(outer);
+    number_of_matrices = 0;
+    number_of_outer_stages = transform_vars_affine_get_stages(outer, NULL, &number_of_matrices);
+    number_of_inner_stages = transform_vars_affine_get_stages(inner, NULL, &number_of_matrices);
+    if ((number_of_outer_stages == 0) || (number_of_inner_stages == 0) || (number_of_matrices > 1)) {
+      outer = inner;
+      continue;
+    }
+
+    /* x goes through the outer layer first */
+    data = coco_allocate_memory(sizeof(*data));
+    data->number_of_stages = number_of_outer_stages + number_of_inner_stages;
+    data->stages = coco_allocate_memory(data->number_of_stages * sizeof(*data->stages));
+    transform_vars_affine_get_stages(outer, data->stages, &number_of_matrices);
+    transform_vars_affine_get_stages(inner, data->stages + number_of_outer_stages, &number_of_matrices);
+    data->matrix_x = coco_allocate_vector(outer->number_of_variables);
+    data->transformed_x = coco_allocate_vector(outer->number_of_variables);
+    data->capacity = 1;
+
+    /* Turn the outer layer into the folded layer and drop the inner one. The outer layer is looked at
+     * again, as it may now be foldable with its new inner problem. */
+    coco_transformed_replace_data(outer, data, transform_vars_affine_folded_free);
+    outer->evaluate_function = transform_vars_affine_folded_evaluate;
+    outer->evaluate_function_batch = transform_vars_affine_folded_evaluate_batch;
+    outer->transform_variables = transform_vars_affine_folded_apply;
+    coco_transformed_remove_inner_problem(outer);
+  }
+  return problem;
+}
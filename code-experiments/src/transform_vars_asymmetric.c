@@ -10,32 +10,62 @@
 typedef struct {
   double *x;
   double beta;
+  double *slopes; /* beta * i / (D - 1) */
 } transform_vars_asymmetric_data_t;
 
-static void transform_vars_asymmetric_evaluate(coco_problem_t *self, const double *x, double *y) {
-  size_t i;
+/**
+ * Applies T_asy to the ${number_of_points} row-major points in ${x}.
+ */
+static void transform_vars_asymmetric_apply(coco_problem_t *self,
+                                            const double *x,
+                                            const size_t number_of_points,
+                                            double *asymmetric_x) {
+  size_t i, k;
   double exponent;
+  const size_t n = self->number_of_variables;
   transform_vars_asymmetric_data_t *data;
-  coco_problem_t *inner_problem;
 
   data = coco_transformed_get_data(self);
-  inner_problem = coco_transformed_get_inner_problem(self);
 
-  for (i = 0; i < self->number_of_variables; ++i) {
-    if (x[i] > 0.0) {
-      exponent = 1.0
-          + (data->beta * (double) (long) i) / ((double) (long) self->number_of_variables - 1.0) * sqrt(x[i]);
-      data->x[i] = pow(x[i], exponent);
-    } else {
-      data->x[i] = x[i];
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      if (x[k * n + i] > 0.0) {
+        exponent = 1.0 + data->slopes[i] * sqrt(x[k * n + i]);
+        asymmetric_x[k * n + i] = pow(x[k * n + i], exponent);
+      } else {
+        asymmetric_x[k * n + i] = x[k * n + i];
+      }
     }
   }
+}
+
+static void transform_vars_asymmetric_evaluate(coco_problem_t *self, const double *x, double *y) {
+  transform_vars_asymmetric_data_t *data;
+  coco_problem_t *inner_problem;
+
+  data = coco_transformed_get_data(self);
+  inner_problem = coco_transformed_get_inner_problem(self);
+
+  transform_vars_asymmetric_apply(self, x, 1, data->x);
   coco_evaluate_function(inner_problem, data->x, y);
 }
 
+static void transform_vars_asymmetric_evaluate_batch(coco_problem_t *self,
+                                                     const double *x,
+                                                     const size_t number_of_points,
+                                                     double *y) {
+  double *asymmetric_x;
+
+  asymmetric_x = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_asymmetric_apply(self, x, number_of_points, asymmetric_x);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), asymmetric_x, number_of_points, y);
+  coco_free_memory(asymmetric_x);
+}
+
 static void transform_vars_asymmetric_free(void *thing) {
   transform_vars_asymmetric_data_t *data = thing;
   coco_free_memory(data->x);
+  coco_free_memory(data->slopes);
 }
 
 /**
@@ -44,10 +74,18 @@ static void transform_vars_asymmetric_free(void *thing) {
 static coco_problem_t *f_transform_vars_asymmetric(coco_problem_t *inner_problem, const double beta) {
   transform_vars_asymmetric_data_t *data;
   coco_problem_t *self;
+  size_t i;
+  const size_t n = inner_problem->number_of_variables;
   data = coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->x = coco_allocate_vector(n);
   data->beta = beta;
+  data->slopes = coco_allocate_vector(n);
+  for (i = 0; i < n; ++i) {
+    data->slopes[i] = (beta * (double) (long) i) / ((double) (long) n - 1.0);
+  }
   self = coco_transformed_allocate(inner_problem, data, transform_vars_asymmetric_free);
   self->evaluate_function = transform_vars_asymmetric_evaluate;
+  self->evaluate_function_batch = transform_vars_asymmetric_evaluate_batch;
+  self->transform_variables = transform_vars_asymmetric_apply;
   return self;
 }
@@ -10,38 +10,65 @@
 
 typedef struct {
   double *x;
+  double *factors; /* sqrt(10)^(i / (D - 1)) */
 } transform_vars_brs_data_t;
 
-static void transform_vars_brs_evaluate(coco_problem_t *self, const double *x, double *y) {
-  size_t i;
+/**
+ * Applies the s_i scaling to the ${number_of_points} row-major points in ${x}.
+ */
+static void transform_vars_brs_apply(coco_problem_t *self,
+                                     const double *x,
+                                     const size_t number_of_points,
+                                     double *scaled_x) {
+  size_t i, k;
   double factor;
+  const size_t n = self->number_of_variables;
   transform_vars_brs_data_t *data;
-  coco_problem_t *inner_problem;
 
   data = coco_transformed_get_data(self);
-  inner_problem = coco_transformed_get_inner_problem(self);
 
-  for (i = 0; i < self->number_of_variables; ++i) {
-    /* Function documentation says we should compute 10^(0.5 *
-     * (i-1)/(D-1)). Instead we compute the equivalent
-     * sqrt(10)^((i-1)/(D-1)) just like the legacy code.
-     */
-    factor = pow(sqrt(10.0), (double) (long) i / ((double) (long) self->number_of_variables - 1.0));
-    /* Documentation specifies odd indexes and starts indexing
-     * from 1, we use all even indexes since C starts indexing
-     * with 0.
-     */
-    if (x[i] > 0.0 && i % 2 == 0) {
-      factor *= 10.0;
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      factor = data->factors[i];
+      /* Documentation specifies odd indexes and starts indexing
+       * from 1, we use all even indexes since C starts indexing
+       * with 0.
+       */
+      if (x[k * n + i] > 0.0 && i % 2 == 0) {
+        factor *= 10.0;
+      }
+      scaled_x[k * n + i] = factor * x[k * n + i];
     }
-    data->x[i] = factor * x[i];
   }
+}
+
+static void transform_vars_brs_evaluate(coco_problem_t *self, const double *x, double *y) {
+  transform_vars_brs_data_t *data;
+  coco_problem_t *inner_problem;
+
+  data = coco_transformed_get_data(self);
+  inner_problem = coco_transformed_get_inner_problem(self);
+
+  transform_vars_brs_apply(self, x, 1, data->x);
   coco_evaluate_function(inner_problem, data->x, y);
 }
 
+static void transform_vars_brs_evaluate_batch(coco_problem_t *self,
+                                              const double *x,
+                                              const size_t number_of_points,
+                                              double *y) {
+  double *scaled_x;
+
+  scaled_x = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_brs_apply(self, x, number_of_points, scaled_x);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), scaled_x, number_of_points, y);
+  coco_free_memory(scaled_x);
+}
+
 static void transform_vars_brs_free(void *thing) {
   transform_vars_brs_data_t *data = thing;
   coco_free_memory(data->x);
+  coco_free_memory(data->factors);
 }
 
 /**
@@ -50,9 +77,21 @@ static void transform_vars_brs_free(void *thing) {
 static coco_problem_t *f_transform_vars_brs(coco_problem_t *inner_problem) {
   transform_vars_brs_data_t *data;
   coco_problem_t *self;
+  size_t i;
+  const size_t n = inner_problem->number_of_variables;
   data = coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->x = coco_allocate_vector(n);
+  data->factors = coco_allocate_vector(n);
+  for (i = 0; i < n; ++i) {
+    /* Function documentation says we should compute 10^(0.5 *
+     * (i-1)/(D-1)). Instead we compute the equivalent
+     * sqrt(10)^((i-1)/(D-1)) just like the legacy code.
+     */
+    data->factors[i] = pow(sqrt(10.0), (double) (long) i / ((double) (long) n - 1.0));
+  }
   self = coco_transformed_allocate(inner_problem, data, transform_vars_brs_free);
   self->evaluate_function = transform_vars_brs_evaluate;
+  self->evaluate_function_batch = transform_vars_brs_evaluate_batch;
+  self->transform_variables = transform_vars_brs_apply;
   return self;
 }
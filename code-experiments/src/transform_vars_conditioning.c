@@ -10,29 +10,56 @@
 typedef struct {
   double *x;
   double alpha;
+  double *coefficients; /* alpha^(0.5 * i / (D - 1)) */
 } transform_vars_conditioning_data_t;
 
+/**
+ * Applies the conditioning to the ${number_of_points} row-major points in ${x}.
+ */
+static void transform_vars_conditioning_apply(coco_problem_t *self,
+                                              const double *x,
+                                              const size_t number_of_points,
+                                              double *conditioned_x) {
+  size_t i, k;
+  const size_t n = self->number_of_variables;
+  transform_vars_conditioning_data_t *data;
+
+  data = coco_transformed_get_data(self);
+
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      conditioned_x[k * n + i] = data->coefficients[i] * x[k * n + i];
+    }
+  }
+}
+
 static void transform_vars_conditioning_evaluate(coco_problem_t *self, const double *x, double *y) {
-  size_t i;
   transform_vars_conditioning_data_t *data;
   coco_problem_t *inner_problem;
 
   data = coco_transformed_get_data(self);
   inner_problem = coco_transformed_get_inner_problem(self);
 
-  for (i = 0; i < self->number_of_variables; ++i) {
-    /* OME: We could precalculate the scaling coefficients if we
-     * really wanted to.
-     */
-    data->x[i] = pow(data->alpha, 0.5 * (double) (long) i / ((double) (long) self->number_of_variables - 1.0))
-        * x[i];
-  }
+  transform_vars_conditioning_apply(self, x, 1, data->x);
   coco_evaluate_function(inner_problem, data->x, y);
 }
 
+static void transform_vars_conditioning_evaluate_batch(coco_problem_t *self,
+                                                       const double *x,
+                                                       const size_t number_of_points,
+                                                       double *y) {
+  double *conditioned_x;
+
+  conditioned_x = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_conditioning_apply(self, x, number_of_points, conditioned_x);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), conditioned_x, number_of_points, y);
+  coco_free_memory(conditioned_x);
+}
+
 static void transform_vars_conditioning_free(void *thing) {
   transform_vars_conditioning_data_t *data = thing;
   coco_free_memory(data->x);
+  coco_free_memory(data->coefficients);
 }
 
 /**
@@ -41,10 +68,18 @@ static void transform_vars_conditioning_free(void *thing) {
 static coco_problem_t *f_transform_vars_conditioning(coco_problem_t *inner_problem, const double alpha) {
   transform_vars_conditioning_data_t *data;
   coco_problem_t *self;
+  size_t i;
+  const size_t n = inner_problem->number_of_variables;
   data = coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->x = coco_allocate_vector(n);
   data->alpha = alpha;
+  data->coefficients = coco_allocate_vector(n);
+  for (i = 0; i < n; ++i) {
+    data->coefficients[i] = pow(alpha, 0.5 * (double) (long) i / ((double) (long) n - 1.0));
+  }
   self = coco_transformed_allocate(inner_problem, data, transform_vars_conditioning_free);
   self->evaluate_function = transform_vars_conditioning_evaluate;
+  self->evaluate_function_batch = transform_vars_conditioning_evaluate_batch;
+  self->transform_variables = transform_vars_conditioning_apply;
   return self;
 }
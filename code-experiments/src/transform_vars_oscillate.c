@@ -12,18 +12,18 @@ typedef struct {
   double *oscillated_x;
 } transform_vars_oscillate_data_t;
 
-static void transform_vars_oscillate_evaluate(coco_problem_t *self, const double *x, double *y) {
+/**
+ * Applies T_osz to the ${number_of_points} row-major points in ${x}.
+ */
+static void transform_vars_oscillate_apply(coco_problem_t *self,
+                                           const double *x,
+                                           const size_t number_of_points,
+                                           double *oscillated_x) {
   static const double alpha = 0.1;
-  double tmp, base, *oscillated_x;
+  double tmp, base;
   size_t i;
-  transform_vars_oscillate_data_t *data;
-  coco_problem_t *inner_problem;
 
-  data = coco_transformed_get_data(self);
-  oscillated_x = data->oscillated_x; /* short cut to make code more readable */
-  inner_problem = coco_transformed_get_inner_problem(self);
-
-  for (i = 0; i < self->number_of_variables; ++i) {
+  for (i = 0; i < number_of_points * self->number_of_variables; ++i) {
     if (x[i] > 0.0) {
       tmp = log(x[i]) / alpha;
       base = exp(tmp + 0.49 * (sin(tmp) + sin(0.79 * tmp)));
@@ -36,7 +36,29 @@ static void transform_vars_oscillate_evaluate(coco_problem_t *self, const double
       oscillated_x[i] = 0.0;
     }
   }
-  coco_evaluate_function(inner_problem, oscillated_x, y);
+}
+
+static void transform_vars_oscillate_evaluate(coco_problem_t *self, const double *x, double *y) {
+  transform_vars_oscillate_data_t *data;
+  coco_problem_t *inner_problem;
+
+  data = coco_transformed_get_data(self);
+  inner_problem = coco_transformed_get_inner_problem(self);
+
+  transform_vars_oscillate_apply(self, x, 1, data->oscillated_x);
+  coco_evaluate_function(inner_problem, data->oscillated_x, y);
+}
+
+static void transform_vars_oscillate_evaluate_batch(coco_problem_t *self,
+                                                    const double *x,
+                                                    const size_t number_of_points,
+                                                    double *y) {
+  double *oscillated_x;
+
+  oscillated_x = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_oscillate_apply(self, x, number_of_points, oscillated_x);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), oscillated_x, number_of_points, y);
+  coco_free_memory(oscillated_x);
 }
 
 static void transform_vars_oscillate_free(void *thing) {
@@ -55,5 +77,7 @@ static coco_problem_t *f_transform_vars_oscillate(coco_problem_t *inner_problem)
 
   self = coco_transformed_allocate(inner_problem, data, transform_vars_oscillate_free);
   self->evaluate_function = transform_vars_oscillate_evaluate;
+  self->evaluate_function_batch = transform_vars_oscillate_evaluate_batch;
+  self->transform_variables = transform_vars_oscillate_apply;
   return self;
 }
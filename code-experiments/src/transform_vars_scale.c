@@ -11,21 +11,46 @@ typedef struct {
   double *x;
 } transform_vars_scale_data_t;
 
-static void transform_vars_scale_evaluate(coco_problem_t *self, const double *x, double *y) {
+/**
+ * Scales the ${number_of_points} row-major points in ${x} and stores them in ${scaled_x}.
+ */
+static void transform_vars_scale_apply(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *scaled_x) {
   size_t i;
+  transform_vars_scale_data_t *data = coco_transformed_get_data(self);
+  const double factor = data->factor;
+
+  for (i = 0; i < number_of_points * self->number_of_variables; ++i) {
+    scaled_x[i] = factor * x[i];
+  }
+}
+
+static void transform_vars_scale_evaluate(coco_problem_t *self, const double *x, double *y) {
   transform_vars_scale_data_t *data;
   coco_problem_t *inner_problem;
   data = coco_transformed_get_data(self);
   inner_problem = coco_transformed_get_inner_problem(self);
-  do {
-    const double factor = data->factor;
-
-    for (i = 0; i < self->number_of_variables; ++i) {
-      data->x[i] = factor * x[i];
-    }
-    coco_evaluate_function(inner_problem, data->x, y);
-    assert(y[0] >= self->best_value[0]);
-  } while (0);
+  transform_vars_scale_apply(self, x, 1, data->x);
+  coco_evaluate_function(inner_problem, data->x, y);
+  assert(y[0] >= self->best_value[0]);
+}
+
+static void transform_vars_scale_evaluate_batch(coco_problem_t *self,
+                                                const double *x,
+                                                const size_t number_of_points,
+                                                double *y) {
+  size_t k;
+  double *scaled_x;
+
+  scaled_x = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_scale_apply(self, x, number_of_points, scaled_x);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), scaled_x, number_of_points, y);
+  coco_free_memory(scaled_x);
+  for (k = 0; k < number_of_points; ++k) {
+    assert(y[k * self->number_of_objectives] >= self->best_value[0]);
+  }
 }
 
 static void transform_vars_scale_free(void *thing) {
@@ -46,5 +71,7 @@ static coco_problem_t *f_transform_vars_scale(coco_problem_t *inner_problem, con
 
   self = coco_transformed_allocate(inner_problem, data, transform_vars_scale_free);
   self->evaluate_function = transform_vars_scale_evaluate;
+  self->evaluate_function_batch = transform_vars_scale_evaluate_batch;
+  self->transform_variables = transform_vars_scale_apply;
   return self;
 }
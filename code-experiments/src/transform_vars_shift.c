@@ -9,21 +9,53 @@ typedef struct {
   coco_free_function_t old_free_problem;
 } transform_vars_shift_data_t;
 
+/**
+ * Shifts the ${number_of_points} row-major points in ${x} and stores them in ${shifted_x}.
+ */
+static void transform_vars_shift_apply(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *shifted_x) {
+  size_t i, k;
+  const size_t n = self->number_of_variables;
+  transform_vars_shift_data_t *data;
+
+  data = coco_transformed_get_data(self);
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      shifted_x[k * n + i] = x[k * n + i] - data->offset[i];
+    }
+  }
+}
+
 static void transform_vars_shift_evaluate(coco_problem_t *self, const double *x, double *y) {
-  size_t i;
   transform_vars_shift_data_t *data;
   coco_problem_t *inner_problem;
 
   data = coco_transformed_get_data(self);
   inner_problem = coco_transformed_get_inner_problem(self);
 
-  for (i = 0; i < self->number_of_variables; ++i) {
-    data->shifted_x[i] = x[i] - data->offset[i];
-  }
+  transform_vars_shift_apply(self, x, 1, data->shifted_x);
   coco_evaluate_function(inner_problem, data->shifted_x, y);
   assert(y[0] >= self->best_value[0]);
 }
 
+static void transform_vars_shift_evaluate_batch(coco_problem_t *self,
+                                                const double *x,
+                                                const size_t number_of_points,
+                                                double *y) {
+  size_t k;
+  double *shifted_x;
+
+  shifted_x = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_shift_apply(self, x, number_of_points, shifted_x);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), shifted_x, number_of_points, y);
+  coco_free_memory(shifted_x);
+  for (k = 0; k < number_of_points; ++k) {
+    assert(y[k * self->number_of_objectives] >= self->best_value[0]);
+  }
+}
+
 static void transform_vars_shift_free(void *thing) {
   transform_vars_shift_data_t *data = thing;
   coco_free_memory(data->shifted_x);
@@ -48,6 +80,8 @@ static coco_problem_t *f_transform_vars_shift(coco_problem_t *inner_problem,
 
   self = coco_transformed_allocate(inner_problem, data, transform_vars_shift_free);
   self->evaluate_function = transform_vars_shift_evaluate;
+  self->evaluate_function_batch = transform_vars_shift_evaluate_batch;
+  self->transform_variables = transform_vars_shift_apply;
   /* Compute best parameter */
   for (i = 0; i < self->number_of_variables; i++) {
       self->best_parameter[i] += data->offset[i];
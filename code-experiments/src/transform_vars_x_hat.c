@@ -7,32 +7,58 @@
 typedef struct {
   long seed;
   double *x;
+  double *signs; /* the vector 1+- drawn once from seed */
   coco_free_function_t old_free_problem;
 } transform_vars_x_hat_data_t;
 
+/**
+ * Multiplies the ${number_of_points} row-major points in ${x} by the vector 1+-.
+ */
+static void transform_vars_x_hat_apply(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *x_hat) {
+  size_t i, k;
+  const size_t n = self->number_of_variables;
+  transform_vars_x_hat_data_t *data;
+
+  data = coco_transformed_get_data(self);
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      if (data->signs[i] < 0.0) {
+        x_hat[k * n + i] = -x[k * n + i];
+      } else {
+        x_hat[k * n + i] = x[k * n + i];
+      }
+    }
+  }
+}
+
 static void transform_vars_x_hat_evaluate(coco_problem_t *self, const double *x, double *y) {
-  size_t i;
   transform_vars_x_hat_data_t *data;
   coco_problem_t *inner_problem;
   data = coco_transformed_get_data(self);
   inner_problem = coco_transformed_get_inner_problem(self);
-  do {
-    bbob2009_unif(data->x, self->number_of_variables, data->seed);
+  transform_vars_x_hat_apply(self, x, 1, data->x);
+  coco_evaluate_function(inner_problem, data->x, y);
+}
 
-    for (i = 0; i < self->number_of_variables; ++i) {
-      if (data->x[i] - 0.5 < 0.0) {
-        data->x[i] = -x[i];
-      } else {
-        data->x[i] = x[i];
-      }
-    }
-    coco_evaluate_function(inner_problem, data->x, y);
-  } while (0);
+static void transform_vars_x_hat_evaluate_batch(coco_problem_t *self,
+                                                const double *x,
+                                                const size_t number_of_points,
+                                                double *y) {
+  double *x_hat;
+
+  x_hat = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_x_hat_apply(self, x, number_of_points, x_hat);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), x_hat, number_of_points, y);
+  coco_free_memory(x_hat);
 }
 
 static void transform_vars_x_hat_free(void *thing) {
   transform_vars_x_hat_data_t *data = thing;
   coco_free_memory(data->x);
+  coco_free_memory(data->signs);
 }
 
 /**
@@ -46,13 +72,20 @@ static coco_problem_t *f_transform_vars_x_hat(coco_problem_t *inner_problem, lon
   data = coco_allocate_memory(sizeof(*data));
   data->seed = seed;
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  /* The signs only depend on the seed, so they are drawn once instead of at every evaluation */
+  data->signs = coco_allocate_vector(inner_problem->number_of_variables);
+  bbob2009_unif(data->x, inner_problem->number_of_variables, data->seed);
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    data->signs[i] = (data->x[i] - 0.5 < 0.0) ? -1.0 : 1.0;
+  }
 
   self = coco_transformed_allocate(inner_problem, data, transform_vars_x_hat_free);
   self->evaluate_function = transform_vars_x_hat_evaluate;
+  self->evaluate_function_batch = transform_vars_x_hat_evaluate_batch;
+  self->transform_variables = transform_vars_x_hat_apply;
   /* Dirty way of setting the best parameter of the transformed f_schwefel... */
-  bbob2009_unif(data->x, self->number_of_variables, data->seed);
   for (i = 0; i < self->number_of_variables; ++i) {
-      if (data->x[i] - 0.5 < 0.0) {
+      if (data->signs[i] < 0.0) {
           self->best_parameter[i] = -0.5 * 4.2096874633;
       } else {
           self->best_parameter[i] = 0.5 * 4.2096874633;
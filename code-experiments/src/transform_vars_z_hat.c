@@ -9,23 +9,55 @@ typedef struct {
   coco_free_function_t old_free_problem;
 } transform_vars_z_hat_data_t;
 
+/**
+ * Computes {z^hat} for the ${number_of_points} row-major points in ${x}.
+ */
+static void transform_vars_z_hat_apply(coco_problem_t *self,
+                                       const double *x,
+                                       const size_t number_of_points,
+                                       double *z) {
+  size_t i, k;
+  const size_t n = self->number_of_variables;
+  transform_vars_z_hat_data_t *data;
+
+  data = coco_transformed_get_data(self);
+
+  for (k = 0; k < number_of_points; ++k) {
+    z[k * n] = x[k * n];
+    for (i = 1; i < n; ++i) {
+      z[k * n + i] = x[k * n + i] + 0.25 * (x[k * n + i - 1] - 2.0 * fabs(data->xopt[i - 1]));
+    }
+  }
+}
+
 static void transform_vars_z_hat_evaluate(coco_problem_t *self, const double *x, double *y) {
-  size_t i;
   transform_vars_z_hat_data_t *data;
   coco_problem_t *inner_problem;
 
   data = coco_transformed_get_data(self);
   inner_problem = coco_transformed_get_inner_problem(self);
 
-  data->z[0] = x[0];
-
-  for (i = 1; i < self->number_of_variables; ++i) {
-    data->z[i] = x[i] + 0.25 * (x[i - 1] - 2.0 * fabs(data->xopt[i - 1]));
-  }
+  transform_vars_z_hat_apply(self, x, 1, data->z);
   coco_evaluate_function(inner_problem, data->z, y);
   assert(y[0] >= self->best_value[0]);
 }
 
+static void transform_vars_z_hat_evaluate_batch(coco_problem_t *self,
+                                                const double *x,
+                                                const size_t number_of_points,
+                                                double *y) {
+  size_t k;
+  double *z;
+
+  z = coco_allocate_vector(number_of_points * self->number_of_variables);
+  transform_vars_z_hat_apply(self, x, number_of_points, z);
+  coco_evaluate_function_batch(coco_transformed_get_inner_problem(self), z, number_of_points, y);
+  coco_free_memory(z);
+  for (k = 0; k < number_of_points; ++k) {
+    assert(y[k * self->number_of_objectives] >= self->best_value[0]);
+  }
+}
+
 static void transform_vars_z_hat_free(void *thing) {
   transform_vars_z_hat_data_t *data = thing;
   coco_free_memory(data->xopt);
@@ -45,5 +77,7 @@ static coco_problem_t *f_transform_vars_z_hat(coco_problem_t *inner_problem, con
 
   self = coco_transformed_allocate(inner_problem, data, transform_vars_z_hat_free);
   self->evaluate_function = transform_vars_z_hat_evaluate;
+  self->evaluate_function_batch = transform_vars_z_hat_evaluate_batch;
+  self->transform_variables = transform_vars_z_hat_apply;
   return self;
 }
@@ -0,0 +1,72 @@
+/**
+ * Writes the same runs with the text and the binary output formats of the bbob and bbob-biobj observers.
+ * test_log_format.py then reads the binary files with the post-processing and compares them to the text
+ * files.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "coco.h"
+
+/**
+ * A random search.
+ */
+static void my_optimizer(coco_problem_t *problem, coco_random_state_t *rng) {
+
+  const size_t budget = 200;
+  const double *lbounds = coco_problem_get_smallest_values_of_interest(problem);
+  const double *ubounds = coco_problem_get_largest_values_of_interest(problem);
+  size_t dimension = coco_problem_get_dimension(problem);
+  size_t number_of_objectives = coco_problem_get_number_of_objectives(problem);
+  double *x = coco_allocate_vector(dimension);
+  double *y = coco_allocate_vector(number_of_objectives);
+  size_t i, j;
+
+  for (i = 0; i < budget; ++i) {
+    for (j = 0; j < dimension; ++j)
+      x[j] = lbounds[j] + coco_random_uniform(rng) * (ubounds[j] - lbounds[j]);
+    coco_evaluate_function(problem, x, y);
+  }
+
+  coco_free_memory(x);
+  coco_free_memory(y);
+}
+
+/**
+ * Runs the experiment on the ${suite_name} suite with the observer writing to ${result_folder} in the given
+ * ${format}.
+ */
+static void run_experiment(const char *suite_name, const char *result_folder, const char *format) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *rng = coco_random_new(0xdeadbeef);
+  char observer_options[200];
+
+  sprintf(observer_options, "result_folder: %s format: %s log_nondominated: all log_decision_variables: all log_level: warning",
+      result_folder, format);
+  coco_remove_directory(result_folder);
+  /* The two instances of a problem are two runs in the same data files */
+  suite = coco_suite(suite_name, NULL, "dimensions: 2,5 function_idx: 1,2,10 instance_idx: 1,2");
+  observer = coco_observer(suite_name, observer_options);
+  while ((problem = coco_suite_get_next_problem(suite, observer)) != NULL) {
+    my_optimizer(problem, rng);
+  }
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(rng);
+}
+
+int main(void) {
+
+  run_experiment("bbob", "log_format_text_bbob", "text");
+  run_experiment("bbob", "log_format_binary_bbob", "binary");
+  run_experiment("bbob-biobj", "log_format_text_biobj", "text");
+  run_experiment("bbob-biobj", "log_format_binary_biobj", "binary");
+
+  printf("Wrote the test data of test_log_format.py\n");
+  return 0;
+}
@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+"""Compares the binary data files written by test_log_format with the text
+files of the same runs. The binary files are read by the post-processing
+(readalign.readBinaryRuns), so that this tests the writer and the reader of
+the binary format together.
+
+Usage: python test_log_format.py [folder]
+
+where folder holds the result folders written by test_log_format (the
+current folder by default).
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+import re
+import sys
+
+try:
+    import numpy
+except ImportError:
+    print('test_log_format.py: numpy is not available, the test is skipped')
+    sys.exit(0)
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', '..', '..', 'code-postprocessing',
+                                'bbob_pproc'))
+import readalign
+
+# The text files round the values (the variables of the bbob files have
+# only 5 significant digits)
+relative_tolerance = 1e-4
+
+def read_text_runs(fil):
+    """Returns the runs of the text data file fil as a list of pairs
+    (header lines, array). The header of every run ends with the line
+    '% function evaluation | ...'."""
+
+    runs = []
+    with open(fil) as f:
+        for line in f:
+            if line.startswith('%'):
+                if (not runs or len(runs[-1][1])
+                        or runs[-1][0][-1].startswith('% function evaluation')):
+                    runs.append(([], []))
+                runs[-1][0].append(line)
+            elif line.strip():
+                runs[-1][1].append([float(value) for value in line.split()])
+    return [(header, numpy.array(rows)) for header, rows in runs]
+
+def compare_headers(fil, run, text_header, binary_header):
+    """Returns the differences between the fields of the text header lines
+    and the binary header."""
+
+    text = ''.join(text_header)
+    errors = []
+    for key, pattern in (('index', r'index = (\d+)'),
+                         ('instance', r'instance = (\d+)'),
+                         ('name', r'name = (\S+)')):
+        match = re.search(pattern, text)
+        if match:
+            value = int(match.group(1)) if key != 'name' else match.group(1)
+            if binary_header[key] != value:
+                errors.append('%s run %d: %s is %s instead of %s'
+                              % (fil, run, key, binary_header[key], value))
+    match = re.search(r'reference value = (\S+)|Fopt \((\S+)\)', text)
+    if match:
+        value = float(match.group(1) or match.group(2))
+        if not numpy.isclose(binary_header['reference'], value, rtol=1e-11):
+            errors.append('%s run %d: reference value is %r instead of %r'
+                          % (fil, run, binary_header['reference'], value))
+    if not binary_header['name']:
+        errors.append('%s run %d: no problem name' % (fil, run))
+    return errors
+
+def compare_files(text_file, binary_file):
+    """Returns the differences between the runs of the two files and the
+    number of runs compared."""
+
+    text_runs = read_text_runs(text_file)
+    binary_runs = readalign.readBinaryRuns(binary_file)
+    if len(text_runs) != len(binary_runs):
+        return ['%s: %d runs instead of %d' % (binary_file, len(binary_runs),
+                                               len(text_runs))], 0
+    errors = []
+    for run, ((text_header, text_data), (binary_header, binary_data)) in \
+            enumerate(zip(text_runs, binary_runs)):
+        errors.extend(compare_headers(binary_file, run, text_header,
+                                      binary_header))
+        if len(text_data) == 0 and len(binary_data) == 0:
+            continue
+        if numpy.shape(text_data) != numpy.shape(binary_data):
+            errors.append('%s run %d: shape %s instead of %s'
+                          % (binary_file, run, numpy.shape(binary_data),
+                             numpy.shape(text_data)))
+        elif not numpy.allclose(binary_data, text_data,
+                                rtol=relative_tolerance, atol=0):
+            errors.append('%s run %d: the values differ' % (binary_file, run))
+    return errors, len(text_runs)
+
+def main(folder):
+    errors = []
+    number_of_files = number_of_runs = 0
+    for suite in ('bbob', 'biobj'):
+        text_folder = os.path.join(folder, 'log_format_text_' + suite)
+        binary_folder = os.path.join(folder, 'log_format_binary_' + suite)
+        for root, dirs, files in os.walk(text_folder):
+            for name in sorted(files):
+                if name.endswith('.info'):
+                    continue
+                text_file = os.path.join(root, name)
+                binary_file = os.path.join(
+                    binary_folder, os.path.relpath(text_file, text_folder))
+                if not os.path.exists(binary_file):
+                    errors.append('%s is missing' % binary_file)
+                    continue
+                if not readalign.isBinary(binary_file):
+                    errors.append('%s is not a binary file' % binary_file)
+                    continue
+                file_errors, runs = compare_files(text_file, binary_file)
+                errors.extend(file_errors)
+                number_of_files += 1
+                number_of_runs += runs
+    for error in errors:
+        print(error)
+    print('test_log_format.py: %d files with %d runs compared, %d errors'
+          % (number_of_files, number_of_runs, len(errors)))
+    return 1 if errors or number_of_files == 0 else 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1] if len(sys.argv) > 1 else '.'))
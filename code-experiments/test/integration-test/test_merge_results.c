@@ -0,0 +1,89 @@
+/**
+ * Writes the results of a full run of the bbob and bbob-biobj suites and of the same runs split into batches
+ * (see the suite option batch). test_merge_results.py then merges the batches with
+ * code-experiments/tools/merge_results.py and compares the merged results to the ones of the full run.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "coco.h"
+
+#define NUMBER_OF_BATCHES 3
+
+/**
+ * A random search. The random numbers are seeded with the index of the problem in the suite, so that a
+ * problem is optimized in the same way in the full run and in its batch.
+ */
+static void my_optimizer(coco_problem_t *problem) {
+
+  const size_t budget = 100;
+  const double *lbounds = coco_problem_get_smallest_values_of_interest(problem);
+  const double *ubounds = coco_problem_get_largest_values_of_interest(problem);
+  size_t dimension = coco_problem_get_dimension(problem);
+  size_t number_of_objectives = coco_problem_get_number_of_objectives(problem);
+  coco_random_state_t *rng = coco_random_new((uint32_t) coco_problem_get_suite_dep_index(problem) + 1);
+  double *x = coco_allocate_vector(dimension);
+  double *y = coco_allocate_vector(number_of_objectives);
+  size_t i, j;
+
+  for (i = 0; i < budget; ++i) {
+    for (j = 0; j < dimension; ++j)
+      x[j] = lbounds[j] + coco_random_uniform(rng) * (ubounds[j] - lbounds[j]);
+    coco_evaluate_function(problem, x, y);
+  }
+
+  coco_free_memory(x);
+  coco_free_memory(y);
+  coco_random_free(rng);
+}
+
+/**
+ * Runs the experiment on the problems of the ${suite_name} suite with the given ${suite_options} and writes
+ * the results to ${result_folder}.
+ */
+static void run_experiment(const char *suite_name, const char *suite_options, const char *result_folder) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  char observer_options[200];
+
+  sprintf(observer_options, "result_folder: %s algorithm_name: RS log_level: warning", result_folder);
+  coco_remove_directory(result_folder);
+  suite = coco_suite(suite_name, NULL, suite_options);
+  observer = coco_observer(suite_name, observer_options);
+  while ((problem = coco_suite_get_next_problem(suite, observer)) != NULL) {
+    my_optimizer(problem);
+  }
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+}
+
+/**
+ * Runs the full experiment on the ${suite_name} suite and each of its batches.
+ */
+static void run_experiments(const char *suite_name, const char *folder_suffix) {
+
+  const char *suite_options = "dimensions: 2,3,5 function_idx: 1,2,10 instance_idx: 1-3";
+  char batch_options[200], result_folder[200];
+  int batch;
+
+  sprintf(result_folder, "merge_results_full_%s", folder_suffix);
+  run_experiment(suite_name, suite_options, result_folder);
+  for (batch = 1; batch <= NUMBER_OF_BATCHES; batch++) {
+    sprintf(batch_options, "%s batch: %d/%d", suite_options, batch, NUMBER_OF_BATCHES);
+    sprintf(result_folder, "merge_results_batch%d_%s", batch, folder_suffix);
+    run_experiment(suite_name, batch_options, result_folder);
+  }
+}
+
+int main(void) {
+
+  run_experiments("bbob", "bbob");
+  run_experiments("bbob-biobj", "biobj");
+
+  printf("Wrote the test data of test_merge_results.py\n");
+  return 0;
+}
@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+"""Merges the batches written by test_merge_results with
+code-experiments/tools/merge_results.py and compares the merged folders
+with the folders of the full runs: all data files must be the same, and
+the index files must have the same entries (maybe in a different order).
+
+Usage: python test_merge_results.py [folder]
+
+where folder holds the result folders written by test_merge_results (the
+current folder by default).
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+import shutil
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', '..', 'tools'))
+from merge_results import merge_results
+
+number_of_batches = 3
+
+def list_files(folder):
+    """Returns the paths of all files in folder (relative to it)."""
+    result = []
+    for root, dirs, files in os.walk(folder):
+        for name in files:
+            result.append(os.path.relpath(os.path.join(root, name), folder))
+    return sorted(result)
+
+def read_index_entries(fil):
+    """Returns the entries of the index file fil: a list of its header
+    lines (if it is a bi-objective index file) and the sorted list of its
+    entries. The entry of a single-objective index file is a block of a
+    header line, a comment line and a data line, the one of a bi-objective
+    index file is a line."""
+    with open(fil) as f:
+        lines = [line.rstrip() for line in f if line.strip()]
+    if lines and lines[0].startswith('algorithm'):
+        return lines[:2], sorted(lines[2:])
+    entries = []
+    for line in lines:
+        if line.startswith('funcId') or not entries:
+            entries.append([])
+        entries[-1].append(line)
+    return [], sorted(entries)
+
+def compare_folders(full_folder, merged_folder):
+    """Returns the differences between the two folders and the number of
+    files compared."""
+    errors = []
+    full_files = list_files(full_folder)
+    merged_files = list_files(merged_folder)
+    for path in sorted(set(full_files) ^ set(merged_files)):
+        errors.append('%s is only in %s' % (path, full_folder if path in full_files
+                                            else merged_folder))
+    for path in sorted(set(full_files) & set(merged_files)):
+        full_file = os.path.join(full_folder, path)
+        merged_file = os.path.join(merged_folder, path)
+        if path.endswith('.info'):
+            if read_index_entries(full_file) != read_index_entries(merged_file):
+                errors.append('%s: the index entries differ' % merged_file)
+        else:
+            with open(full_file, 'rb') as f1, open(merged_file, 'rb') as f2:
+                if f1.read() != f2.read():
+                    errors.append('%s: the contents differ' % merged_file)
+    return errors, len(full_files)
+
+def main(folder):
+    errors = []
+    number_of_files = 0
+    for suite in ('bbob', 'biobj'):
+        merged_folder = os.path.join(folder, 'merge_results_merged_' + suite)
+        if os.path.exists(merged_folder):
+            shutil.rmtree(merged_folder)
+        merge_results(merged_folder,
+                      [os.path.join(folder, 'merge_results_batch%d_%s' % (batch, suite))
+                       for batch in range(1, number_of_batches + 1)])
+        suite_errors, files = compare_folders(
+            os.path.join(folder, 'merge_results_full_' + suite), merged_folder)
+        errors.extend(suite_errors)
+        number_of_files += files
+    for error in errors:
+        print(error)
+    print('test_merge_results.py: %d files compared, %d errors'
+          % (number_of_files, len(errors)))
+    return 1 if errors or number_of_files == 0 else 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1] if len(sys.argv) > 1 else '.'))
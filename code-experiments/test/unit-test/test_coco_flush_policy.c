@@ -0,0 +1,56 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include "coco.h"
+
+/**
+ * Tests the flush policies read from the observer options and when they ask for a flush.
+ */
+static void test_coco_flush_after_evaluation(void **state) {
+
+  coco_flush_policy_t policy;
+  coco_flush_state_t flush_state;
+  size_t i, number_of_flushes;
+
+  coco_flush_policy_read("flush: every:3", &policy);
+  coco_flush_state_reset(&flush_state);
+  for (i = 1; i <= 9; i++)
+    assert_int_equal(coco_flush_after_evaluation(&policy, &flush_state), (i % 3 == 0));
+
+  /* seconds:0 flushes after each evaluation */
+  coco_flush_policy_read("flush: seconds:0", &policy);
+  coco_flush_state_reset(&flush_state);
+  for (i = 1; i <= 3; i++)
+    assert_true(coco_flush_after_evaluation(&policy, &flush_state));
+
+  coco_flush_policy_read("flush: never", &policy);
+  coco_flush_state_reset(&flush_state);
+  for (i = 1; i <= 3; i++)
+    assert_false(coco_flush_after_evaluation(&policy, &flush_state));
+
+  /* The default policy seconds:1 flushes at the first evaluation after a second. During fast
+   * evaluations, it reads the clock less and less often. */
+  coco_flush_policy_read("", &policy);
+  assert_true(policy.mode == COCO_FLUSH_SECONDS);
+  coco_flush_state_reset(&flush_state);
+  flush_state.last_flush -= 10;
+  assert_true(coco_flush_after_evaluation(&policy, &flush_state));
+  number_of_flushes = 0;
+  for (i = 0; i < 100; i++)
+    number_of_flushes += (size_t) coco_flush_after_evaluation(&policy, &flush_state);
+  assert_true(number_of_flushes <= 1);
+  assert_true(flush_state.check_interval >= 16);
+  assert_true(flush_state.check_interval <= COCO_FLUSH_MAX_CHECK_INTERVAL);
+
+  (void)state; /* unused */
+}
+
+static int test_all_coco_flush_policy(void) {
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_coco_flush_after_evaluation)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,57 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include "coco.h"
+
+/**
+ * Tests that coco_format_exponential() produces the same output as sprintf() for special values, exact
+ * ties, values with large and small exponents and random values at all precisions used by the loggers.
+ */
+static void test_coco_format_exponential(void **state) {
+
+  const double special_values[] = { 0.0, -0.0, 1.0, -1.0, 0.5, 0.125, 2.5, 9.5, 0.99999999995, 9.9999999995,
+      1e-8, 1e10, 1e22, 1e23, 1e-30, 1e300, 1e-310, DBL_MAX, DBL_MIN, 123456789012345678.0 };
+  const int precisions[] = { 0, 1, 4, 8, 9, 15, 16, 17, 20 };
+  coco_random_state_t *random_generator;
+  char actual[COCO_FORMAT_BUFFER_SIZE], expected[COCO_FORMAT_BUFFER_SIZE];
+  double value;
+  size_t i, j, length;
+  int force_sign;
+
+  random_generator = coco_random_new(0xF0F0);
+
+  for (i = 0; i < 4000; i++) {
+    if (i < sizeof(special_values) / sizeof(double))
+      value = special_values[i];
+    else if (i % 2 == 0)
+      value = coco_random_normal(random_generator) * 5;
+    else
+      value = pow(10, coco_random_uniform(random_generator) * 60 - 30) * coco_random_normal(random_generator);
+    for (j = 0; j < sizeof(precisions) / sizeof(int); j++) {
+      force_sign = (int) (i % 2);
+      length = coco_format_exponential(actual, value, 10, precisions[j], force_sign);
+      sprintf(expected, force_sign ? "%+10.*e" : "%10.*e", precisions[j], value);
+      assert_string_equal(actual, expected);
+      assert_int_equal(length, strlen(expected));
+    }
+  }
+
+  length = coco_format_unsigned_long(actual, 1234567890UL);
+  assert_string_equal(actual, "1234567890");
+  assert_int_equal(length, 10);
+  coco_format_unsigned_long(actual, 0);
+  assert_string_equal(actual, "0");
+
+  coco_random_free(random_generator);
+  (void)state; /* unused */
+}
+
+static int test_all_coco_format(void) {
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_coco_format_exponential)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,94 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include "coco.h"
+
+/**
+ * Tests that matrices are aligned and that the matrix-vector product matches the naive double loop
+ * exactly for all shapes that exercise both the blocked and the remainder rows.
+ */
+static void test_coco_matrix_multiply_vector(void **state) {
+
+  coco_matrix_t *matrix;
+  coco_random_state_t *random_generator;
+  double x[41], y[41], expected;
+  size_t number_of_rows, number_of_columns, i, j;
+
+  random_generator = coco_random_new(0xC0C0);
+
+  for (number_of_rows = 1; number_of_rows <= 41; number_of_rows += 5) {
+    for (number_of_columns = 1; number_of_columns <= 41; number_of_columns += 8) {
+      matrix = coco_matrix_allocate(number_of_rows, number_of_columns);
+      assert_int_equal((size_t) matrix->data % COCO_MATRIX_ALIGNMENT, 0);
+
+      for (i = 0; i < number_of_rows * number_of_columns; i++)
+        matrix->data[i] = coco_random_normal(random_generator);
+      for (j = 0; j < number_of_columns; j++)
+        x[j] = coco_random_normal(random_generator);
+
+      coco_matrix_multiply_vector(matrix, x, NULL, y);
+      for (i = 0; i < number_of_rows; i++) {
+        expected = 0.0;
+        for (j = 0; j < number_of_columns; j++)
+          expected += coco_matrix_row(matrix, i)[j] * x[j];
+        assert_true(y[i] == expected);
+      }
+      coco_matrix_free(matrix);
+    }
+  }
+
+  coco_random_free(random_generator);
+  (void)state; /* unused */
+}
+
+/**
+ * Tests that the matrix-points product matches the matrix-vector product on every point exactly,
+ * including matrices with more rows than a row block and numbers of points that are not multiples
+ * of the tile size.
+ */
+static void test_coco_matrix_multiply_points(void **state) {
+
+  coco_matrix_t *matrix;
+  coco_random_state_t *random_generator;
+  const size_t number_of_rows[3] = { 3, 40, 70 };
+  double x[9 * 40], y[9 * 70], expected[70], b[70];
+  size_t rows_idx, number_of_columns, number_of_points, i, k;
+
+  random_generator = coco_random_new(0xC0C0);
+
+  for (rows_idx = 0; rows_idx < 3; rows_idx++) {
+    for (number_of_columns = 1; number_of_columns <= 40; number_of_columns += 13) {
+      matrix = coco_matrix_allocate(number_of_rows[rows_idx], number_of_columns);
+      for (i = 0; i < number_of_rows[rows_idx] * number_of_columns; i++)
+        matrix->data[i] = coco_random_normal(random_generator);
+      for (i = 0; i < number_of_rows[rows_idx]; i++)
+        b[i] = coco_random_normal(random_generator);
+
+      for (number_of_points = 1; number_of_points <= 9; number_of_points++) {
+        for (i = 0; i < number_of_points * number_of_columns; i++)
+          x[i] = coco_random_normal(random_generator);
+        coco_matrix_multiply_points(matrix, x, number_of_points, b, y);
+        for (k = 0; k < number_of_points; k++) {
+          coco_matrix_multiply_vector(matrix, x + k * number_of_columns, b, expected);
+          for (i = 0; i < number_of_rows[rows_idx]; i++)
+            assert_true(y[k * number_of_rows[rows_idx] + i] == expected[i]);
+        }
+      }
+      coco_matrix_free(matrix);
+    }
+  }
+
+  coco_random_free(random_generator);
+  (void)state; /* unused */
+}
+
+static int test_all_coco_matrix(void) {
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_coco_matrix_multiply_vector),
+      cmocka_unit_test(test_coco_matrix_multiply_points)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -5,18 +5,22 @@
 #include "coco.h"
 
 /**
- * Tests the function coco_observer_evaluation_to_log.
+ * Tests the function coco_observer_next_evaluation_to_log.
  */
-static void test_coco_observer_evaluation_to_log(void **state) {
+static void test_coco_observer_next_evaluation_to_log(void **state) {
 
   size_t dimensions[6] = { 2, 3, 5, 10, 20, 40 };
-  size_t evals, i, dim;
+  size_t evals, next, i, dim;
   int result;
 
   for (i = 0; i < 6; i++) {
     dim = dimensions[i];
+    next = coco_observer_next_evaluation_to_log(0, dim);
     for (evals = 1; evals < 1500; evals++) {
-      result = coco_observer_evaluation_to_log(evals, dim);
+      result = (evals == next);
+      if (result)
+        next = coco_observer_next_evaluation_to_log(evals, dim);
+      assert_true(next > evals);
       if ((evals == 1) || (evals == dim) || (evals == 2 * dim) || (evals == 5 * dim))
         assert(result);
       else if ((evals == 10 * dim) || (evals == 20 * dim) || (evals == 50 * dim))
@@ -31,10 +35,79 @@ static void test_coco_observer_evaluation_to_log(void **state) {
   (void)state; /* unused */
 }
 
+/**
+ * Returns the contents of the text file ${path}.
+ */
+static char *test_coco_observer_read_file(const char *path) {
+
+  FILE *file;
+  char *contents;
+  size_t length;
+
+  file = fopen(path, "r");
+  assert_true(file != NULL);
+  contents = (char *) coco_allocate_memory(10000);
+  length = fread(contents, 1, 9999, file);
+  contents[length] = '\0';
+  fclose(file);
+  return contents;
+}
+
+/**
+ * Tests the index file of the bbob observer when two problems are observed at the same time: the entry of
+ * the first logger is started when it is initialized, and the entry of the second logger, which is freed
+ * first, is deferred until the first one is finished.
+ */
+static void test_coco_observer_bbob_index(void **state) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem1, *problem2;
+  char index_file[COCO_PATH_MAX] = { 0 };
+  char *contents;
+  double x[2] = { 0, 0 }, y[1];
+
+  suite = coco_suite("bbob", NULL, "function_idx: 1 dimensions: 2 instance_idx: 1-2");
+  observer = coco_observer("bbob", "result_folder: test_bbob_index algorithm_name: ALG log_level: warning");
+  coco_join_path(index_file, sizeof(index_file), observer->output_folder, "bbobexp_f1_i1.info", NULL);
+
+  problem1 = coco_problem_add_observer(coco_suite_get_problem(suite, 0), observer);
+  problem2 = coco_problem_add_observer(coco_suite_get_problem(suite, 1), observer);
+  coco_evaluate_function(problem1, x, y);
+  coco_evaluate_function(problem2, x, y);
+
+  /* The entry of the first run is started, the second one is not */
+  contents = test_coco_observer_read_file(index_file);
+  assert_true(strstr(contents, "funcId = 1, DIM = 2, Precision = 1.000e-08, algId = 'ALG'\n%\n") == contents);
+  assert_true(strstr(contents, "bbobexp_f1_DIM2_i1.dat, 1") != NULL);
+  assert_true(strstr(contents, "bbobexp_f1_DIM2_i1-2.dat") == NULL);
+  coco_free_memory(contents);
+
+  coco_problem_free(problem2);
+  contents = test_coco_observer_read_file(index_file);
+  assert_true(strstr(contents, "bbobexp_f1_DIM2_i1-2.dat") == NULL);
+  coco_free_memory(contents);
+
+  coco_problem_free(problem1);
+  contents = test_coco_observer_read_file(index_file);
+  assert_true(strstr(contents, "bbobexp_f1_DIM2_i1.dat, 1:1|") != NULL);
+  assert_true(strstr(contents, "\nfuncId = 1, DIM = 2") != NULL);
+  assert_true(strstr(contents, "bbobexp_f1_DIM2_i1-2.dat, 2:1|") != NULL);
+  assert_true(strstr(contents, "bbobexp_f1_DIM2_i1.dat, 1:1|") < strstr(contents, "bbobexp_f1_DIM2_i1-2.dat"));
+  coco_free_memory(contents);
+
+  coco_remove_directory(observer->output_folder);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  (void)state; /* unused */
+}
+
 static int test_all_coco_observer(void) {
 
   const struct CMUnitTest tests[] = {
-      cmocka_unit_test(test_coco_observer_evaluation_to_log)
+      cmocka_unit_test(test_coco_observer_next_evaluation_to_log),
+      cmocka_unit_test(test_coco_observer_bbob_index)
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
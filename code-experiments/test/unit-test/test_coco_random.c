@@ -0,0 +1,104 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include "coco.h"
+
+/**
+ * Tests that coco_random_uniform_fill gives the values of the same number of calls to coco_random_uniform,
+ * also when the fills and the calls are interleaved.
+ */
+static void test_coco_random_uniform_fill(void **state) {
+
+  coco_random_state_t *random_generator = coco_random_new(0xC0C0);
+  coco_random_state_t *fill_generator = coco_random_new(0xC0C0);
+  static double values[5000];
+  size_t number_of_values, i, k;
+
+  for (k = 0; k < 20; k++) {
+    number_of_values = (k * k * 37) % 1500;
+    coco_random_uniform_fill(fill_generator, values, number_of_values);
+    for (i = 0; i < number_of_values; i++) {
+      assert_true(values[i] == coco_random_uniform(random_generator));
+    }
+    assert_true(coco_random_uniform(fill_generator) == coco_random_uniform(random_generator));
+  }
+
+  coco_random_free(random_generator);
+  coco_random_free(fill_generator);
+  (void)state; /* unused */
+}
+
+/**
+ * Tests the mean and the variance of the values of coco_random_normal_fill.
+ */
+static void test_coco_random_normal_fill(void **state) {
+
+  coco_random_state_t *random_generator = coco_random_new(0xC0C0);
+  static double values[100001];
+  double mean = 0, variance = 0;
+  size_t i;
+
+  coco_random_normal_fill(random_generator, values, 100001);
+  for (i = 0; i < 100001; i++) {
+    mean += values[i] / 100001.0;
+    variance += values[i] * values[i] / 100001.0;
+  }
+  variance -= mean * mean;
+  assert_true(fabs(mean) < 0.02);
+  assert_true(fabs(variance - 1) < 0.02);
+
+  coco_random_free(random_generator);
+  (void)state; /* unused */
+}
+
+/**
+ * Tests that the substreams of a seed are deterministic, uniform in [0, 1) and uncorrelated.
+ */
+static void test_coco_random_new_substream(void **state) {
+
+  coco_random_state_t *random_generator1, *random_generator2;
+  double value1, value2, sum1 = 0, sum2 = 0, sum12 = 0;
+  uint32_t substream;
+  size_t i;
+
+  for (substream = 0; substream < 10; substream++) {
+    random_generator1 = coco_random_new_substream(1, substream);
+    random_generator2 = coco_random_new_substream(substream == 0 ? 2 : 1, substream == 0 ? 0 : substream + 1);
+    for (i = 0; i < 10000; i++) {
+      value1 = coco_random_uniform(random_generator1);
+      value2 = coco_random_uniform(random_generator2);
+      assert_true((value1 >= 0) && (value1 < 1));
+      sum1 += value1;
+      sum2 += value2;
+      sum12 += (value1 - 0.5) * (value2 - 0.5);
+    }
+    coco_random_free(random_generator1);
+    coco_random_free(random_generator2);
+  }
+  /* The mean is 1/2 and the covariance 0 (with a standard deviation of 1/12 / sqrt(100000)) */
+  assert_true(fabs(sum1 / 100000 - 0.5) < 0.01);
+  assert_true(fabs(sum2 / 100000 - 0.5) < 0.01);
+  assert_true(fabs(sum12 / 100000) < 0.002);
+
+  random_generator1 = coco_random_new_substream(7, 3);
+  random_generator2 = coco_random_new_substream(7, 3);
+  for (i = 0; i < 1000; i++) {
+    assert_true(coco_random_uniform(random_generator1) == coco_random_uniform(random_generator2));
+  }
+  coco_random_free(random_generator1);
+  coco_random_free(random_generator2);
+
+  (void)state; /* unused */
+}
+
+static int test_all_coco_random(void) {
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_coco_random_uniform_fill),
+      cmocka_unit_test(test_coco_random_normal_fill),
+      cmocka_unit_test(test_coco_random_new_substream)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
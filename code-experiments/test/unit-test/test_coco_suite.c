@@ -66,10 +66,508 @@ static void test_coco_suite_encode_problem_index(void **state) {
   (void)state; /* unused */
 }
 
+/**
+ * Checks that coco_suite_get_problem_metadata() agrees with the problems returned when iterating through
+ * the suite and that it rejects all other problem indices.
+ */
+static void test_coco_suite_get_problem_metadata_of_suite(const char *suite_name,
+                                                          const char *suite_instance,
+                                                          const char *suite_options) {
+
+  coco_suite_t *suite, *metadata_suite;
+  coco_problem_t *problem;
+  char *problem_id, *problem_name;
+  size_t index, next_index = 0, dimension, number_of_objectives;
+
+  suite = coco_suite(suite_name, suite_instance, suite_options);
+  metadata_suite = coco_suite(suite_name, suite_instance, suite_options);
+
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    for (index = next_index; index < coco_problem_get_suite_dep_index(problem); index++) {
+      assert_int_equal(coco_suite_get_problem_metadata(metadata_suite, index, &problem_id, &problem_name,
+          &dimension, &number_of_objectives), 0);
+    }
+    index = coco_problem_get_suite_dep_index(problem);
+    assert_int_equal(coco_suite_get_problem_metadata(metadata_suite, index, &problem_id, &problem_name,
+        &dimension, &number_of_objectives), 1);
+    assert_string_equal(problem_id, coco_problem_get_id(problem));
+    assert_string_equal(problem_name, coco_problem_get_name(problem));
+    assert_int_equal(dimension, coco_problem_get_dimension(problem));
+    assert_int_equal(number_of_objectives, coco_problem_get_number_of_objectives(problem));
+    coco_free_memory(problem_id);
+    coco_free_memory(problem_name);
+    next_index = index + 1;
+  }
+  for (index = next_index; index <= coco_suite_get_number_of_problems(metadata_suite); index++) {
+    assert_int_equal(coco_suite_get_problem_metadata(metadata_suite, index, &problem_id, &problem_name,
+        &dimension, &number_of_objectives), 0);
+  }
+
+  coco_suite_free(suite);
+  coco_suite_free(metadata_suite);
+}
+
+/**
+ * Tests the function coco_suite_get_problem_metadata.
+ */
+static void test_coco_suite_get_problem_metadata(void **state) {
+
+  test_coco_suite_get_problem_metadata_of_suite("bbob", "instances: 1-2", "dimensions: 2,10,40");
+  test_coco_suite_get_problem_metadata_of_suite("bbob", "", "function_idx: 3,7 instance_idx: 2-3 dimension_idx: 2");
+  test_coco_suite_get_problem_metadata_of_suite("bbob-biobj", "instances: 1,6", "dimensions: 2,5 function_idx: 1-20");
+  test_coco_suite_get_problem_metadata_of_suite("toy", "", "");
+
+  (void)state; /* unused */
+}
+
+/**
+ * Tests that problems retrieved through the problem cache behave exactly like freshly constructed ones,
+ * also when they are evicted from the cache or outlive the suite.
+ */
+static void test_coco_suite_problem_cache(void **state) {
+
+  coco_suite_t *suite, *cached_suite;
+  coco_problem_t *problem, *cached_problem, *kept_problem[3];
+  coco_random_state_t *random_generator;
+  double x[2], y[2], y_cached[2];
+  size_t index, i, k;
+
+  random_generator = coco_random_new(0xC0C0);
+
+  /* The first 110 problems are the 2-D ones */
+  suite = coco_suite("bbob-biobj", "instances: 1-2", "");
+  cached_suite = coco_suite("bbob-biobj", "instances: 1-2", "problem_cache: 4");
+  assert_true(suite->problem_cache == NULL);
+  assert_true(cached_suite->problem_cache != NULL);
+
+  for (index = 0; index < 110; index += 7) {
+    problem = coco_suite_get_problem(suite, index);
+    cached_problem = coco_suite_get_problem(cached_suite, index);
+    assert_string_equal(coco_problem_get_id(problem), coco_problem_get_id(cached_problem));
+    assert_string_equal(coco_problem_get_name(problem), coco_problem_get_name(cached_problem));
+    assert_int_equal(coco_problem_get_suite_dep_index(problem), coco_problem_get_suite_dep_index(cached_problem));
+    for (k = 0; k < 3; k++) {
+      for (i = 0; i < 2; i++)
+        x[i] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+      coco_evaluate_function(problem, x, y);
+      coco_evaluate_function(cached_problem, x, y_cached);
+      assert_true(y[0] == y_cached[0] && y[1] == y_cached[1]);
+    }
+    assert_int_equal(coco_problem_get_evaluations(cached_problem), 3);
+    coco_problem_free(problem);
+    coco_problem_free(cached_problem);
+  }
+  assert_true(cached_suite->problem_cache->number_of_entries <= 4);
+  assert_true(cached_suite->problem_cache->number_of_hits > 0);
+
+  /* Handles stay valid after their entry is evicted and after the suite is freed */
+  for (i = 0; i < 3; i++)
+    kept_problem[i] = coco_suite_get_problem(cached_suite, i * 20);
+  coco_suite_free(cached_suite);
+  for (i = 0; i < 3; i++) {
+    problem = coco_suite_get_problem(suite, i * 20);
+    coco_evaluate_function(problem, x, y);
+    coco_evaluate_function(kept_problem[i], x, y_cached);
+    assert_true(y[0] == y_cached[0] && y[1] == y_cached[1]);
+    coco_problem_free(problem);
+    coco_problem_free(kept_problem[i]);
+  }
+
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+  (void)state; /* unused */
+}
+
+#if defined(HAVE_THREADS)
+/**
+ * The work of a thread of test_coco_suite_problem_cache_threads: it gets handles from the shared suite,
+ * evaluates them and counts the values that differ from the reference ones.
+ */
+typedef struct {
+  coco_suite_t *suite;
+  const double *x, *y_reference;
+  size_t number_of_problems, number_of_points, number_of_differences;
+} test_coco_suite_cache_work_t;
+
+static void test_coco_suite_cache_work(void *argument) {
+  test_coco_suite_cache_work_t *work = (test_coco_suite_cache_work_t *) argument;
+  coco_problem_t *problem;
+  double y[2];
+  size_t repetition, index, k;
+
+  for (repetition = 0; repetition < 10; repetition++) {
+    for (index = 0; index < work->number_of_problems; index++) {
+      problem = coco_suite_get_problem(work->suite, index);
+      for (k = 0; k < work->number_of_points; k++) {
+        coco_evaluate_function(problem, work->x + 2 * k, y);
+        if ((y[0] != work->y_reference[2 * (index * work->number_of_points + k)])
+            || (y[1] != work->y_reference[2 * (index * work->number_of_points + k) + 1]))
+          work->number_of_differences++;
+      }
+      coco_problem_free(problem);
+    }
+  }
+}
+#endif
+
+/**
+ * Tests that several threads can get, evaluate and free handles of the same cached problems of a suite
+ * (while the problems are evicted from the cache) and get the values of freshly constructed problems.
+ */
+static void test_coco_suite_problem_cache_threads(void **state) {
+#if defined(HAVE_THREADS)
+  const size_t number_of_problems = 6, number_of_points = 5, number_of_threads = 4;
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  coco_thread_t threads[4];
+  test_coco_suite_cache_work_t work[4];
+  double x[2 * 5], y_reference[2 * 6 * 5];
+  size_t index, i, k;
+
+  random_generator = coco_random_new(0xC0C0);
+  for (i = 0; i < 2 * number_of_points; i++)
+    x[i] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+
+  suite = coco_suite("bbob-biobj", "instances: 1-2", "");
+  for (index = 0; index < number_of_problems; index++) {
+    problem = coco_suite_get_problem(suite, index);
+    for (k = 0; k < number_of_points; k++)
+      coco_evaluate_function(problem, x + 2 * k, y_reference + 2 * (index * number_of_points + k));
+    coco_problem_free(problem);
+  }
+  coco_suite_free(suite);
+
+  suite = coco_suite("bbob-biobj", "instances: 1-2", "problem_cache: 3");
+  for (i = 0; i < number_of_threads; i++) {
+    work[i].suite = suite;
+    work[i].x = x;
+    work[i].y_reference = y_reference;
+    work[i].number_of_problems = number_of_problems;
+    work[i].number_of_points = number_of_points;
+    work[i].number_of_differences = 0;
+    coco_thread_start(&threads[i], test_coco_suite_cache_work, &work[i]);
+  }
+  for (i = 0; i < number_of_threads; i++) {
+    coco_thread_join(threads[i]);
+    assert_int_equal(work[i].number_of_differences, 0);
+  }
+  assert_true(suite->problem_cache->number_of_entries <= 3);
+
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+#endif
+  (void)state; /* unused */
+}
+
+/**
+ * Checks that clones of some problems of the suite evaluate like the problems themselves (also when the
+ * evaluations are interleaved) and that merging their evaluations updates the counters of the problems.
+ */
+static void test_coco_suite_problem_clone_of_suite(const char *suite_name,
+                                                   const char *suite_instance,
+                                                   const char *suite_options) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem, *clone;
+  coco_random_state_t *random_generator;
+  double x[10 * 5], y[10 * 2], y_clone[10 * 2], best_value;
+  size_t number_of_variables, number_of_objectives, i, k;
+
+  random_generator = coco_random_new(0xC0C0);
+  suite = coco_suite(suite_name, suite_instance, suite_options);
+
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    clone = coco_problem_clone_for_thread(problem);
+    number_of_variables = coco_problem_get_dimension(problem);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    assert_true(number_of_variables <= 5);
+    assert_string_equal(coco_problem_get_id(problem), coco_problem_get_id(clone));
+    assert_string_equal(coco_problem_get_name(problem), coco_problem_get_name(clone));
+    assert_int_equal(coco_problem_get_suite_dep_index(problem), coco_problem_get_suite_dep_index(clone));
+    assert_int_equal(coco_problem_get_evaluations(clone), 0);
+
+    best_value = DBL_MAX;
+    for (k = 0; k < 10; k++) {
+      for (i = 0; i < number_of_variables; i++)
+        x[k * number_of_variables + i] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+      coco_evaluate_function(clone, &x[k * number_of_variables], &y_clone[k * number_of_objectives]);
+      coco_evaluate_function(problem, &x[k * number_of_variables], &y[k * number_of_objectives]);
+      for (i = 0; i < number_of_objectives; i++)
+        assert_true(y[k * number_of_objectives + i] == y_clone[k * number_of_objectives + i]);
+      if (y[k * number_of_objectives] < best_value)
+        best_value = y[k * number_of_objectives];
+    }
+
+    coco_problem_merge_evaluations(problem, x, 10, y_clone);
+    assert_int_equal(coco_problem_get_evaluations(problem), 20);
+    assert_int_equal(coco_problem_get_evaluations(clone), 10);
+    assert_true(coco_problem_get_best_observed_fvalue1(problem) == best_value);
+
+    coco_problem_free(clone);
+    coco_evaluate_function(problem, x, y);
+    assert_true(y[0] == y_clone[0]);
+  }
+
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests the functions coco_problem_clone_for_thread and coco_problem_merge_evaluations.
+ */
+static void test_coco_suite_problem_clone(void **state) {
+
+  test_coco_suite_problem_clone_of_suite("bbob", "instances: 1-2", "dimensions: 2,5 problem_cache: 10");
+  test_coco_suite_problem_clone_of_suite("bbob-biobj", "instances: 3", "dimensions: 2,5");
+  test_coco_suite_problem_clone_of_suite("toy", "", "dimensions: 2,3,5");
+
+  (void)state; /* unused */
+}
+
+/**
+ * Tests that batches evaluated by several threads (see the suite option evaluation_threads and
+ * coco_problem_set_evaluation_threads) give the same values, counters and best observed values as batches
+ * evaluated in the calling thread, also when the threads of a problem evaluate several batches.
+ */
+static void test_coco_suite_evaluation_threads(void **state) {
+
+  coco_suite_t *suite, *threads_suite;
+  coco_problem_t *problem, *threads_problem;
+  coco_random_state_t *random_generator;
+  static double x[2000 * 40], y[2000], threads_y[2000];
+  size_t number_of_variables, batch, i;
+
+  random_generator = coco_random_new(0xC0C0);
+  suite = coco_suite("bbob", "instances: 1", "dimensions: 5,40 function_idx: 1,10,16,21");
+  threads_suite = coco_suite("bbob", "instances: 1", "dimensions: 5,40 function_idx: 1,10,16,21 "
+      "evaluation_threads: 4");
+
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    threads_problem = coco_suite_get_next_problem(threads_suite, NULL);
+    number_of_variables = coco_problem_get_dimension(problem);
+    for (batch = 1; batch <= 3; batch++) {
+      for (i = 0; i < 2000 * number_of_variables; i++)
+        x[i] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+
+      /* The last batch is evaluated by a different number of threads */
+      if (batch == 3)
+        coco_problem_set_evaluation_threads(threads_problem, 3);
+      coco_evaluate_function_batch(problem, x, 2000, y);
+      coco_evaluate_function_batch(threads_problem, x, 2000, threads_y);
+      for (i = 0; i < 2000; i++)
+        assert_true(y[i] == threads_y[i]);
+      assert_int_equal(coco_problem_get_evaluations(threads_problem), (long) (2000 * batch));
+      assert_true(coco_problem_get_best_observed_fvalue1(problem)
+          == coco_problem_get_best_observed_fvalue1(threads_problem));
+    }
+  }
+
+  coco_suite_free(threads_suite);
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+  (void)state; /* unused */
+}
+
+/**
+ * A random search that is seeded with the index of the problem, so that it evaluates the same points on a
+ * problem regardless of the thread that runs it. Its budget covers several chunks of recorded evaluations
+ * in coco_run_benchmark_parallel().
+ */
+static void test_coco_suite_random_search(coco_problem_t *problem) {
+
+  coco_random_state_t *random_generator;
+  const double *lower_bounds = coco_problem_get_smallest_values_of_interest(problem);
+  const double *upper_bounds = coco_problem_get_largest_values_of_interest(problem);
+  size_t number_of_variables = coco_problem_get_dimension(problem);
+  double *x, *y;
+  size_t evaluation, i;
+
+  random_generator = coco_random_new((uint32_t) coco_problem_get_suite_dep_index(problem) + 1);
+  x = coco_allocate_vector(number_of_variables);
+  y = coco_allocate_vector(coco_problem_get_number_of_objectives(problem));
+  for (evaluation = 0; evaluation < 800 * number_of_variables; evaluation++) {
+    for (i = 0; i < number_of_variables; i++)
+      x[i] = lower_bounds[i] + (upper_bounds[i] - lower_bounds[i]) * coco_random_uniform(random_generator);
+    coco_evaluate_function(problem, x, y);
+  }
+  coco_free_memory(x);
+  coco_free_memory(y);
+  coco_random_free(random_generator);
+}
+
+#if !_MSC_VER
+/**
+ * Asserts that the two files have the same contents.
+ */
+static void test_coco_suite_assert_equal_files(const char *path1, const char *path2) {
+
+  FILE *file1, *file2;
+  int c1, c2;
+
+  file1 = fopen(path1, "rb");
+  file2 = fopen(path2, "rb");
+  assert_true((file1 != NULL) && (file2 != NULL));
+  do {
+    c1 = fgetc(file1);
+    c2 = fgetc(file2);
+    assert_int_equal(c1, c2);
+  } while (c1 != EOF);
+  fclose(file1);
+  fclose(file2);
+}
+
+/**
+ * Asserts that the two folders contain the same files and folders with the same contents.
+ */
+static void test_coco_suite_assert_equal_folders(const char *path1, const char *path2) {
+
+  DIR *folder;
+  struct dirent *entry;
+  char *entry_path1, *entry_path2;
+  size_t number_of_entries1 = 0, number_of_entries2 = 0;
+
+  folder = opendir(path1);
+  assert_true(folder != NULL);
+  while ((entry = readdir(folder)) != NULL) {
+    if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+      continue;
+    number_of_entries1++;
+    entry_path1 = coco_strdupf("%s/%s", path1, entry->d_name);
+    entry_path2 = coco_strdupf("%s/%s", path2, entry->d_name);
+    if (coco_path_exists(entry_path1)) {
+      assert_true(coco_path_exists(entry_path2));
+      test_coco_suite_assert_equal_folders(entry_path1, entry_path2);
+    } else {
+      test_coco_suite_assert_equal_files(entry_path1, entry_path2);
+    }
+    coco_free_memory(entry_path1);
+    coco_free_memory(entry_path2);
+  }
+  closedir(folder);
+
+  folder = opendir(path2);
+  assert_true(folder != NULL);
+  while ((entry = readdir(folder)) != NULL) {
+    if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, ".."))
+      number_of_entries2++;
+  }
+  closedir(folder);
+  assert_int_equal(number_of_entries1, number_of_entries2);
+}
+#endif
+
+/**
+ * Checks that coco_run_benchmark_parallel() produces the same output as coco_run_benchmark() when at most
+ * ${max_recorded_bytes} bytes of the evaluations are recorded at a time.
+ */
+static void test_coco_suite_run_benchmark_parallel_of_suite(const char *suite_name,
+                                                            const char *suite_instance,
+                                                            const char *suite_options,
+                                                            const size_t max_recorded_bytes) {
+#if !_MSC_VER
+  const char *sequential_folder = "test_run_benchmark_sequential";
+  const char *parallel_folder = "test_run_benchmark_parallel";
+  char observer_options[200];
+
+  coco_remove_directory(sequential_folder);
+  coco_remove_directory(parallel_folder);
+
+  sprintf(observer_options, "result_folder: %s algorithm_name: RS log_level: warning", sequential_folder);
+  coco_run_benchmark(suite_name, suite_instance, suite_options, suite_name, observer_options,
+      test_coco_suite_random_search);
+  sprintf(observer_options, "result_folder: %s algorithm_name: RS log_level: warning", parallel_folder);
+  coco_run_benchmark_parallel(suite_name, suite_instance, suite_options, suite_name, observer_options,
+      test_coco_suite_random_search, 3, max_recorded_bytes);
+
+  test_coco_suite_assert_equal_folders(sequential_folder, parallel_folder);
+
+  coco_remove_directory(sequential_folder);
+  coco_remove_directory(parallel_folder);
+#else
+  (void) suite_name; /* unused */
+  (void) suite_instance; /* unused */
+  (void) suite_options; /* unused */
+  (void) max_recorded_bytes; /* unused */
+#endif
+}
+
+static void test_coco_suite_run_benchmark_parallel(void **state) {
+
+  test_coco_suite_run_benchmark_parallel_of_suite("bbob", "instances: 1-3", "dimensions: 2,5 function_idx: 1,8,20", 0);
+  test_coco_suite_run_benchmark_parallel_of_suite("bbob-biobj", "instances: 1-3",
+      "dimensions: 2,5 function_idx: 1,10,55", 0);
+  /* A limit below the size of a chunk, so that the workers wait for each other */
+  test_coco_suite_run_benchmark_parallel_of_suite("bbob", "instances: 1-3", "dimensions: 2,5 function_idx: 1,8,20",
+      10000);
+  test_coco_suite_run_benchmark_parallel_of_suite("bbob-biobj", "instances: 1-3",
+      "dimensions: 2,5 function_idx: 1,10,55", 100000);
+
+  (void)state; /* unused */
+}
+
+/**
+ * Tests that the batches of a suite (see the suite option batch) are disjoint, cover the suite, keep the
+ * instances of a function in a dimension together and have similar costs.
+ */
+static void test_coco_suite_batch(void **state) {
+
+  coco_suite_t *suite, *batch_suite;
+  coco_problem_t *problem;
+  char batch_options[100];
+  size_t batch_costs[3], dimension, index, batch, min_cost = 0, max_cost = 0;
+  static int batch_of_problem[2000], batch_of_group[41][25];
+
+  suite = coco_suite("bbob", "instances: 1-5", "dimensions: 2,5,20,40 function_idx: 1-20");
+  for (index = 0; index < coco_suite_get_number_of_problems(suite); index++)
+    batch_of_problem[index] = -1;
+  for (dimension = 0; dimension <= 40; dimension++) {
+    for (index = 0; index <= 24; index++)
+      batch_of_group[dimension][index] = -1;
+  }
+
+  for (batch = 1; batch <= 3; batch++) {
+    sprintf(batch_options, "dimensions: 2,5,20,40 function_idx: 1-20 batch: %lu/3", (unsigned long) batch);
+    batch_suite = coco_suite("bbob", "instances: 1-5", batch_options);
+    batch_costs[batch - 1] = 0;
+    while ((problem = coco_suite_get_next_problem(batch_suite, NULL)) != NULL) {
+      index = coco_problem_get_suite_dep_index(problem);
+      assert_true(batch_of_problem[index] == -1);
+      batch_of_problem[index] = (int) batch;
+      dimension = coco_problem_get_dimension(problem);
+      batch_costs[batch - 1] += dimension * dimension;
+      /* The instances of a function in a dimension are in the same batch */
+      index = problem->suite_dep_function;
+      assert_true((batch_of_group[dimension][index] == -1) || (batch_of_group[dimension][index] == (int) batch));
+      batch_of_group[dimension][index] = (int) batch;
+    }
+    coco_suite_free(batch_suite);
+    if ((batch == 1) || (batch_costs[batch - 1] < min_cost))
+      min_cost = batch_costs[batch - 1];
+    if ((batch == 1) || (batch_costs[batch - 1] > max_cost))
+      max_cost = batch_costs[batch - 1];
+  }
+  assert_true(max_cost - min_cost <= 5 * 40 * 40);
+
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    assert_true(batch_of_problem[coco_problem_get_suite_dep_index(problem)] != -1);
+  }
+  coco_suite_free(suite);
+
+  (void)state; /* unused */
+}
+
 static int test_all_coco_suite(void) {
 
   const struct CMUnitTest tests[] = {
-      cmocka_unit_test(test_coco_suite_encode_problem_index)
+      cmocka_unit_test(test_coco_suite_encode_problem_index),
+      cmocka_unit_test(test_coco_suite_get_problem_metadata),
+      cmocka_unit_test(test_coco_suite_problem_cache),
+      cmocka_unit_test(test_coco_suite_problem_cache_threads),
+      cmocka_unit_test(test_coco_suite_problem_clone),
+      cmocka_unit_test(test_coco_suite_evaluation_threads),
+      cmocka_unit_test(test_coco_suite_run_benchmark_parallel),
+      cmocka_unit_test(test_coco_suite_batch)
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
@@ -330,6 +330,76 @@ static void test_coco_string_split(void **state) {
   (void)state; /* unused */
 }
 
+/**
+ * Compares the kernels of coco_simd.c with plain loops. The results are identical, unless COCO_SIMD is
+ * defined, in which case every kernel supported by the CPU is also checked on its own.
+ */
+static void test_coco_vector_kernels(void **state) {
+
+  const size_t number_of_values = 37;
+  coco_random_state_t *random_generator = coco_random_new(12);
+  double *x = coco_allocate_vector(number_of_values);
+  double *weights = coco_allocate_vector(number_of_values);
+  double squares = 0.0, weighted_squares = 0.0, cosines = 0.0;
+  size_t i;
+#if defined(HAVE_SIMD_X86)
+  const double tolerance = 1e-13;
+  size_t number_done;
+#else
+  const double tolerance = 0.0;
+#endif
+
+  for (i = 0; i < number_of_values; ++i) {
+    x[i] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+    weights[i] = pow(1.0e6, (double) (long) i / (double) (long) number_of_values);
+    squares += 3.0 * x[i] * x[i];
+    weighted_squares += weights[i] * x[i] * x[i];
+    cosines += cos(coco_two_pi * x[i]);
+  }
+  assert_true(fabs(coco_vector_add_squares(0.0, x, 3.0, number_of_values) - squares) <= tolerance * squares);
+  assert_true(fabs(coco_vector_add_weighted_squares(0.0, x, weights, number_of_values) - weighted_squares)
+      <= tolerance * weighted_squares);
+  assert_true(fabs(coco_vector_sum_of_cosines(x, number_of_values) - cosines) <= tolerance * (double) (long) number_of_values);
+
+#if defined(HAVE_SIMD_X86)
+  /* The part that is not done by a kernel is left to the scalar loop */
+  assert_true(fabs(coco_simd_add_squares_sse2(x, NULL, 3.0, number_of_values, &number_done)
+      + coco_vector_add_squares(0.0, x + number_done, 3.0, number_of_values - number_done) - squares)
+      <= tolerance * squares);
+  assert_true(fabs(coco_simd_sum_of_cosines_sse2(x, number_of_values, &number_done)
+      + coco_vector_sum_of_cosines(x + number_done, number_of_values - number_done) - cosines)
+      <= tolerance * (double) (long) number_of_values);
+  if (__builtin_cpu_supports("avx2")) {
+    assert_true(fabs(coco_simd_add_squares_avx2(x, weights, 0.0, number_of_values, &number_done)
+        + coco_vector_add_weighted_squares(0.0, x + number_done, weights + number_done,
+            number_of_values - number_done) - weighted_squares) <= tolerance * weighted_squares);
+    assert_true(fabs(coco_simd_sum_of_cosines_avx2(x, number_of_values, &number_done)
+        + coco_vector_sum_of_cosines(x + number_done, number_of_values - number_done) - cosines)
+        <= tolerance * (double) (long) number_of_values);
+  }
+  if (__builtin_cpu_supports("avx512f")) {
+    assert_true(fabs(coco_simd_add_squares_avx512(x, weights, 0.0, number_of_values, &number_done)
+        + coco_vector_add_weighted_squares(0.0, x + number_done, weights + number_done,
+            number_of_values - number_done) - weighted_squares) <= tolerance * weighted_squares);
+    assert_true(fabs(coco_simd_sum_of_cosines_avx512(x, number_of_values, &number_done)
+        + coco_vector_sum_of_cosines(x + number_done, number_of_values - number_done) - cosines)
+        <= tolerance * (double) (long) number_of_values);
+  }
+#endif
+
+  /* Values too large for the reduction of the cosine kernels */
+  x[number_of_values / 2] = 1.0e17 + 0.5;
+  cosines = 0.0;
+  for (i = 0; i < number_of_values; ++i) {
+    cosines += cos(coco_two_pi * x[i]);
+  }
+  assert_true(fabs(coco_vector_sum_of_cosines(x, number_of_values) - cosines) <= tolerance * (double) (long) number_of_values);
+
+  coco_random_free(random_generator);
+  coco_free_memory(x);
+  coco_free_memory(weights);
+  (void)state; /* unused */
+}
 
 static int test_all_coco_utilities(void) {
 
@@ -339,6 +409,7 @@ static int test_all_coco_utilities(void) {
       cmocka_unit_test(test_coco_round_double),
       cmocka_unit_test(test_coco_string_split),
       cmocka_unit_test(test_coco_string_get_numbers_from_ranges),
+      cmocka_unit_test(test_coco_vector_kernels),
       cmocka_unit_test_setup_teardown(
           test_coco_create_remove_directory,
           setup_coco_create_remove_directory,
@@ -0,0 +1,267 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include "coco.h"
+
+/**
+ * Returns the minimal distance from the archive of the ${logger} to the ROI, recomputed from scratch (the
+ * distance of solutions strictly within the ROI is 0).
+ */
+static double test_logger_biobj_ROI_distance_from_scratch(logger_biobj_t *logger, coco_problem_t *problem) {
+
+  logger_biobj_item_t *item;
+  double distance = DBL_MAX;
+  size_t i;
+
+  for (i = 0; i < logger_biobj_archive_size(logger->archive); i++) {
+    item = (logger_biobj_item_t *) logger_biobj_archive_get(logger->archive, i)->item;
+    distance = coco_min_double(distance, logger_biobj_get_distance_to_ROI(problem, item->y));
+  }
+  return distance;
+}
+
+/**
+ * Updates the archive of the biobjective logger with random points y = ideal + u * (nadir - ideal), where
+ * u[0] is uniform in [u_min, u_max] and u[1] is close to u_min + u_max - u[0] (so that the archive grows
+ * large), and checks after each update that the incrementally maintained distance to the ROI equals the one
+ * recomputed from scratch. The updates remove dominated solutions and, if the archive of the observer with
+ * the given options is bounded, solutions that do not fit into the archive.
+ */
+static void test_logger_biobj_ROI_distance_with(const char *observer_options,
+                                                const double u_min,
+                                                const double u_max) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem, *inner_problem;
+  logger_biobj_t *logger;
+  coco_random_state_t *random_generator = coco_random_new(18);
+  double x[2] = { 0, 0 }, y[2], u[2];
+  size_t i, j;
+
+  suite = coco_suite("bbob-biobj", NULL, "dimensions: 2 function_idx: 1 instance_idx: 1");
+  observer = coco_observer("bbob-biobj", observer_options);
+  problem = coco_suite_get_next_problem(suite, observer);
+  inner_problem = coco_transformed_get_inner_problem(problem);
+  logger = (logger_biobj_t *) coco_transformed_get_data(problem);
+
+  for (i = 0; i < 2000; i++) {
+    u[0] = u_min + (u_max - u_min) * coco_random_uniform(random_generator);
+    u[1] = u_min + u_max - u[0] + 0.01 * coco_random_uniform(random_generator);
+    for (j = 0; j < 2; j++)
+      y[j] = inner_problem->best_value[j] + u[j] * (inner_problem->nadir_value[j] - inner_problem->best_value[j]);
+    logger->number_of_evaluations++;
+    if (logger_biobj_update_archive(logger, inner_problem, x, y) == NULL)
+      continue;
+    if (logger->archive_max_size > 0)
+      logger_biobj_prune_archive(logger, inner_problem);
+    assert_true(logger_biobj_get_ROI_distance(logger, inner_problem)
+        == test_logger_biobj_ROI_distance_from_scratch(logger, inner_problem));
+  }
+  assert_true(logger_biobj_archive_size(logger->archive) > 1);
+
+  coco_remove_directory(observer->output_folder);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests the incremental distance to the ROI of the biobjective logger with points outside of the ROI (where
+ * the distance stays positive) and with points within and outside of the ROI in a bounded archive (where
+ * removing solutions within the ROI requires recomputing the distance).
+ */
+static void test_logger_biobj_ROI_distance(void **state) {
+
+  test_logger_biobj_ROI_distance_with("result_folder: test_logger_biobj log_nondominated: none log_level: warning",
+      1.1, 3);
+  test_logger_biobj_ROI_distance_with("result_folder: test_logger_biobj log_nondominated: none log_level: warning "
+      "archive_max_size: 10", 1.1, 3);
+  test_logger_biobj_ROI_distance_with("result_folder: test_logger_biobj log_nondominated: none log_level: warning "
+      "archive_max_size: 10", 0.3, 1.2);
+
+  (void)state; /* unused */
+}
+
+/**
+ * Returns the indicator of the ${logger} with the given ${name}.
+ */
+static logger_biobj_indicator_t *test_logger_biobj_indicator(logger_biobj_t *logger, const char *name) {
+
+  size_t i;
+
+  for (i = 0; i < logger->number_of_indicators; i++) {
+    if (strcmp(logger->indicators[i]->type->name, name) == 0)
+      return logger->indicators[i];
+  }
+  fail();
+  return NULL;
+}
+
+/**
+ * Tests the values of the IGD+ and additive epsilon indicators against hand-computed ones. The reference set
+ * (read from a file) and the solutions are given in normalized objective space, where the ideal point is
+ * (0, 0) and the nadir point is (1, 1).
+ */
+static void test_logger_biobj_igdp_eps(void **state) {
+
+  /* The reference points (0, 1), (0.5, 0.5) and (1, 0) */
+  const double reference[3][2] = { { 0, 1 }, { 0.5, 0.5 }, { 1, 0 } };
+  /* The solutions in the order of insertion, the last one dominates all others */
+  const double solutions[4][2] = { { 0.25, 0.75 }, { 0.75, 0.25 }, { 0.5, 0.5 }, { 0, 0 } };
+  /* For each reference point, the distances to the solutions are
+   *   IGD+ (norm of max(a - r, 0))  (0, 1)  (0.5, 0.5)  (1, 0)   eps (max(a - r))  (0, 1)  (0.5, 0.5)  (1, 0)
+   *   (0.25, 0.75)                  0.25    0.25        0.75                       0.25    0.25        0.75
+   *   (0.75, 0.25)                  0.75    0.25        0.25                       0.75    0.25        0.25
+   *   (0.5, 0.5)                    0.5     0           0.5                        0.5     0           0.5
+   *   (0, 0)                        0       0           0                          0       -0.5        0
+   * and the indicators are the average (IGD+) and the maximum (eps) of the smallest distances so far. */
+  const double igdp_values[4] = { 1.25 / 3, 0.25, 0.5 / 3, 0 };
+  const double eps_values[4] = { 0.75, 0.25, 0.25, 0 };
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem, *inner_problem;
+  logger_biobj_t *logger;
+  logger_biobj_indicator_t *igdp, *eps;
+  char file_name[COCO_PATH_MAX] = { 0 }, *problem_file_name;
+  double x[2] = { 0, 0 }, y[2];
+  FILE *file;
+  size_t i, j;
+
+  suite = coco_suite("bbob-biobj", NULL, "dimensions: 2 function_idx: 1 instance_idx: 1");
+  problem = coco_suite_get_problem(suite, 0);
+
+  /* Write the reference set in the original objective space */
+  coco_create_path("test_reference_sets");
+  problem_file_name = coco_strdupf("%s.txt", coco_problem_get_id(problem));
+  coco_join_path(file_name, sizeof(file_name), "test_reference_sets", problem_file_name, NULL);
+  coco_free_memory(problem_file_name);
+  file = fopen(file_name, "w");
+  assert_true(file != NULL);
+  fprintf(file, "%% reference set of test_logger_biobj_igdp_eps\n");
+  for (i = 0; i < 3; i++) {
+    for (j = 0; j < 2; j++)
+      fprintf(file, "%.17g ", problem->best_value[j] + reference[i][j] * (problem->nadir_value[j]
+          - problem->best_value[j]));
+    fprintf(file, "\n");
+  }
+  fclose(file);
+
+  observer = coco_observer("bbob-biobj", "result_folder: test_logger_biobj log_nondominated: none "
+      "log_level: warning log_indicators: igdp,eps reference_sets: test_reference_sets");
+  problem = coco_problem_add_observer(problem, observer);
+  inner_problem = coco_transformed_get_inner_problem(problem);
+  logger = (logger_biobj_t *) coco_transformed_get_data(problem);
+  igdp = test_logger_biobj_indicator(logger, "igdp");
+  eps = test_logger_biobj_indicator(logger, "eps");
+
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 2; j++)
+      y[j] = inner_problem->best_value[j] + solutions[i][j] * (inner_problem->nadir_value[j]
+          - inner_problem->best_value[j]);
+    logger->number_of_evaluations++;
+    assert_true(logger_biobj_update_archive(logger, inner_problem, x, y) != NULL);
+    assert_true(fabs(igdp->type->value(igdp, logger, inner_problem) - igdp_values[i]) < 1e-12);
+    assert_true(fabs(eps->type->value(eps, logger, inner_problem) - eps_values[i]) < 1e-12);
+  }
+  assert_int_equal(logger_biobj_archive_size(logger->archive), 1);
+
+  coco_remove_directory(observer->output_folder);
+  coco_remove_directory("test_reference_sets");
+  coco_problem_free(problem);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  (void)state; /* unused */
+}
+
+/**
+ * Overfills an archive bounded to three solutions and checks which solutions survive and the resulting
+ * hypervolume against hand-computed values. The solutions are given in normalized objective space, where the
+ * ideal point is (0, 0) and the nadir point (the reference point of the hypervolume) is (1, 1).
+ *
+ * The hypervolume is the sum of the contributions of the solutions sorted by increasing second objective,
+ * where the contribution of a solution is the box between its first objective and the one of the previous
+ * solution (or 1) times the distance of its second objective to 1. When the archive is full, the solution
+ * with the smallest contribution is removed (solutions outside of the ROI contribute nothing).
+ */
+static void test_logger_biobj_bounded_archive(void **state) {
+
+  /* Each inserted solution followed by the expected survivors (sorted, unused ones at -1) and hypervolume */
+  const double updates[7][9] = {
+      /* (0.8, 0.1) contributes 0.2 * 0.9 = 0.18 */
+      { 0.8, 0.1, /**/ 0.8, 0.1, -1, -1, -1, -1, /**/ 0.18 },
+      /* (0.6, 0.2) contributes 0.2 * 0.8 = 0.16 */
+      { 0.6, 0.2, /**/ 0.8, 0.1, 0.6, 0.2, -1, -1, /**/ 0.34 },
+      /* (0.3, 0.4) contributes 0.3 * 0.6 = 0.18 */
+      { 0.3, 0.4, /**/ 0.8, 0.1, 0.6, 0.2, 0.3, 0.4, /**/ 0.52 },
+      /* (0.1, 0.8) contributes 0.2 * 0.2 = 0.04, the smallest contribution, and is removed again */
+      { 0.1, 0.8, /**/ 0.8, 0.1, 0.6, 0.2, 0.3, 0.4, /**/ 0.52 },
+      /* (0.45, 0.25) contributes 0.15 * 0.75 = 0.1125 and reduces the contribution of (0.3, 0.4) to
+       * 0.15 * 0.6 = 0.09, which is removed */
+      { 0.45, 0.25, /**/ 0.8, 0.1, 0.6, 0.2, 0.45, 0.25, /**/ 0.4525 },
+      /* (0.7, 0.12) contributes 0.1 * 0.88 = 0.088 and reduces the contribution of (0.6, 0.2) to
+       * 0.1 * 0.8 = 0.08, which is removed, so that the contribution of (0.45, 0.25) grows to 0.25 * 0.75 */
+      { 0.7, 0.12, /**/ 0.8, 0.1, 0.7, 0.12, 0.45, 0.25, /**/ 0.4555 },
+      /* (1.2, 0.05) is outside of the ROI and is removed again */
+      { 1.2, 0.05, /**/ 0.8, 0.1, 0.7, 0.12, 0.45, 0.25, /**/ 0.4555 }
+  };
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem, *inner_problem;
+  logger_biobj_t *logger;
+  logger_biobj_indicator_t *hyp;
+  logger_biobj_archive_entry_t *entry;
+  double x[2] = { 0, 0 }, y[2], z;
+  size_t i, j, k, size;
+
+  suite = coco_suite("bbob-biobj", NULL, "dimensions: 2 function_idx: 1 instance_idx: 1");
+  observer = coco_observer("bbob-biobj", "result_folder: test_logger_biobj log_nondominated: none "
+      "log_level: warning archive_max_size: 3");
+  problem = coco_suite_get_next_problem(suite, observer);
+  inner_problem = coco_transformed_get_inner_problem(problem);
+  logger = (logger_biobj_t *) coco_transformed_get_data(problem);
+  hyp = test_logger_biobj_indicator(logger, "hyp");
+
+  for (i = 0; i < 7; i++) {
+    for (j = 0; j < 2; j++)
+      y[j] = inner_problem->best_value[j] + updates[i][j] * (inner_problem->nadir_value[j]
+          - inner_problem->best_value[j]);
+    logger->number_of_evaluations++;
+    assert_true(logger_biobj_update_archive(logger, inner_problem, x, y) != NULL);
+    logger_biobj_prune_archive(logger, inner_problem);
+
+    for (size = 0; (size < 3) && (updates[i][2 + 2 * size] >= 0); size++)
+      ;
+    assert_int_equal(logger_biobj_archive_size(logger->archive), size);
+    assert_int_equal(logger->heap_size, size);
+    for (k = 0; k < size; k++) {
+      entry = logger_biobj_archive_get(logger->archive, k);
+      for (j = 0; j < 2; j++) {
+        z = (entry->y[j] - inner_problem->best_value[j]) / (inner_problem->nadir_value[j]
+            - inner_problem->best_value[j]);
+        assert_true(fabs(z - updates[i][2 + 2 * k + j]) < 1e-12);
+      }
+    }
+    assert_true(fabs(hyp->current_value - updates[i][8]) < 1e-12);
+    assert_true(fabs(hyp->type->value(hyp, logger, inner_problem) - (hyp->best_value - updates[i][8])) < 1e-12);
+  }
+
+  coco_remove_directory(observer->output_folder);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  (void)state; /* unused */
+}
+
+static int test_all_logger_biobj(void) {
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_logger_biobj_ROI_distance),
+      cmocka_unit_test(test_logger_biobj_igdp_eps),
+      cmocka_unit_test(test_logger_biobj_bounded_archive)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
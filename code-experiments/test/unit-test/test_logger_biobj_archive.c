@@ -0,0 +1,70 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include "coco.h"
+
+/**
+ * Tests the chunks of the biobjective archive against a plain sorted array with random updates that keep
+ * the archive nondominated and occasional removals of single entries. The points are close to a line, so
+ * that the archive grows to several chunks.
+ */
+static void test_logger_biobj_archive_update(void **state) {
+
+  logger_biobj_archive_t *archive = logger_biobj_archive();
+  static double reference[5000][2];
+  double y[2];
+  size_t size = 0, position, first, last, i, k;
+  coco_random_state_t *random_generator = coco_random_new(4);
+
+  for (k = 0; k < 4000; k++) {
+    y[0] = coco_random_uniform(random_generator);
+    y[1] = 1 - y[0] + 0.001 * coco_random_uniform(random_generator);
+
+    /* Update the reference */
+    for (position = 0; (position < size) && (reference[position][1] <= y[1]); position++)
+      ;
+    if ((position > 0) && (reference[position - 1][0] <= y[0]))
+      continue;
+    for (last = position; (last < size) && (reference[last][0] >= y[0]); last++)
+      ;
+    memmove(&reference[position + 1], &reference[last], (size - last) * sizeof(reference[0]));
+    reference[position][0] = y[0];
+    reference[position][1] = y[1];
+    size = size + 1 - (last - position);
+    assert_true(size < 5000);
+
+    /* Update the archive */
+    assert_int_equal(logger_biobj_archive_locate(archive, y[1]), position);
+    first = position;
+    logger_biobj_archive_replace(archive, first, last - first, y, NULL);
+
+    /* Remove an entry without replacement now and then */
+    if (k % 5 == 0) {
+      position = (size_t) (coco_random_uniform(random_generator) * (double) size);
+      memmove(&reference[position], &reference[position + 1], (size - position - 1) * sizeof(reference[0]));
+      size--;
+      logger_biobj_archive_replace(archive, position, 1, NULL, NULL);
+    }
+
+    assert_int_equal(logger_biobj_archive_size(archive), size);
+    for (i = 0; i < size; i++) {
+      assert_true(logger_biobj_archive_get(archive, i)->y[0] == reference[i][0]);
+      assert_true(logger_biobj_archive_get(archive, i)->y[1] == reference[i][1]);
+    }
+  }
+  assert_true(size > 2 * LOGGER_BIOBJ_ARCHIVE_CHUNK_SIZE);
+
+  coco_random_free(random_generator);
+  logger_biobj_archive_free(archive);
+  (void)state; /* unused */
+}
+
+static int test_all_logger_biobj_archive(void) {
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_logger_biobj_archive_update)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,90 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include "cmocka.h"
+#include "coco.h"
+
+/**
+ * Returns the number of transformed layers in the onion of problem.
+ */
+static size_t test_transform_vars_affine_count_layers(coco_problem_t *problem) {
+  size_t number_of_layers = 0;
+  while (coco_transformed_is_transformed(problem)) {
+    problem = coco_transformed_get_inner_problem(problem);
+    number_of_layers++;
+  }
+  return number_of_layers;
+}
+
+/**
+ * Tests that folding the linear transformations of all bbob problems changes neither their
+ * metadata nor their function values (not even by rounding).
+ */
+static void test_transform_vars_affine_fold(void **state) {
+
+  coco_problem_t *unfolded, *folded;
+  coco_random_state_t *random_generator;
+  const size_t dimensions[3] = { 2, 10, 40 };
+  double x[40], y_unfolded, y_folded;
+  size_t function, dimension_idx, instance, point, i;
+
+  random_generator = coco_random_new(0xC0C0);
+
+  for (function = 1; function <= 24; function++) {
+    for (dimension_idx = 0; dimension_idx < 3; dimension_idx++) {
+      for (instance = 1; instance <= 3; instance++) {
+        unfolded = get_bbob_problem(function, dimensions[dimension_idx], instance);
+        folded = transform_vars_affine_fold(get_bbob_problem(function, dimensions[dimension_idx], instance));
+
+        assert_true(test_transform_vars_affine_count_layers(folded)
+            <= test_transform_vars_affine_count_layers(unfolded));
+        assert_true(folded->best_value[0] == unfolded->best_value[0]);
+        for (i = 0; i < dimensions[dimension_idx]; i++) {
+          /* Unknown optima (as of f16) are NAN in both, which is not equal to itself */
+          assert_true((folded->best_parameter[i] == unfolded->best_parameter[i])
+              || ((folded->best_parameter[i] != folded->best_parameter[i])
+                  && (unfolded->best_parameter[i] != unfolded->best_parameter[i])));
+        }
+
+        for (point = 0; point < 10; point++) {
+          for (i = 0; i < dimensions[dimension_idx]; i++) {
+            x[i] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+          }
+          coco_evaluate_function(unfolded, x, &y_unfolded);
+          coco_evaluate_function(folded, x, &y_folded);
+          assert_true(y_folded == y_unfolded);
+        }
+
+        coco_problem_free(unfolded);
+        coco_problem_free(folded);
+      }
+    }
+  }
+
+  /* Rosenbrock (shift, scale, shift) and rotated Rastrigin (shift, affine) lose two and one layers */
+  unfolded = get_bbob_problem(8, 10, 1);
+  folded = transform_vars_affine_fold(get_bbob_problem(8, 10, 1));
+  assert_int_equal(test_transform_vars_affine_count_layers(folded) + 2,
+      test_transform_vars_affine_count_layers(unfolded));
+  coco_problem_free(unfolded);
+  coco_problem_free(folded);
+
+  unfolded = get_bbob_problem(15, 10, 1);
+  folded = transform_vars_affine_fold(get_bbob_problem(15, 10, 1));
+  assert_int_equal(test_transform_vars_affine_count_layers(folded) + 1,
+      test_transform_vars_affine_count_layers(unfolded));
+  coco_problem_free(unfolded);
+  coco_problem_free(folded);
+
+  coco_random_free(random_generator);
+  (void)state; /* unused */
+}
+
+static int test_all_transform_vars_affine(void) {
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_transform_vars_affine_fold)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
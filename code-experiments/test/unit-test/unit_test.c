@@ -6,10 +6,17 @@
 #include "coco.h"
 #include <time.h>
 
+#include "test_coco_flush_policy.c"
+#include "test_coco_format.c"
+#include "test_coco_matrix.c"
 #include "test_coco_observer.c"
+#include "test_coco_random.c"
 #include "test_coco_suite.c"
 #include "test_coco_utilities.c"
+#include "test_logger_biobj.c"
+#include "test_logger_biobj_archive.c"
 #include "test_mo_generics.c"
+#include "test_transform_vars_affine.c"
 
 static int run_all_tests(void)
 {
@@ -17,6 +24,13 @@ static int run_all_tests(void)
   result += test_all_mo_generics();
   result += test_all_coco_observer();
   result += test_all_coco_suite();
+  result += test_all_transform_vars_affine();
+  result += test_all_coco_matrix();
+  result += test_all_coco_format();
+  result += test_all_logger_biobj();
+  result += test_all_logger_biobj_archive();
+  result += test_all_coco_random();
+  result += test_all_coco_flush_policy();
 
   return result;
 }
@@ -0,0 +1,138 @@
+## -*- mode: python -*-
+
+## Merges the result folders of several runs of the same algorithm, for
+## example of the batches of a suite (see the suite option "batch"), into
+## one folder that can be given to the post-processing.
+##
+## All files of the input folders are copied to the output folder. Data
+## files whose name is already taken by a file of an earlier input folder
+## are renamed (together with the other files of the same name but a
+## different extension), and the entries of the index (.info) files are
+## appended to the index file of the same name in the output folder, with
+## the references to the renamed data files updated.
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+import shutil
+import sys
+
+
+def _list_files(folder):
+    """Returns the paths of all files in folder (relative to it) in a
+    deterministic order."""
+    result = []
+    for root, dirs, files in os.walk(folder):
+        dirs.sort()
+        for name in sorted(files):
+            result.append(os.path.relpath(os.path.join(root, name), folder))
+    return result
+
+
+def _copy_data_files(input_folder, output_folder, paths):
+    """Copies the data files to the output folder and returns a dictionary
+    that maps the name (without extension) of each copied file to its new
+    name."""
+    extensions = {}
+    for path in paths:
+        stem, extension = os.path.splitext(path)
+        extensions.setdefault(stem, []).append(extension)
+    renamed = {}
+    for stem in sorted(extensions):
+        new_stem = stem
+        number = 2
+        while any(os.path.exists(os.path.join(output_folder, new_stem + extension))
+                  for extension in extensions[stem]):
+            new_stem = '%s-%d' % (stem, number)
+            number += 1
+        for extension in extensions[stem]:
+            target = os.path.join(output_folder, new_stem + extension)
+            if not os.path.isdir(os.path.dirname(target)):
+                os.makedirs(os.path.dirname(target))
+            shutil.copyfile(os.path.join(input_folder, stem + extension), target)
+        renamed[stem] = new_stem
+    return renamed
+
+
+def _rename_reference(reference, folder, renamed):
+    """Returns the data file reference (relative to folder) of an index
+    file after the renaming of the data files."""
+    stem, extension = os.path.splitext(reference.strip())
+    path = os.path.normpath(os.path.join(folder, stem))
+    if path not in renamed:
+        raise ValueError('data file %s referenced in an index file is missing' % reference.strip())
+    indentation = reference[:len(reference) - len(reference.lstrip())]
+    return indentation + os.path.relpath(renamed[path], folder or os.curdir) + extension
+
+
+def _merge_index_file(input_folder, output_folder, path, renamed):
+    """Appends the entries of the index file to the one in the output
+    folder.
+
+    Single-objective index files consist of blocks of a header line
+    (funcId = ...), a comment line and a line that starts with the data
+    file. Bi-objective index files have one header line (algorithm = ...,
+    folder = ...) and a comment line, followed by one line per data file,
+    whose third field is the data file (relative to the folder)."""
+    with open(os.path.join(input_folder, path)) as f:
+        content = f.read()
+    lines = content.splitlines()
+    target = os.path.join(output_folder, path)
+    exists = os.path.exists(target)
+    output = []
+    folder = ''
+    is_biobjective = False
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        if line.startswith('algorithm'):
+            is_biobjective = True
+            folder = line.split("folder = '")[1].split("'")[0] if "folder = '" in line else ''
+            if not exists:
+                output.extend(lines[i:i + 2])
+            i += 2
+            continue
+        if line.startswith('funcId'):
+            output.extend(lines[i:i + 2])
+            i += 2
+            continue
+        fields = line.split(',')
+        if is_biobjective and len(fields) > 2 and line.startswith('function'):
+            fields[2] = _rename_reference(fields[2], folder, renamed)
+            line = ','.join(fields)
+        elif not is_biobjective and line.strip() and not line.startswith('%'):
+            fields[0] = _rename_reference(fields[0], '', renamed)
+            line = ','.join(fields)
+        output.append(line)
+        i += 1
+    if exists:
+        with open(target) as f:
+            output.insert(0, f.read().rstrip('\n'))
+    with open(target, 'w') as f:
+        f.write('\n'.join(output))
+        if content.endswith('\n'):
+            f.write('\n')
+
+
+def merge_results(output_folder, input_folders):
+    """Merges the result folders input_folders into the new folder
+    output_folder."""
+    if os.path.exists(output_folder):
+        raise ValueError('output folder %s exists already' % output_folder)
+    os.makedirs(output_folder)
+    for input_folder in input_folders:
+        paths = _list_files(input_folder)
+        index_files = [path for path in paths if path.endswith('.info') and os.sep not in path]
+        renamed = _copy_data_files(input_folder, output_folder,
+                                   [path for path in paths if path not in index_files])
+        for path in index_files:
+            _merge_index_file(input_folder, output_folder, path, renamed)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        print('Usage: merge_results.py OUTPUT_FOLDER INPUT_FOLDER [INPUT_FOLDER ...]')
+        sys.exit(1)
+    merge_results(sys.argv[1], sys.argv[2:])
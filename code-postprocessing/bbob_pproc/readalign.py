@@ -19,6 +19,7 @@ the experimental data.
 
 from __future__ import absolute_import
 
+import os
 import numpy
 import warnings
 
@@ -33,6 +34,9 @@ nbPtsFSingle = 5 # nb of target function values for each decade.
 # Bi-objective case
 idxFBi = 1 # index of the column where to find the function values
 nbPtsFBi = 10 # nb of target function values for each decade.
+# Binary data files (observer option format: binary)
+binaryMagic = b'%COCOBIN' # first bytes of the header of each run
+binaryVersion = 2 # the version that readBinary can read
 
 #CLASS DEFINITIONS
 class MultiReader(list):
@@ -107,7 +111,7 @@ class MultiReader(list):
 
         def __init__(self, data, isHArray=False):
             if len(data) == 0:
-                raise ValueError, 'Empty data array.'
+                raise ValueError('Empty data array.')
             self.data = numpy.array(data)
             self.it = self.data.__iter__()
             self.isNearlyFinished = False
@@ -230,7 +234,7 @@ class HMultiReader(MultiReader):
 
         #This should not happen
         if not fvalues:
-            raise ValueError, 'Value %g is not reached.'
+            raise ValueError('Value %g is not reached.')
 
         if max(fvalues) <= 0.:
             self.idxCurrentF = -numpy.inf
@@ -351,11 +355,87 @@ def alignArrayData(data):
     # of the data.
 
 
+def isBinary(fil):
+    """Returns True if fil is a data file written with the observer
+    option ``format: binary``."""
+
+    with open(fil, 'rb') as f:
+        return f.read(len(binaryMagic)) == binaryMagic
+
+def readBinaryRuns(fil):
+    """Returns the runs of the binary data file fil as a list of pairs
+    (header, array).
+
+    The file consists of fixed-width records of little-endian doubles,
+    where each run starts with a header that holds the magic string,
+    the format version, the number of columns, a reference value and
+    the index, instance and name of the problem (see
+    code-experiments/src/coco_log_format.c). The header is returned as
+    a dictionary with the keys 'reference', 'index', 'instance' and
+    'name'. The file is memory-mapped and the
+    arrays are read-only views of the mapping, so that nothing is
+    parsed. A truncated last record is ignored.
+
+    """
+
+    first = numpy.fromfile(fil, dtype='<u4', count=4)
+    if (len(first) < 4 or first[:2].tobytes() != binaryMagic
+        or first[2] != binaryVersion):
+        raise ValueError('%s is not a binary data file of version %d'
+                         % (fil, binaryVersion))
+    nbColumns = int(first[3])
+    nbRecords = os.path.getsize(fil) // (8 * nbColumns)
+    records = numpy.memmap(fil, dtype='<f8', mode='r',
+                           shape=(nbRecords, nbColumns))
+    raw = records.view('u1').reshape(nbRecords, 8 * nbColumns)
+
+    magic = numpy.frombuffer(binaryMagic, dtype='<u8')[0]
+    candidates = numpy.flatnonzero(records[:, 0].view('<u8') == magic)
+    headers = [] # (first record of the header, first record of the data, header)
+    for start in candidates:
+        if headers and start < headers[-1][1]:
+            continue # the magic string is part of the name in a header
+        fields = raw[start:].reshape(-1)
+        nameLength = int(fields[40:44].view('<u4')[0])
+        header = {'reference': float(fields[16:24].view('<f8')[0]),
+                  'index': int(fields[24:32].view('<u8')[0]),
+                  'instance': int(fields[32:40].view('<u8')[0]),
+                  'name': fields[44:44 + nameLength].tobytes().decode('ascii')}
+        headerSize = 44 + nameLength
+        nbHeaderRecords = -(-headerSize // (8 * nbColumns))
+        headers.append((start, start + nbHeaderRecords, header))
+
+    runs = []
+    for i, (start, dataStart, header) in enumerate(headers):
+        end = headers[i + 1][0] if i + 1 < len(headers) else nbRecords
+        runs.append((header, records[dataStart:end]))
+    return runs
+
+def readBinary(fil):
+    """Returns the runs of the binary data file fil as a list of arrays,
+    see :py:func:`readBinaryRuns`. Runs without data are omitted.
+
+    """
+
+    return list(run for header, run in readBinaryRuns(fil) if len(run))
+
 def split(dataFiles, dim=None):
-    """Split a list of data files into arrays corresponding to data sets."""
+    """Split a list of data files into arrays corresponding to data sets.
+
+    Binary data files are read with :py:func:`readBinary`.
+
+    """
 
     dataSets = []
     for fil in dataFiles:
+        if isBinary(fil):
+            runs = readBinary(fil)
+            if dim and runs and numpy.shape(runs[0])[1] != dim + 5:
+                warnings.warn('Unexpected number of columns in ' +
+                              'data file %s: ' % (fil))
+            dataSets.extend(runs)
+            continue
+
         with open(fil, 'r') as f:
             # This doesnt work with windows.
             # content = numpy.loadtxt(fil, comments='%')
@@ -17,6 +17,7 @@ from os.path import join
 
 ## Change to the root directory of repository and add our tools/
 ## subdirectory to system wide search path for modules.
+calling_directory = os.getcwd()
 os.chdir(os.path.dirname(os.path.abspath(__file__)))
 sys.path.insert(0, os.path.abspath('code-experiments/tools'))
 
@@ -24,6 +25,7 @@ from amalgamate import amalgamate
 from cocoutils import make, run, python, check_output
 from cocoutils import copy_file, expand_file, write_file
 from cocoutils import git_version, git_revision
+from merge_results import merge_results as merge_result_folders
 
 core_files = ['code-experiments/src/coco_generics.c',
               'code-experiments/src/coco_random.c',
@@ -54,11 +56,14 @@ def run_c():
         sys.exit(-1)
 
 def test_c():
-    """ Builds and runs unit tests, integration tests and an example experiment test in C """
+    """ Builds and runs unit tests (also with several threads), integration tests and an example experiment
+    test in C """
     build_c()
-    # Perform unit tests
+    # Perform unit tests (also with several threads)
     build_c_unit_tests()
     run_c_unit_tests()
+    build_c_unit_tests('unit_test_threads')
+    run_c_unit_tests('unit_test_threads')
     # Perform integration tests
     build_c_integration_tests()
     run_c_integration_tests()
@@ -72,6 +77,13 @@ def test_c_unit():
     # Perform unit tests
     build_c_unit_tests()
     run_c_unit_tests()
+
+def test_c_unit_threads():
+    """ Builds and runs unit tests in C with several threads and the SIMD
+        kernels (COCO_THREADS and COCO_SIMD) """
+    build_c()
+    build_c_unit_tests('unit_test_threads')
+    run_c_unit_tests('unit_test_threads')
         
 def test_c_integration():
     """ Builds and runs integration tests in C """
@@ -87,7 +99,7 @@ def test_c_example():
     build_c_example_tests()
     run_c_example_tests()
         
-def build_c_unit_tests():
+def build_c_unit_tests(target='all'):
     """ Builds unit tests in C """
     libraryPath = '';
     fileName = ''
@@ -116,12 +128,12 @@ def build_c_unit_tests():
     copy_file('code-experiments/build/c/coco.c', 'code-experiments/test/unit-test/coco.c')
     copy_file('code-experiments/src/coco.h', 'code-experiments/test/unit-test/coco.h')
     make("code-experiments/test/unit-test", "clean")
-    make("code-experiments/test/unit-test", "all")
+    make("code-experiments/test/unit-test", target)
 
-def run_c_unit_tests():
+def run_c_unit_tests(program='unit_test'):
     """ Runs unit tests in C """
     try:
-        run('code-experiments/test/unit-test', ['./unit_test'])
+        run('code-experiments/test/unit-test', ['./' + program])
     except subprocess.CalledProcessError:
         sys.exit(-1)
 
@@ -139,6 +151,10 @@ def run_c_integration_tests():
         run('code-experiments/test/integration-test', ['./test_coco', 'bbob2009_testcases.txt'])
         run('code-experiments/test/integration-test', ['./test_instance_extraction'])
         run('code-experiments/test/integration-test', ['./test_biobj'])
+        run('code-experiments/test/integration-test', ['./test_log_format'])
+        python('code-experiments/test/integration-test', ['test_log_format.py'])
+        run('code-experiments/test/integration-test', ['./test_merge_results'])
+        python('code-experiments/test/integration-test', ['test_merge_results.py'])
     except subprocess.CalledProcessError:
         sys.exit(-1)
     
@@ -476,6 +492,17 @@ def test_java():
 def test_post_processing():
     python('code-postprocessing/bbob_pproc', ['__main__.py'])
 
+################################################################################
+## Results
+def merge_results(folders):
+    """ Merges the result folders of several runs (for example of the
+    batches of a suite) into the first given folder, which must not exist """
+    if len(folders) < 2:
+        help()
+        sys.exit(-1)
+    folders = [os.path.join(calling_directory, folder) for folder in folders]
+    merge_result_folders(folders[0], folders[1:])
+
 ################################################################################
 ## Global
 def build():
@@ -535,9 +562,11 @@ Available commands:
   run-sandbox-python   - Run a Python script with installed COCO module
                          Takes a single argument (name of Python script file)
   
-  test-c               - Build and run unit tests, integration tests 
-                         and an example experiment test in C 
+  test-c               - Build and run unit tests (also with several threads),
+                         integration tests and an example experiment test in C
   test-c-unit          - Build and run unit tests in C
+  test-c-unit-threads  - Build and run unit tests in C with several threads
+                         and the SIMD kernels (COCO_THREADS and COCO_SIMD)
   test-c-integration   - Build and run integration tests in C
   test-c-example       - Build and run an example experiment test in C 
   test-java            - Build and run a test in Java
@@ -547,6 +576,10 @@ Available commands:
   test-post-processing - Runs post processing tests.
   leak-check           - Check for memory leaks in C
 
+  merge-results        - Merge the result folders given as further arguments
+                         (for example of the batches of a suite) into the
+                         new folder given as first argument
+
 
 To build a release version which does not include debugging information in the 
 amalgamations set the environment variable COCO_RELEASE to 'true'.
@@ -575,6 +608,7 @@ def main(args):
         run_python(False) if len(args) > 1 and args[1] == 'no-tests' else run_python()
     elif cmd == 'test-c': test_c()
     elif cmd == 'test-c-unit': test_c_unit()
+    elif cmd == 'test-c-unit-threads': test_c_unit_threads()
     elif cmd == 'test-c-integration': test_c_integration()
     elif cmd == 'test-c-example': test_c_example()    
     elif cmd == 'test-java': test_java()
@@ -583,6 +617,7 @@ def main(args):
     elif cmd == 'test-python3': test_python3()
     elif cmd == 'test-post-processing': test_post_processing()
     elif cmd == 'leak-check': leak_check()
+    elif cmd == 'merge-results': merge_results(args[1:])
     else: help()
 
 if __name__ == '__main__':